@@ -0,0 +1,68 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+// This file is not executed; it is only compiled, and the time taken to
+// compile it is measured by 'cmake/TimeCompile.cmake'.
+//
+// It instantiates the comparison operators for 1000 distinct pointer types,
+// covering every operator against 'not_null<U>', 'U', and 'nullptr', to
+// measure the cost of declaring, instantiating and overload-resolving them.
+
+#include "not_null.hpp"
+
+#define NOT_NULL_BENCHMARK_COMPARISONS(n)                                      \
+  struct type_##n { int value; };                                             \
+  auto compare_##n(cpp::not_null<type_##n*> a,                               \
+                   cpp::not_null<const type_##n*> b,                          \
+                   type_##n* c) -> int                                        \
+  {                                                                           \
+    return (a == b) + (a != b) + (a < b) + (a <= b) + (a > b) + (a >= b) +    \
+           (a == c) + (c != a) + (a < c) + (c >= a) +                         \
+           (a == nullptr) + (nullptr != a);                                   \
+  }
+
+#define NOT_NULL_BENCHMARK_10(p)                                               \
+  NOT_NULL_BENCHMARK_COMPARISONS(p##0) NOT_NULL_BENCHMARK_COMPARISONS(p##1)   \
+  NOT_NULL_BENCHMARK_COMPARISONS(p##2) NOT_NULL_BENCHMARK_COMPARISONS(p##3)   \
+  NOT_NULL_BENCHMARK_COMPARISONS(p##4) NOT_NULL_BENCHMARK_COMPARISONS(p##5)   \
+  NOT_NULL_BENCHMARK_COMPARISONS(p##6) NOT_NULL_BENCHMARK_COMPARISONS(p##7)   \
+  NOT_NULL_BENCHMARK_COMPARISONS(p##8) NOT_NULL_BENCHMARK_COMPARISONS(p##9)
+
+#define NOT_NULL_BENCHMARK_100(p)                                              \
+  NOT_NULL_BENCHMARK_10(p##0) NOT_NULL_BENCHMARK_10(p##1)                     \
+  NOT_NULL_BENCHMARK_10(p##2) NOT_NULL_BENCHMARK_10(p##3)                     \
+  NOT_NULL_BENCHMARK_10(p##4) NOT_NULL_BENCHMARK_10(p##5)                     \
+  NOT_NULL_BENCHMARK_10(p##6) NOT_NULL_BENCHMARK_10(p##7)                     \
+  NOT_NULL_BENCHMARK_10(p##8) NOT_NULL_BENCHMARK_10(p##9)
+
+NOT_NULL_BENCHMARK_100(0)
+NOT_NULL_BENCHMARK_100(1)
+NOT_NULL_BENCHMARK_100(2)
+NOT_NULL_BENCHMARK_100(3)
+NOT_NULL_BENCHMARK_100(4)
+NOT_NULL_BENCHMARK_100(5)
+NOT_NULL_BENCHMARK_100(6)
+NOT_NULL_BENCHMARK_100(7)
+NOT_NULL_BENCHMARK_100(8)
+NOT_NULL_BENCHMARK_100(9)
@@ -0,0 +1,82 @@
+cmake_minimum_required(VERSION 3.5)
+
+#.rst:
+# AddCodegenTest
+# ---------
+#
+# Creates a CTest test that compiles a source file of probe functions with a
+# given compiler and flags, disassembles the resulting object with objdump,
+# and verifies the generated code against the 'CHECK-*' directives written
+# in the probe source.
+#
+# This is used to detect when a compiler stops optimizing away the null
+# checks that `not_null` is meant to remove.
+#
+# ::
+#
+#     add_codegen_test(
+#       <name>
+#       SOURCE <source>
+#       COMPILER <compiler>
+#       [OBJDUMP <objdump>]
+#       [FLAGS [flags]...]
+#     )
+#
+#     <name>        - The name of the test to create
+#     <source>      - The probe source file to compile
+#     <compiler>    - The C++ compiler to compile the probe source with
+#     <objdump>     - The objdump executable. By default, this is CMAKE_OBJDUMP
+#     [flags]...    - Additional flags to compile the probe source with
+#
+# The probe source describes the expectations of each probe function with
+# line comments of the form:
+#
+# ::
+#
+#     // CHECK-BRANCHES: <symbol> <count>
+#     // CHECK-MAX-INSTRUCTIONS: <symbol> <count>
+#     // CHECK-NOT: <symbol> <regex>
+#
+# Probe functions should be declared 'extern "C"' so that <symbol> is not
+# mangled. See 'CheckCodegen.cmake' for the meaning of each directive.
+#
+function(add_codegen_test name)
+
+  cmake_parse_arguments("CODEGEN" "" "SOURCE;COMPILER;OBJDUMP" "FLAGS" ${ARGN})
+
+  if( NOT CODEGEN_SOURCE )
+    message(FATAL_ERROR "No SOURCE specified")
+  endif()
+
+  if( NOT CODEGEN_COMPILER )
+    message(FATAL_ERROR "No COMPILER specified")
+  endif()
+
+  if( CODEGEN_OBJDUMP )
+    set(objdump "${CODEGEN_OBJDUMP}")
+  elseif( CMAKE_OBJDUMP )
+    set(objdump "${CMAKE_OBJDUMP}")
+  else()
+    message(FATAL_ERROR "No OBJDUMP specified, and CMAKE_OBJDUMP is not set")
+  endif()
+
+  get_filename_component(source "${CODEGEN_SOURCE}" ABSOLUTE)
+  set(object "${CMAKE_CURRENT_BINARY_DIR}/${name}.o")
+
+  # The list of flags cannot be forwarded as-is, since 'add_test' would split
+  # it into separate arguments
+  string(REPLACE ";" "|" flags "${CODEGEN_FLAGS}")
+
+  add_test(
+    NAME "${name}"
+    COMMAND "${CMAKE_COMMAND}"
+      "-DCOMPILER=${CODEGEN_COMPILER}"
+      "-DOBJDUMP=${objdump}"
+      "-DSOURCE=${source}"
+      "-DOBJECT=${object}"
+      "-DFLAGS=${flags}"
+      "-DPROCESSOR=${CMAKE_SYSTEM_PROCESSOR}"
+      -P "${NOT_NULL_CMAKE_MODULE_PATH}/CheckCodegen.cmake"
+  )
+
+endfunction()
@@ -0,0 +1,153 @@
+cmake_minimum_required(VERSION 3.5)
+
+#.rst:
+# CheckCodegen
+# ---------
+#
+# Script-mode counterpart of 'AddCodegenTest'. This compiles a probe source,
+# disassembles it, and verifies each 'CHECK-*' directive in the source
+# against the disassembly of the named symbol.
+#
+# ::
+#
+#     cmake -DCOMPILER=<compiler>
+#           -DOBJDUMP=<objdump>
+#           -DSOURCE=<source>
+#           -DOBJECT=<object>
+#           [-DFLAGS=<flag>|<flag>|...]
+#           [-DPROCESSOR=<processor>]
+#           -P CheckCodegen.cmake
+#
+# The supported directives are:
+#
+# ::
+#
+#     // CHECK-BRANCHES: <symbol> <count>
+#       Requires <symbol> to contain exactly <count> conditional branches.
+#       Out-of-line cold clones (e.g. 'symbol.cold') are not counted.
+#
+#     // CHECK-MAX-INSTRUCTIONS: <symbol> <count>
+#       Requires <symbol> to contain at most <count> instructions, ignoring
+#       alignment padding.
+#
+#     // CHECK-NOT: <symbol> <regex>
+#       Requires that no instruction in <symbol> matches <regex>.
+#
+
+foreach( variable COMPILER OBJDUMP SOURCE OBJECT )
+  if( NOT ${variable} )
+    message(FATAL_ERROR "${variable} must be specified")
+  endif()
+endforeach()
+
+# Conditional branches are architecture-specific
+if( NOT PROCESSOR OR PROCESSOR MATCHES "^(x86_64|AMD64|amd64|i[3-6]86|x86)$" )
+  set(branch_regex "^j([^m]|m[^p])")
+elseif( PROCESSOR MATCHES "^(aarch64|arm64|ARM64)$" )
+  set(branch_regex "^(b\\.|cbn?z|tbn?z)")
+else()
+  message(FATAL_ERROR "Codegen checks are not supported for '${PROCESSOR}'")
+endif()
+
+############################### Compile probes ###############################
+
+string(REPLACE "|" ";" flags "${FLAGS}")
+
+execute_process(
+  COMMAND "${COMPILER}" ${flags} -c "${SOURCE}" -o "${OBJECT}"
+  RESULT_VARIABLE result
+  ERROR_VARIABLE error
+)
+if( NOT result EQUAL 0 )
+  message(FATAL_ERROR "Failed to compile '${SOURCE}':\n${error}")
+endif()
+
+execute_process(
+  COMMAND "${OBJDUMP}" -d --no-show-raw-insn "${OBJECT}"
+  RESULT_VARIABLE result
+  OUTPUT_VARIABLE disassembly
+  ERROR_VARIABLE error
+)
+if( NOT result EQUAL 0 )
+  message(FATAL_ERROR "Failed to disassemble '${OBJECT}':\n${error}")
+endif()
+
+############################# Split by symbol #############################
+
+# Collect the instructions for each symbol into 'instructions_<symbol>'
+string(REPLACE ";" "\\;" disassembly "${disassembly}")
+string(REPLACE "\n" ";" lines "${disassembly}")
+
+set(symbol)
+set(symbols)
+foreach( line IN LISTS lines )
+  if( line MATCHES "^[0-9a-fA-F]+ <([^>]+)>:$" )
+    set(symbol "${CMAKE_MATCH_1}")
+    list(APPEND symbols "${symbol}")
+    set(instructions_${symbol})
+  elseif( symbol AND line MATCHES "^ *[0-9a-fA-F]+:\t+([^\t].*)$" )
+    string(STRIP "${CMAKE_MATCH_1}" instruction)
+    # Alignment padding is not part of the code that executes
+    if( NOT instruction MATCHES "^(nop|xchg +%ax,%ax|data16|cs nop)" )
+      list(APPEND instructions_${symbol} "${instruction}")
+    endif()
+  endif()
+endforeach()
+
+############################# Check directives #############################
+
+file(STRINGS "${SOURCE}" directives REGEX "^// CHECK-[A-Z-]+:")
+
+set(failures)
+foreach( directive IN LISTS directives )
+  if( NOT directive MATCHES "^// (CHECK-[A-Z-]+): +([^ ]+) +(.+)$" )
+    message(FATAL_ERROR "Malformed directive: '${directive}'")
+  endif()
+  set(kind "${CMAKE_MATCH_1}")
+  set(symbol "${CMAKE_MATCH_2}")
+  set(argument "${CMAKE_MATCH_3}")
+
+  if( NOT symbol IN_LIST symbols )
+    list(APPEND failures "${symbol}: symbol not found in disassembly")
+    continue()
+  endif()
+  set(instructions ${instructions_${symbol}})
+  string(REPLACE ";" "\n    " listing "${instructions}")
+
+  if( kind STREQUAL "CHECK-BRANCHES" )
+    set(count 0)
+    foreach( instruction IN LISTS instructions )
+      if( instruction MATCHES "${branch_regex}" )
+        math(EXPR count "${count} + 1")
+      endif()
+    endforeach()
+    if( NOT count EQUAL argument )
+      list(APPEND failures
+        "${symbol}: expected ${argument} conditional branch(es), found ${count}\n    ${listing}"
+      )
+    endif()
+  elseif( kind STREQUAL "CHECK-MAX-INSTRUCTIONS" )
+    list(LENGTH instructions count)
+    if( count GREATER argument )
+      list(APPEND failures
+        "${symbol}: expected at most ${argument} instruction(s), found ${count}\n    ${listing}"
+      )
+    endif()
+  elseif( kind STREQUAL "CHECK-NOT" )
+    foreach( instruction IN LISTS instructions )
+      if( instruction MATCHES "${argument}" )
+        list(APPEND failures
+          "${symbol}: unexpected instruction '${instruction}' matching '${argument}'\n    ${listing}"
+        )
+        break()
+      endif()
+    endforeach()
+  else()
+    message(FATAL_ERROR "Unknown directive '${kind}'")
+  endif()
+endforeach()
+
+if( failures )
+  string(REPLACE ";" "\n" failures "${failures}")
+  message(FATAL_ERROR "Codegen checks failed for '${SOURCE}':\n${failures}")
+endif()
@@ -0,0 +1,63 @@
+cmake_minimum_required(VERSION 3.5)
+
+#.rst:
+# TimeCompile
+# ---------
+#
+# Script-mode utility that measures how long a compiler takes to compile a
+# single source file. The source is only checked for syntax and semantics
+# (no code is generated), since that is where templates are instantiated and
+# overloads are resolved.
+#
+# ::
+#
+#     cmake -DCOMPILER=<compiler>
+#           -DSOURCE=<source>
+#           -DNAME=<name>
+#           [-DFLAGS=<flag>|<flag>|...]
+#           [-DREPETITIONS=<count>]
+#           -P TimeCompile.cmake
+#
+# The fastest of 'REPETITIONS' (default: 5) compilations is reported, in
+# milliseconds, to reduce noise from other processes.
+#
+# This requires CMake 3.23 or above for sub-second timestamps.
+#
+
+foreach( variable COMPILER SOURCE NAME )
+  if( NOT ${variable} )
+    message(FATAL_ERROR "${variable} must be specified")
+  endif()
+endforeach()
+
+if( CMAKE_VERSION VERSION_LESS 3.23 )
+  message(FATAL_ERROR "TimeCompile requires CMake 3.23 or above")
+endif()
+
+if( NOT REPETITIONS )
+  set(REPETITIONS 5)
+endif()
+
+string(REPLACE "|" ";" flags "${FLAGS}")
+
+set(fastest)
+foreach( i RANGE 1 ${REPETITIONS} )
+  string(TIMESTAMP start "%s%f")
+  execute_process(
+    COMMAND "${COMPILER}" ${flags} -fsyntax-only "${SOURCE}"
+    RESULT_VARIABLE result
+    ERROR_VARIABLE error
+  )
+  string(TIMESTAMP end "%s%f")
+
+  if( NOT result EQUAL 0 )
+    message(FATAL_ERROR "Failed to compile '${SOURCE}':\n${error}")
+  endif()
+
+  math(EXPR elapsed "(${end} - ${start}) / 1000")
+  if( NOT fastest OR elapsed LESS fastest )
+    set(fastest ${elapsed})
+  endif()
+endforeach()
+
+message("${NAME}: ${fastest} ms")
@@ -0,0 +1,363 @@
+/*****************************************************************************
+ * \file atomic_not_null.hpp
+ *
+ * \brief This header defines an atomic raw pointer that can never hold null
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2019 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CPP_BITWIZESHIFT_ATOMIC_NOT_NULL_HPP
+#define CPP_BITWIZESHIFT_ATOMIC_NOT_NULL_HPP
+
+#include "not_null.hpp"
+
+#include <atomic> // std::atomic, std::memory_order
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+  template <typename T>
+  class atomic_not_null;
+
+  //===========================================================================
+  // class : atomic_not_null
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief An atomic raw pointer that can never hold null
+  ///
+  /// Every value stored into an `atomic_not_null` is a `not_null`, so every
+  /// value loaded from it is known to be non-null without being checked.
+  /// This is intended for pointers that are published to many readers, such
+  /// as configuration or routing tables, where each reader would otherwise
+  /// need to null-check the result of every `load()`.
+  ///
+  /// `atomic_not_null` is always lock-free, and has the same size and
+  /// operations as `std::atomic<T*>`, other than arithmetic.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// cpp::atomic_not_null<const routing_table*> g_routes{
+  ///   cpp::assume_not_null(&s_default_routes)
+  /// };
+  ///
+  /// auto route(const request& r) -> endpoint
+  /// {
+  ///   // No null check is needed before dereferencing
+  ///   return g_routes.load(std::memory_order_acquire)->lookup(r);
+  /// }
+  /// ```
+  ///
+  /// \note The primary template is only defined for raw pointers.
+  ///
+  /// \tparam T the pointer type
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  class atomic_not_null<T*>
+  {
+    static_assert(
+      ATOMIC_POINTER_LOCK_FREE == 2,
+      "atomic_not_null requires lock-free atomic pointers"
+    );
+
+    //-------------------------------------------------------------------------
+    // Public Member Types
+    //-------------------------------------------------------------------------
+  public:
+
+    using value_type   = not_null<T*>;
+    using element_type = T;
+    using pointer      = T*;
+
+    //-------------------------------------------------------------------------
+    // Public Static Members
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief atomic_not_null is lock-free on every supported platform
+    static constexpr bool is_always_lock_free = true;
+
+    //-------------------------------------------------------------------------
+    // Constructors / Assignment
+    //-------------------------------------------------------------------------
+  public:
+
+    // atomic_not_null is not default-constructible, since it must point
+    // somewhere
+    atomic_not_null() = delete;
+
+    /// \brief Constructs an atomic_not_null that initially holds \p p
+    ///
+    /// This is not an atomic operation, and may be used for constant
+    /// initialization.
+    ///
+    /// \param p the initial pointer
+    constexpr atomic_not_null(not_null<T*> p) noexcept;
+
+    atomic_not_null(const atomic_not_null&) = delete;
+
+    //-------------------------------------------------------------------------
+
+    auto operator=(const atomic_not_null&) -> atomic_not_null& = delete;
+    auto operator=(const atomic_not_null&) volatile -> atomic_not_null& = delete;
+
+    /// \brief Atomically stores \p p, as if by `store(p)`
+    ///
+    /// \param p the pointer to store
+    /// \return \p p
+    auto operator=(not_null<T*> p) noexcept -> not_null<T*>;
+
+    //-------------------------------------------------------------------------
+    // Operations
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Queries whether operations on this object are lock-free
+    ///
+    /// \return `true`
+    auto is_lock_free() const noexcept -> bool;
+
+    /// \brief Atomically replaces the held pointer with \p p
+    ///
+    /// \param p the pointer to store
+    /// \param order the memory order of the store
+    auto store(not_null<T*> p,
+               std::memory_order order = std::memory_order_seq_cst) noexcept
+      -> void;
+
+    /// \brief Atomically loads the held pointer
+    ///
+    /// \param order the memory order of the load
+    /// \return the held pointer
+    auto load(std::memory_order order = std::memory_order_seq_cst)
+      const noexcept -> not_null<T*>;
+
+    /// \brief Atomically loads the held pointer, as if by `load()`
+    ///
+    /// \return the held pointer
+    operator not_null<T*>() const noexcept;
+
+    /// \brief Atomically replaces the held pointer with \p p
+    ///
+    /// \param p the pointer to store
+    /// \param order the memory order of the exchange
+    /// \return the previously held pointer
+    auto exchange(not_null<T*> p,
+                  std::memory_order order = std::memory_order_seq_cst) noexcept
+      -> not_null<T*>;
+
+    /// \{
+    /// \brief Atomically replaces the held pointer with \p desired if it is
+    ///        equal to \p expected; otherwise loads the held pointer into
+    ///        \p expected
+    ///
+    /// The weak form may fail spuriously, and is intended to be called in a
+    /// loop.
+    ///
+    /// \param expected the pointer expected to be held
+    /// \param desired the pointer to store if \p expected is held
+    /// \param success the memory order of the exchange if it succeeds
+    /// \param failure the memory order of the load if it fails
+    /// \param order the memory order of the operation
+    /// \return `true` if the held pointer was replaced
+    auto compare_exchange_weak(not_null<T*>& expected,
+                               not_null<T*> desired,
+                               std::memory_order success,
+                               std::memory_order failure) noexcept -> bool;
+    auto compare_exchange_weak(not_null<T*>& expected,
+                               not_null<T*> desired,
+                               std::memory_order order = std::memory_order_seq_cst)
+      noexcept -> bool;
+    auto compare_exchange_strong(not_null<T*>& expected,
+                                 not_null<T*> desired,
+                                 std::memory_order success,
+                                 std::memory_order failure) noexcept -> bool;
+    auto compare_exchange_strong(not_null<T*>& expected,
+                                 not_null<T*> desired,
+                                 std::memory_order order = std::memory_order_seq_cst)
+      noexcept -> bool;
+    /// \}
+
+    //-------------------------------------------------------------------------
+    // Private Members
+    //-------------------------------------------------------------------------
+  private:
+
+    std::atomic<T*> m_pointer;
+  };
+
+} // inline namespace bitwizeshift
+} // namespace cpp
+
+//=============================================================================
+// class : atomic_not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Public Static Members
+//-----------------------------------------------------------------------------
+
+template <typename T>
+constexpr bool NOT_NULL_NS_IMPL::atomic_not_null<T*>::is_always_lock_free;
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::atomic_not_null<T*>::atomic_not_null(not_null<T*> p)
+  noexcept
+  : m_pointer(p.as_nullable())
+{
+
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::atomic_not_null<T*>::operator=(not_null<T*> p)
+  noexcept -> not_null<T*>
+{
+  store(p);
+  return p;
+}
+
+//-----------------------------------------------------------------------------
+// Operations
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::atomic_not_null<T*>::is_lock_free()
+  const noexcept -> bool
+{
+  return true;
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::atomic_not_null<T*>::store(not_null<T*> p,
+                                                  std::memory_order order)
+  noexcept -> void
+{
+  m_pointer.store(p.as_nullable(), order);
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::atomic_not_null<T*>::load(std::memory_order order)
+  const noexcept -> not_null<T*>
+{
+  // Only not_null values are ever stored, so the result needs no check or
+  // audit
+  return detail::not_null_factory::make(
+    detail::mark_nonnull(m_pointer.load(order))
+  );
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::atomic_not_null<T*>::operator not_null<T*>()
+  const noexcept
+{
+  return load();
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::atomic_not_null<T*>::exchange(not_null<T*> p,
+                                                     std::memory_order order)
+  noexcept -> not_null<T*>
+{
+  return detail::not_null_factory::make(
+    detail::mark_nonnull(m_pointer.exchange(p.as_nullable(), order))
+  );
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::atomic_not_null<T*>::compare_exchange_weak(not_null<T*>& expected,
+                                                                  not_null<T*> desired,
+                                                                  std::memory_order success,
+                                                                  std::memory_order failure)
+  noexcept -> bool
+{
+  auto* p = expected.as_nullable();
+  const auto result = m_pointer.compare_exchange_weak(
+    p, desired.as_nullable(), success, failure
+  );
+  expected = detail::not_null_factory::make(detail::mark_nonnull(p));
+  return result;
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::atomic_not_null<T*>::compare_exchange_weak(not_null<T*>& expected,
+                                                                  not_null<T*> desired,
+                                                                  std::memory_order order)
+  noexcept -> bool
+{
+  auto* p = expected.as_nullable();
+  const auto result = m_pointer.compare_exchange_weak(
+    p, desired.as_nullable(), order
+  );
+  expected = detail::not_null_factory::make(detail::mark_nonnull(p));
+  return result;
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::atomic_not_null<T*>::compare_exchange_strong(not_null<T*>& expected,
+                                                                    not_null<T*> desired,
+                                                                    std::memory_order success,
+                                                                    std::memory_order failure)
+  noexcept -> bool
+{
+  auto* p = expected.as_nullable();
+  const auto result = m_pointer.compare_exchange_strong(
+    p, desired.as_nullable(), success, failure
+  );
+  expected = detail::not_null_factory::make(detail::mark_nonnull(p));
+  return result;
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::atomic_not_null<T*>::compare_exchange_strong(not_null<T*>& expected,
+                                                                    not_null<T*> desired,
+                                                                    std::memory_order order)
+  noexcept -> bool
+{
+  auto* p = expected.as_nullable();
+  const auto result = m_pointer.compare_exchange_strong(
+    p, desired.as_nullable(), order
+  );
+  expected = detail::not_null_factory::make(detail::mark_nonnull(p));
+  return result;
+}
+
+#endif /* CPP_BITWIZESHIFT_ATOMIC_NOT_NULL_HPP */
@@ -0,0 +1,1248 @@
+/*****************************************************************************
+ * \file intrusive_list.hpp
+ *
+ * \brief This header defines an intrusive, circular, doubly-linked list
+ *        whose links are never null
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2019 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CPP_BITWIZESHIFT_INTRUSIVE_LIST_HPP
+#define CPP_BITWIZESHIFT_INTRUSIVE_LIST_HPP
+
+#include "not_null.hpp"
+
+#include <atomic>      // std::atomic, std::memory_order_relaxed
+#include <cstddef>     // std::size_t, std::ptrdiff_t
+#include <iterator>    // std::bidirectional_iterator_tag, std::reverse_iterator
+#include <type_traits> // std::remove_const
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+  class intrusive_list_hook;
+
+  template <typename T, intrusive_list_hook T::*Hook>
+  class intrusive_list;
+
+  namespace detail {
+    template <typename U, typename Traits>
+    class intrusive_list_iterator;
+  } // namespace detail
+
+  //===========================================================================
+  // class : intrusive_list_hook
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief The links that make an object an element of an `intrusive_list`
+  ///
+  /// A hook that is not in a list is linked to itself, rather than to null,
+  /// and the head of every list is a sentinel hook. Consequently the links of
+  /// a hook are always valid `not_null` pointers, and linking or unlinking
+  /// a hook never needs to test for the start or end of a list.
+  ///
+  /// A hook unlinks itself when it is destroyed, so an object may be
+  /// destroyed while it is still an element of a list. Copying an object
+  /// does not copy its membership in a list; the hook of the copy is always
+  /// unlinked.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// struct timer
+  /// {
+  ///   std::chrono::steady_clock::time_point deadline;
+  ///   cpp::intrusive_list_hook hook;
+  /// };
+  ///
+  /// auto cancel(timer& t) -> void
+  /// {
+  ///   t.hook.unlink(); // no list is needed
+  /// }
+  /// ```
+  /////////////////////////////////////////////////////////////////////////////
+  class intrusive_list_hook
+  {
+    //-------------------------------------------------------------------------
+    // Constructors / Assignment / Destructor
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Constructs an unlinked hook
+    intrusive_list_hook() noexcept;
+
+    /// \brief Constructs an unlinked hook
+    ///
+    /// The membership of \p other in a list is not copied
+    ///
+    /// \param other the hook being copied
+    intrusive_list_hook(const intrusive_list_hook& other) noexcept;
+
+    //-------------------------------------------------------------------------
+
+    /// \brief Does nothing
+    ///
+    /// This hook remains in whichever list it was in; the membership of
+    /// \p other in a list is not copied
+    ///
+    /// \param other the hook being copied
+    /// \return reference to `(*this)`
+    auto operator=(const intrusive_list_hook& other) noexcept
+      -> intrusive_list_hook&;
+
+    //-------------------------------------------------------------------------
+
+    /// \brief Unlinks this hook from the list it is in, if any
+    ~intrusive_list_hook();
+
+    //-------------------------------------------------------------------------
+    // Observers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Queries whether this hook is an element of a list
+    ///
+    /// \return `true` if this hook is linked to another hook
+    auto is_linked() const noexcept -> bool;
+
+    //-------------------------------------------------------------------------
+    // Modifiers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Removes this hook from the list it is in in constant time
+    ///
+    /// Unlinking a hook that is not in a list has no effect.
+    auto unlink() noexcept -> void;
+
+    //-------------------------------------------------------------------------
+    // Private Member Functions
+    //-------------------------------------------------------------------------
+  private:
+
+    /// \brief Links this unlinked hook into a list, immediately before
+    ///        \p pos
+    ///
+    /// \pre `!is_linked()`
+    ///
+    /// \param pos the hook to link before
+    auto link_before(not_null<intrusive_list_hook*> pos) noexcept -> void;
+
+    /// \brief Links this hook to itself, without modifying its neighbours
+    auto reset() noexcept -> void;
+
+    //-------------------------------------------------------------------------
+    // Private Members
+    //-------------------------------------------------------------------------
+  private:
+
+    not_null<intrusive_list_hook*> m_next;
+    not_null<intrusive_list_hook*> m_prev;
+
+    template <typename U, intrusive_list_hook U::*>
+    friend class intrusive_list;
+
+    template <typename, typename>
+    friend class detail::intrusive_list_iterator;
+  };
+
+  namespace detail {
+
+    /// \brief Converts between an element of type \p T and its \p Hook
+    template <typename T, intrusive_list_hook T::*Hook>
+    struct intrusive_list_traits
+    {
+      /// \brief Gets the hook of \p value, recording the offset of the hook
+      static auto to_hook(T& value) noexcept -> not_null<intrusive_list_hook*>;
+
+      /// \brief Gets the element of \p hook, which must have been obtained
+      ///        from `to_hook`
+      static auto to_value(intrusive_list_hook* hook) noexcept -> T*;
+
+      /// \brief The distance in bytes from the start of a \p T to its
+      ///        \p Hook
+      ///
+      /// This cannot be measured without a \p T, so it is recorded from the
+      /// elements themselves by `to_hook`. Every hook is linked through
+      /// `to_hook` before it can be converted back to its element. It is
+      /// atomic only because lists of the same type may be modified on
+      /// different threads; relaxed accesses compile to plain moves.
+      static std::atomic<std::ptrdiff_t> s_hook_offset;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief The bidirectional iterator of an `intrusive_list`
+    ///
+    /// Since the links of every hook are `not_null`, advancing this iterator
+    /// is a single load with no test for null.
+    ///
+    /// \tparam U the element type, which may be const-qualified
+    /// \tparam Traits the `intrusive_list_traits` of the list
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename U, typename Traits>
+    class intrusive_list_iterator
+    {
+      //-----------------------------------------------------------------------
+      // Public Member Types
+      //-----------------------------------------------------------------------
+    public:
+
+      using iterator_category = std::bidirectional_iterator_tag;
+      using value_type        = typename std::remove_const<U>::type;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = U*;
+      using reference         = U&;
+
+      //-----------------------------------------------------------------------
+      // Constructors
+      //-----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a singular iterator, which may only be assigned
+      ///        to
+      intrusive_list_iterator() noexcept;
+
+      /// \brief Constructs an iterator to the element that owns \p hook
+      ///
+      /// \param hook the hook of the element
+      explicit intrusive_list_iterator(not_null<intrusive_list_hook*> hook) noexcept;
+
+      /// \brief Converts a mutable iterator to a const iterator
+      ///
+      /// \param other the iterator to convert
+      template <typename V,
+                typename = typename std::enable_if<std::is_same<const V,U>::value>::type>
+      intrusive_list_iterator(const intrusive_list_iterator<V,Traits>& other) noexcept;
+
+      intrusive_list_iterator(const intrusive_list_iterator& other) = default;
+
+      auto operator=(const intrusive_list_iterator& other)
+        -> intrusive_list_iterator& = default;
+
+      //-----------------------------------------------------------------------
+      // Iteration
+      //-----------------------------------------------------------------------
+    public:
+
+      auto operator++() noexcept -> intrusive_list_iterator&;
+      auto operator++(int) noexcept -> intrusive_list_iterator;
+      auto operator--() noexcept -> intrusive_list_iterator&;
+      auto operator--(int) noexcept -> intrusive_list_iterator;
+
+      //-----------------------------------------------------------------------
+      // Observers
+      //-----------------------------------------------------------------------
+    public:
+
+      auto operator*() const noexcept -> reference;
+      auto operator->() const noexcept -> pointer;
+
+      /// \brief Gets the hook of the element this iterator refers to
+      ///
+      /// \return the hook
+      auto hook() const noexcept -> intrusive_list_hook*;
+
+      //-----------------------------------------------------------------------
+      // Private Members
+      //-----------------------------------------------------------------------
+    private:
+
+      intrusive_list_hook* m_hook;
+    };
+
+    template <typename U, typename V, typename Traits>
+    auto operator==(const intrusive_list_iterator<U,Traits>& lhs,
+                    const intrusive_list_iterator<V,Traits>& rhs) noexcept -> bool;
+    template <typename U, typename V, typename Traits>
+    auto operator!=(const intrusive_list_iterator<U,Traits>& lhs,
+                    const intrusive_list_iterator<V,Traits>& rhs) noexcept -> bool;
+
+  } // namespace detail
+
+  //===========================================================================
+  // class : intrusive_list
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief A circular, doubly-linked list of objects that contain their own
+  ///        links
+  ///
+  /// An `intrusive_list` does not own or allocate its elements; each element
+  /// contains an `intrusive_list_hook`, identified by \p Hook, which links
+  /// it to its neighbours. An object may be in as many lists at once as it
+  /// has hooks.
+  ///
+  /// The list is headed by a sentinel hook, so the first element follows
+  /// the sentinel and the last element precedes it. Since no link is ever
+  /// null, inserting, erasing, and splicing never test for the start or the
+  /// end of the list, and iterating is a chain of loads.
+  ///
+  /// The size of the list is not stored, since an element may unlink itself
+  /// without access to the list; `size()` is linear.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// struct task
+  /// {
+  ///   int priority;
+  ///   cpp::intrusive_list_hook hook;
+  /// };
+  ///
+  /// auto ready = cpp::intrusive_list<task, &task::hook>{};
+  ///
+  /// auto t = task{};
+  /// ready.push_back(t);
+  ///
+  /// for (auto& t : ready) {
+  ///   run(t);
+  /// }
+  /// ```
+  ///
+  /// \tparam T the type of the elements
+  /// \tparam Hook the member of \p T that links it into this list
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T, intrusive_list_hook T::*Hook>
+  class intrusive_list
+  {
+    using traits_type = detail::intrusive_list_traits<T,Hook>;
+
+    //-------------------------------------------------------------------------
+    // Public Member Types
+    //-------------------------------------------------------------------------
+  public:
+
+    using value_type             = T;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+    using iterator               = detail::intrusive_list_iterator<T,traits_type>;
+    using const_iterator         = detail::intrusive_list_iterator<const T,traits_type>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    //-------------------------------------------------------------------------
+    // Constructors / Assignment / Destructor
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Constructs an empty list
+    intrusive_list() noexcept;
+
+    /// \brief Constructs this list by taking the elements of \p other
+    ///
+    /// \post `other.empty()`
+    ///
+    /// \param other the list to take the elements of
+    intrusive_list(intrusive_list&& other) noexcept;
+
+    // intrusive_list is not copyable, since an element may only be in one
+    // list per hook
+    intrusive_list(const intrusive_list&) = delete;
+
+    //-------------------------------------------------------------------------
+
+    /// \brief Unlinks every element of this list, and takes the elements of
+    ///        \p other
+    ///
+    /// \post `other.empty()`
+    ///
+    /// \param other the list to take the elements of
+    /// \return reference to `(*this)`
+    auto operator=(intrusive_list&& other) noexcept -> intrusive_list&;
+
+    auto operator=(const intrusive_list&) -> intrusive_list& = delete;
+
+    //-------------------------------------------------------------------------
+
+    /// \brief Unlinks every element of this list
+    ~intrusive_list();
+
+    //-------------------------------------------------------------------------
+    // Iterators
+    //-------------------------------------------------------------------------
+  public:
+
+    auto begin() noexcept -> iterator;
+    auto begin() const noexcept -> const_iterator;
+    auto cbegin() const noexcept -> const_iterator;
+
+    auto end() noexcept -> iterator;
+    auto end() const noexcept -> const_iterator;
+    auto cend() const noexcept -> const_iterator;
+
+    auto rbegin() noexcept -> reverse_iterator;
+    auto rbegin() const noexcept -> const_reverse_iterator;
+    auto crbegin() const noexcept -> const_reverse_iterator;
+
+    auto rend() noexcept -> reverse_iterator;
+    auto rend() const noexcept -> const_reverse_iterator;
+    auto crend() const noexcept -> const_reverse_iterator;
+
+    /// \{
+    /// \brief Gets an iterator to \p value, which is an element of this list
+    ///
+    /// \pre \p value is an element of this list
+    ///
+    /// \param value the element
+    /// \return an iterator to \p value
+    static auto iterator_to(T& value) noexcept -> iterator;
+    static auto iterator_to(const T& value) noexcept -> const_iterator;
+    /// \}
+
+    //-------------------------------------------------------------------------
+    // Capacity
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Queries whether this list has no elements
+    ///
+    /// \return `true` if this list is empty
+    auto empty() const noexcept -> bool;
+
+    /// \brief Counts the elements of this list in linear time
+    ///
+    /// \return the number of elements
+    auto size() const noexcept -> size_type;
+
+    //-------------------------------------------------------------------------
+    // Element Access
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \{
+    /// \brief Gets the first element of this list
+    ///
+    /// \pre `!empty()`
+    ///
+    /// \return reference to the first element
+    auto front() noexcept -> reference;
+    auto front() const noexcept -> const_reference;
+    /// \}
+
+    /// \{
+    /// \brief Gets the last element of this list
+    ///
+    /// \pre `!empty()`
+    ///
+    /// \return reference to the last element
+    auto back() noexcept -> reference;
+    auto back() const noexcept -> const_reference;
+    /// \}
+
+    //-------------------------------------------------------------------------
+    // Modifiers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Links \p value into this list at the front
+    ///
+    /// \pre \p value is not an element of a list through \p Hook
+    ///
+    /// \param value the value to link
+    auto push_front(T& value) noexcept -> void;
+
+    /// \brief Links \p value into this list at the back
+    ///
+    /// \pre \p value is not an element of a list through \p Hook
+    ///
+    /// \param value the value to link
+    auto push_back(T& value) noexcept -> void;
+
+    /// \brief Unlinks the first element of this list
+    ///
+    /// \pre `!empty()`
+    auto pop_front() noexcept -> void;
+
+    /// \brief Unlinks the last element of this list
+    ///
+    /// \pre `!empty()`
+    auto pop_back() noexcept -> void;
+
+    /// \brief Links \p value into this list immediately before \p pos
+    ///
+    /// \pre \p value is not an element of a list through \p Hook
+    ///
+    /// \param pos the position to insert before
+    /// \param value the value to link
+    /// \return an iterator to \p value
+    auto insert(const_iterator pos, T& value) noexcept -> iterator;
+
+    /// \brief Unlinks the element at \p pos
+    ///
+    /// \pre \p pos refers to an element of this list
+    ///
+    /// \param pos the element to unlink
+    /// \return an iterator to the element that followed \p pos
+    auto erase(const_iterator pos) noexcept -> iterator;
+
+    /// \brief Unlinks the elements in the range [\p first, \p last)
+    ///
+    /// \param first the first element to unlink
+    /// \param last the element following the last element to unlink
+    /// \return \p last
+    auto erase(const_iterator first, const_iterator last) noexcept -> iterator;
+
+    /// \brief Unlinks every element of this list in linear time
+    auto clear() noexcept -> void;
+
+    //-------------------------------------------------------------------------
+
+    /// \brief Moves every element of \p other into this list, immediately
+    ///        before \p pos, in constant time
+    ///
+    /// \param pos the position to insert before
+    /// \param other the list to move the elements of
+    auto splice(const_iterator pos, intrusive_list& other) noexcept -> void;
+
+    /// \brief Moves the element at \p it from \p other into this list,
+    ///        immediately before \p pos, in constant time
+    ///
+    /// \pre \p it refers to an element of \p other
+    ///
+    /// \param pos the position to insert before
+    /// \param other the list that contains \p it
+    /// \param it the element to move
+    auto splice(const_iterator pos,
+                intrusive_list& other,
+                const_iterator it) noexcept -> void;
+
+    /// \brief Moves the elements in the range [\p first, \p last) from
+    ///        \p other into this list, immediately before \p pos, in
+    ///        constant time
+    ///
+    /// \pre \p pos is not in the range [\p first, \p last)
+    ///
+    /// \param pos the position to insert before
+    /// \param other the list that contains the range
+    /// \param first the first element to move
+    /// \param last the element following the last element to move
+    auto splice(const_iterator pos,
+                intrusive_list& other,
+                const_iterator first,
+                const_iterator last) noexcept -> void;
+
+    //-------------------------------------------------------------------------
+
+    /// \brief Swaps the elements of this list with the elements of \p other
+    ///        in constant time
+    ///
+    /// \param other the other list
+    auto swap(intrusive_list& other) noexcept -> void;
+
+    //-------------------------------------------------------------------------
+    // Private Members
+    //-------------------------------------------------------------------------
+  private:
+
+    intrusive_list_hook m_head;
+  };
+
+  //===========================================================================
+  // non-member functions : class : intrusive_list
+  //===========================================================================
+
+  template <typename T, intrusive_list_hook T::*Hook>
+  auto swap(intrusive_list<T,Hook>& lhs, intrusive_list<T,Hook>& rhs) noexcept -> void;
+
+} // inline namespace bitwizeshift
+} // namespace cpp
+
+//=============================================================================
+// class : intrusive_list_hook
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment / Destructor
+//-----------------------------------------------------------------------------
+
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::intrusive_list_hook::intrusive_list_hook()
+  noexcept
+  : m_next{detail::not_null_factory::make(this)},
+    m_prev{detail::not_null_factory::make(this)}
+{
+
+}
+
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::intrusive_list_hook::intrusive_list_hook(const intrusive_list_hook&)
+  noexcept
+  : intrusive_list_hook{}
+{
+
+}
+
+//-----------------------------------------------------------------------------
+
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list_hook::operator=(const intrusive_list_hook&)
+  noexcept -> intrusive_list_hook&
+{
+  return (*this);
+}
+
+//-----------------------------------------------------------------------------
+
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::intrusive_list_hook::~intrusive_list_hook()
+{
+  unlink();
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list_hook::is_linked()
+  const noexcept -> bool
+{
+  return m_next.get() != this;
+}
+
+//-----------------------------------------------------------------------------
+// Modifiers
+//-----------------------------------------------------------------------------
+
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list_hook::unlink()
+  noexcept -> void
+{
+  // An unlinked hook is its own neighbour, so this writes its links back to
+  // itself rather than requiring a test for whether it is linked. Both links
+  // are read first, since writing through one may alias the other.
+  const auto next = m_next;
+  const auto prev = m_prev;
+
+  prev->m_next = next;
+  next->m_prev = prev;
+  reset();
+}
+
+//-----------------------------------------------------------------------------
+// Private Member Functions
+//-----------------------------------------------------------------------------
+
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list_hook::link_before(not_null<intrusive_list_hook*> pos)
+  noexcept -> void
+{
+  const auto self = detail::not_null_factory::make(this);
+  const auto prev = pos->m_prev;
+
+  m_next = pos;
+  m_prev = prev;
+  prev->m_next = self;
+  pos->m_prev = self;
+}
+
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list_hook::reset()
+  noexcept -> void
+{
+  m_next = detail::not_null_factory::make(this);
+  m_prev = detail::not_null_factory::make(this);
+}
+
+//=============================================================================
+// struct : detail::intrusive_list_traits
+//=============================================================================
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+std::atomic<std::ptrdiff_t> NOT_NULL_NS_IMPL::detail::intrusive_list_traits<T,Hook>::s_hook_offset{0};
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::intrusive_list_traits<T,Hook>::to_hook(T& value)
+  noexcept -> not_null<intrusive_list_hook*>
+{
+  auto* const hook = &(value.*Hook);
+
+  s_hook_offset.store(
+    reinterpret_cast<unsigned char*>(hook) - reinterpret_cast<unsigned char*>(&value),
+    std::memory_order_relaxed
+  );
+  return not_null_factory::make(hook);
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::intrusive_list_traits<T,Hook>::to_value(intrusive_list_hook* hook)
+  noexcept -> T*
+{
+  return mark_nonnull(
+    reinterpret_cast<T*>(
+      reinterpret_cast<unsigned char*>(hook) -
+      s_hook_offset.load(std::memory_order_relaxed)
+    )
+  );
+}
+
+//=============================================================================
+// class : detail::intrusive_list_iterator
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors
+//-----------------------------------------------------------------------------
+
+template <typename U, typename Traits>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::detail::intrusive_list_iterator<U,Traits>::intrusive_list_iterator()
+  noexcept
+  : m_hook{nullptr}
+{
+
+}
+
+template <typename U, typename Traits>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::detail::intrusive_list_iterator<U,Traits>::intrusive_list_iterator(not_null<intrusive_list_hook*> hook)
+  noexcept
+  : m_hook{hook.get()}
+{
+
+}
+
+template <typename U, typename Traits>
+template <typename V, typename>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::detail::intrusive_list_iterator<U,Traits>::intrusive_list_iterator(const intrusive_list_iterator<V,Traits>& other)
+  noexcept
+  : m_hook{other.hook()}
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Iteration
+//-----------------------------------------------------------------------------
+
+template <typename U, typename Traits>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::intrusive_list_iterator<U,Traits>::operator++()
+  noexcept -> intrusive_list_iterator&
+{
+  m_hook = m_hook->m_next.get();
+  return (*this);
+}
+
+template <typename U, typename Traits>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::intrusive_list_iterator<U,Traits>::operator++(int)
+  noexcept -> intrusive_list_iterator
+{
+  auto copy = (*this);
+  m_hook = m_hook->m_next.get();
+  return copy;
+}
+
+template <typename U, typename Traits>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::intrusive_list_iterator<U,Traits>::operator--()
+  noexcept -> intrusive_list_iterator&
+{
+  m_hook = m_hook->m_prev.get();
+  return (*this);
+}
+
+template <typename U, typename Traits>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::intrusive_list_iterator<U,Traits>::operator--(int)
+  noexcept -> intrusive_list_iterator
+{
+  auto copy = (*this);
+  m_hook = m_hook->m_prev.get();
+  return copy;
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+template <typename U, typename Traits>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::intrusive_list_iterator<U,Traits>::operator*()
+  const noexcept -> reference
+{
+  return *Traits::to_value(m_hook);
+}
+
+template <typename U, typename Traits>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::intrusive_list_iterator<U,Traits>::operator->()
+  const noexcept -> pointer
+{
+  return Traits::to_value(m_hook);
+}
+
+template <typename U, typename Traits>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::intrusive_list_iterator<U,Traits>::hook()
+  const noexcept -> intrusive_list_hook*
+{
+  return m_hook;
+}
+
+//=============================================================================
+// non-member functions : class : detail::intrusive_list_iterator
+//=============================================================================
+
+template <typename U, typename V, typename Traits>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::operator==(const intrusive_list_iterator<U,Traits>& lhs,
+                                          const intrusive_list_iterator<V,Traits>& rhs)
+  noexcept -> bool
+{
+  return lhs.hook() == rhs.hook();
+}
+
+template <typename U, typename V, typename Traits>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::operator!=(const intrusive_list_iterator<U,Traits>& lhs,
+                                          const intrusive_list_iterator<V,Traits>& rhs)
+  noexcept -> bool
+{
+  return lhs.hook() != rhs.hook();
+}
+
+//=============================================================================
+// class : intrusive_list
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment / Destructor
+//-----------------------------------------------------------------------------
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline
+NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::intrusive_list()
+  noexcept
+  : m_head{}
+{
+
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline
+NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::intrusive_list(intrusive_list&& other)
+  noexcept
+  : m_head{}
+{
+  // This head takes the place of the other head in its ring, which works
+  // whether or not the other list is empty
+  m_head.link_before(detail::not_null_factory::make(&other.m_head));
+  other.m_head.unlink();
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::operator=(intrusive_list&& other)
+  noexcept -> intrusive_list&
+{
+  clear();
+  m_head.link_before(detail::not_null_factory::make(&other.m_head));
+  other.m_head.unlink();
+
+  return (*this);
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline
+NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::~intrusive_list()
+{
+  clear();
+}
+
+//-----------------------------------------------------------------------------
+// Iterators
+//-----------------------------------------------------------------------------
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::begin()
+  noexcept -> iterator
+{
+  return iterator{m_head.m_next};
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::begin()
+  const noexcept -> const_iterator
+{
+  return const_iterator{m_head.m_next};
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::cbegin()
+  const noexcept -> const_iterator
+{
+  return begin();
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::end()
+  noexcept -> iterator
+{
+  return iterator{detail::not_null_factory::make(&m_head)};
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::end()
+  const noexcept -> const_iterator
+{
+  // The sentinel is never modified through a const_iterator
+  return const_iterator{
+    detail::not_null_factory::make(const_cast<intrusive_list_hook*>(&m_head))
+  };
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::cend()
+  const noexcept -> const_iterator
+{
+  return end();
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::rbegin()
+  noexcept -> reverse_iterator
+{
+  return reverse_iterator{end()};
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::rbegin()
+  const noexcept -> const_reverse_iterator
+{
+  return const_reverse_iterator{end()};
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::crbegin()
+  const noexcept -> const_reverse_iterator
+{
+  return rbegin();
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::rend()
+  noexcept -> reverse_iterator
+{
+  return reverse_iterator{begin()};
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::rend()
+  const noexcept -> const_reverse_iterator
+{
+  return const_reverse_iterator{begin()};
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::crend()
+  const noexcept -> const_reverse_iterator
+{
+  return rend();
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::iterator_to(T& value)
+  noexcept -> iterator
+{
+  return iterator{traits_type::to_hook(value)};
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::iterator_to(const T& value)
+  noexcept -> const_iterator
+{
+  return const_iterator{traits_type::to_hook(const_cast<T&>(value))};
+}
+
+//-----------------------------------------------------------------------------
+// Capacity
+//-----------------------------------------------------------------------------
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::empty()
+  const noexcept -> bool
+{
+  return !m_head.is_linked();
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::size()
+  const noexcept -> size_type
+{
+  auto result = size_type{0};
+  for (auto it = begin(); it != end(); ++it) {
+    ++result;
+  }
+  return result;
+}
+
+//-----------------------------------------------------------------------------
+// Element Access
+//-----------------------------------------------------------------------------
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::front()
+  noexcept -> reference
+{
+  return *begin();
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::front()
+  const noexcept -> const_reference
+{
+  return *begin();
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::back()
+  noexcept -> reference
+{
+  return *iterator{m_head.m_prev};
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::back()
+  const noexcept -> const_reference
+{
+  return *const_iterator{m_head.m_prev};
+}
+
+//-----------------------------------------------------------------------------
+// Modifiers
+//-----------------------------------------------------------------------------
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::push_front(T& value)
+  noexcept -> void
+{
+  traits_type::to_hook(value)->link_before(m_head.m_next);
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::push_back(T& value)
+  noexcept -> void
+{
+  traits_type::to_hook(value)->link_before(detail::not_null_factory::make(&m_head));
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::pop_front()
+  noexcept -> void
+{
+  m_head.m_next->unlink();
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::pop_back()
+  noexcept -> void
+{
+  m_head.m_prev->unlink();
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::insert(const_iterator pos, T& value)
+  noexcept -> iterator
+{
+  const auto hook = traits_type::to_hook(value);
+  hook->link_before(detail::not_null_factory::make(pos.hook()));
+
+  return iterator{hook};
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::erase(const_iterator pos)
+  noexcept -> iterator
+{
+  const auto next = pos.hook()->m_next;
+  pos.hook()->unlink();
+
+  return iterator{next};
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::erase(const_iterator first,
+                                                     const_iterator last)
+  noexcept -> iterator
+{
+  while (first != last) {
+    first = erase(first);
+  }
+  return iterator{detail::not_null_factory::make(last.hook())};
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::clear()
+  noexcept -> void
+{
+  // The neighbours of each element are about to be unlinked as well, so
+  // each hook only needs to be linked back to itself
+  auto* hook = m_head.m_next.get();
+  while (hook != &m_head) {
+    auto* const next = hook->m_next.get();
+    hook->reset();
+    hook = next;
+  }
+  m_head.reset();
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::splice(const_iterator pos,
+                                                      intrusive_list& other)
+  noexcept -> void
+{
+  splice(pos, other, other.begin(), other.end());
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::splice(const_iterator pos,
+                                                      intrusive_list&,
+                                                      const_iterator it)
+  noexcept -> void
+{
+  // A hook cannot be linked before itself
+  if (pos == it) {
+    return;
+  }
+  const auto hook = it.hook();
+  hook->unlink();
+  hook->link_before(detail::not_null_factory::make(pos.hook()));
+}
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::splice(const_iterator pos,
+                                                      intrusive_list&,
+                                                      const_iterator first,
+                                                      const_iterator last)
+  noexcept -> void
+{
+  // An empty range has no first and last element to relink
+  if (first == last) {
+    return;
+  }
+
+  const auto head = detail::not_null_factory::make(first.hook());
+  const auto tail = last.hook()->m_prev;
+  const auto next = detail::not_null_factory::make(last.hook());
+  const auto before = head->m_prev;
+  const auto after = detail::not_null_factory::make(pos.hook());
+
+  // Close the gap left by the range
+  before->m_next = next;
+  next->m_prev = before;
+
+  // Link the range between 'prev' and 'after'. This is read after the gap
+  // is closed, since 'after' may be 'next'
+  const auto prev = after->m_prev;
+  prev->m_next = head;
+  head->m_prev = prev;
+  tail->m_next = after;
+  after->m_prev = tail;
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline
+auto NOT_NULL_NS_IMPL::intrusive_list<T,Hook>::swap(intrusive_list& other)
+  noexcept -> void
+{
+  // Each head takes the place of another in its ring, using a temporary
+  // hook as a placeholder. This works whether or not either list is empty.
+  auto temporary = intrusive_list_hook{};
+  const auto placeholder = detail::not_null_factory::make(&temporary);
+
+  temporary.link_before(detail::not_null_factory::make(&other.m_head));
+  other.m_head.unlink();
+  other.m_head.link_before(detail::not_null_factory::make(&m_head));
+  m_head.unlink();
+  m_head.link_before(placeholder);
+  temporary.unlink();
+}
+
+//=============================================================================
+// non-member functions : class : intrusive_list
+//=============================================================================
+
+template <typename T, NOT_NULL_NS_IMPL::intrusive_list_hook T::*Hook>
+inline
+auto NOT_NULL_NS_IMPL::swap(intrusive_list<T,Hook>& lhs,
+                            intrusive_list<T,Hook>& rhs)
+  noexcept -> void
+{
+  lhs.swap(rhs);
+}
+
+#endif /* CPP_BITWIZESHIFT_INTRUSIVE_LIST_HPP */
@@ -35,12 +35,34 @@
 #include <utility>     // std::forward, std::move
 #include <type_traits> // std::decay_t
 #include <memory>      // std::pointer_traits
+#if !defined(__cpp_lib_smart_ptr_for_overwrite)
+# include <new>        // ::new
+#endif
+#if __cplusplus >= 202002L
+# include <compare>    // std::strong_ordering
+#endif
 #if !defined(NOT_NULL_DISABLE_EXCEPTIONS)
-# include <stdexcept> // std::logic_error
+# include <exception> // std::exception
 #else
 # include <cstdio>  // std::printf
 # include <cstdlib> // std::abort
 #endif
+#if defined(NOT_NULL_AUDIT_SAMPLING)
+# include <cstdio>  // std::fprintf
+# include <cstdlib> // std::abort
+#endif
+#if !defined(__clang__) && !defined(__GNUC__)
+# include <atomic> // std::atomic, std::memory_order
+#endif
+#if defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+# include <algorithm> // std::sort
+# include <atomic>    // std::atomic
+# include <cstdint>   // std::uint64_t
+# include <cstdio>    // std::FILE, std::fprintf
+# include <cstring>   // std::strcmp
+# include <mutex>     // std::mutex, std::lock_guard
+# include <vector>    // std::vector
+#endif
 
 #if __cplusplus >= 201402L
 # define NOT_NULL_CPP14_CONSTEXPR constexpr
@@ -56,6 +78,74 @@
 # define NOT_NULL_INLINE_VISIBILITY
 #endif
 
+#if defined(__cpp_impl_three_way_comparison) && defined(__cpp_concepts) && \
+    defined(__cpp_lib_three_way_comparison) && defined(__cpp_lib_concepts)
+# define NOT_NULL_HAS_THREE_WAY_COMPARISON 1
+#endif
+
+// Detects whether a constexpr function is being evaluated as a constant
+// expression, so that runtime-only instrumentation can be skipped
+#if defined(__has_builtin)
+# if __has_builtin(__builtin_is_constant_evaluated)
+#   define NOT_NULL_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+# endif
+#endif
+#if !defined(NOT_NULL_IS_CONSTANT_EVALUATED)
+# if (defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 9)) || \
+     (defined(_MSC_VER) && (_MSC_VER >= 1925))
+#   define NOT_NULL_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+# else
+#   define NOT_NULL_IS_CONSTANT_EVALUATED() false
+# endif
+#endif
+
+// Detects whether the caller's source location can be taken as a default
+// argument, so that check counters can attribute plain 'check_not_null' calls
+#if defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+# if defined(__clang__)
+#   if defined(__has_builtin)
+#     if __has_builtin(__builtin_FILE) && __has_builtin(__builtin_LINE) && \
+         __has_builtin(__builtin_FUNCTION)
+#       define NOT_NULL_HAS_BUILTIN_CALL_SITE 1
+#     endif
+#   endif
+# elif defined(__GNUC__) || (defined(_MSC_VER) && (_MSC_VER >= 1926))
+#   define NOT_NULL_HAS_BUILTIN_CALL_SITE 1
+# endif
+#endif
+
+// Marks a function as a rarely-executed path that should never be inlined, so
+// that it is kept out of the hot text of its callers
+#if defined(__clang__) || defined(__GNUC__)
+# define NOT_NULL_COLD [[gnu::cold, gnu::noinline]]
+#elif defined(_MSC_VER)
+# define NOT_NULL_COLD __declspec(noinline)
+#else
+# define NOT_NULL_COLD
+#endif
+
+// Hints to the optimizer that the expression 'x' is true. This is an
+// expression, rather than a statement like C++23's '[[assume(x)]]', so that
+// it may be used in C++11 constexpr functions. Compilers also discard
+// '[[assume]]' and '__builtin_assume' when 'x' calls a function, such as the
+// comparison of a smart pointer to null, whereas marking the false branch
+// unreachable survives once 'x' is inlined.
+#if defined(_MSC_VER) && !defined(__clang__)
+# define NOT_NULL_ASSUME(x) __assume(x)
+#elif defined(__clang__) || defined(__GNUC__)
+# define NOT_NULL_ASSUME(x) ((x) ? static_cast<void>(0) : __builtin_unreachable())
+#else
+# define NOT_NULL_ASSUME(x) static_cast<void>(0)
+#endif
+
+#if defined(__clang__) || defined(__GNUC__)
+# define NOT_NULL_LIKELY(x) __builtin_expect(!!(x), 1)
+# define NOT_NULL_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+# define NOT_NULL_LIKELY(x) (x)
+# define NOT_NULL_UNLIKELY(x) (x)
+#endif
+
 #if defined(NOT_NULL_NAMESPACE)
 # define NOT_NULL_NAMESPACE_INTERNAL NOT_NULL_NAMESPACE
 #else
@@ -63,7 +153,13 @@
 #endif
 #define NOT_NULL_NS_IMPL NOT_NULL_NAMESPACE_INTERNAL::bitwizeshift
 
-namespace NOT_NULL_NAMESPACE_INTERNAL {
+// Defined as 'export' by the 'cpp.not_null' module interface, which includes
+// this header within its purview
+#if !defined(NOT_NULL_EXPORT)
+# define NOT_NULL_EXPORT
+#endif
+
+NOT_NULL_EXPORT namespace NOT_NULL_NAMESPACE_INTERNAL {
 inline namespace bitwizeshift {
 
   template <typename T>
@@ -78,6 +174,31 @@ inline namespace bitwizeshift {
   template <typename T>
   struct is_not_null<not_null<T>> : std::true_type{};
 
+  //===========================================================================
+  // struct : not_null_call_site
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief The source location of a `check_not_null` call, reported when
+  ///        the contract is violated
+  ///
+  /// All strings are expected to have static storage duration, such as those
+  /// produced by `NOT_NULL_CALL_SITE`, so that reporting a violation never
+  /// needs to copy or allocate.
+  /////////////////////////////////////////////////////////////////////////////
+  struct not_null_call_site
+  {
+    const char* file;     ///< The source file, or null if unknown
+    unsigned line;        ///< The source line, or 0 if unknown
+    const char* function; ///< The function name, or null if unknown
+  };
+
+/// \brief Expands to the `not_null_call_site` of the current source location
+///
+/// This may only be used within a function body.
+#define NOT_NULL_CALL_SITE \
+  ::NOT_NULL_NS_IMPL::not_null_call_site{__FILE__, __LINE__, __func__}
+
 #if !defined(NOT_NULL_DISABLE_EXCEPTIONS)
 
   //===========================================================================
@@ -87,22 +208,110 @@ inline namespace bitwizeshift {
   /////////////////////////////////////////////////////////////////////////////
   /// \brief An exception thrown on null contract violations as part of
   ///        check_not_null
+  ///
+  /// This exception never allocates: `what()` returns a static string, and
+  /// the optional call-site information only refers to static strings.
   /////////////////////////////////////////////////////////////////////////////
-  class not_null_contract_violation : public std::logic_error
+  class not_null_contract_violation : public std::exception
   {
     using this_type = not_null_contract_violation;
   public:
 
-    not_null_contract_violation();
+    not_null_contract_violation() noexcept;
+    explicit not_null_contract_violation(const not_null_call_site& site) noexcept;
     not_null_contract_violation(const this_type& other) = default;
     not_null_contract_violation(this_type&& other) = default;
 
     auto operator=(const this_type& other) -> this_type& = default;
     auto operator=(this_type&& other) -> this_type& = default;
+
+    /// \brief Gets a description of the violation
+    ///
+    /// \return a static string
+    auto what() const noexcept -> const char* override;
+
+    /// \brief Gets the location of the check that failed
+    ///
+    /// \return the call site, with all members null/zero if unknown
+    auto call_site() const noexcept -> const not_null_call_site&;
+
+  private:
+
+    not_null_call_site m_call_site;
   };
 
 #endif
 
+  //===========================================================================
+  // utilities : violation handler
+  //===========================================================================
+
+  /// \brief A function that is notified of not_null contract violations
+  using not_null_violation_handler = void(*)(const not_null_call_site& site);
+
+  /// \brief Installs \p handler to be called whenever a not_null contract is
+  ///        violated
+  ///
+  /// The handler is called before the default action for the violation. It
+  /// may log, throw its own exception, or terminate. If it returns, the
+  /// default action still takes place: `not_null_contract_violation` is
+  /// thrown, or the program aborts if `NOT_NULL_DISABLE_EXCEPTIONS` is
+  /// defined.
+  ///
+  /// This may be called concurrently with violations on other threads.
+  ///
+  /// \param handler the handler to install, or `nullptr` to remove it
+  /// \return the previously installed handler
+  auto set_not_null_violation_handler(not_null_violation_handler handler)
+    noexcept -> not_null_violation_handler;
+
+  /// \brief Gets the currently installed violation handler
+  ///
+  /// \return the installed handler, or `nullptr` if none is installed
+  auto get_not_null_violation_handler() noexcept -> not_null_violation_handler;
+
+#if defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+
+  //===========================================================================
+  // utilities : check counters
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief The number of times that a single `check_not_null` call site was
+  ///        executed, and failed
+  ///
+  /// Calls to `check_not_null` without a call site are counted at the
+  /// location of the caller where the compiler provides `__builtin_FILE`,
+  /// `__builtin_LINE` and `__builtin_FUNCTION` (GCC, Clang and MSVC), and
+  /// otherwise are all counted together under a single unknown site, with a
+  /// null `file` and `function`. Counts are only accurate if
+  /// `NOT_NULL_ENABLE_CHECK_COUNTERS` is defined consistently in every
+  /// translation unit.
+  /////////////////////////////////////////////////////////////////////////////
+  struct not_null_check_counts
+  {
+    not_null_call_site site;
+    std::uint64_t checks;
+    std::uint64_t failures;
+  };
+
+  /// \brief Collects the counts of every `check_not_null` call site, summed
+  ///        across all threads that have ever run a check
+  ///
+  /// Each thread counts into its own table without synchronization, so the
+  /// counts of threads that are still running may be slightly stale.
+  ///
+  /// \return the counts, sorted by file and line
+  auto collect_not_null_check_counts() -> std::vector<not_null_check_counts>;
+
+  /// \brief Writes the counts from `collect_not_null_check_counts` to \p out,
+  ///        one call site per line
+  ///
+  /// \param out the file to write to
+  auto dump_not_null_check_counts(std::FILE* out) -> void;
+
+#endif // defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+
 
   //===========================================================================
   // utilities : constexpr forward
@@ -157,8 +366,191 @@ inline namespace bitwizeshift {
     }
     /// \}
 
-    /// \brief Throws a not_null_contract_violation in exception mode
-    [[noreturn]] auto throw_null_pointer_error() -> void;
+    /// \{
+    /// \brief Throws a not_null_contract_violation in exception mode, or
+    ///        prints to `stderr` and aborts otherwise
+    ///
+    /// This is deliberately never inlined, so that every checking call site
+    /// only contains a single call instruction for the failure path. These
+    /// are templates only so that they may be defined in this header without
+    /// `inline`, which some compilers consider contradictory to `noinline`.
+    ///
+    /// The call site is passed as separate arguments, rather than by
+    /// reference, so that the optimizer only materializes it on the failure
+    /// path.
+    ///
+    /// \param file the source file of the check that failed
+    /// \param line the source line of the check that failed
+    /// \param function the function containing the check that failed
+    template <typename = void>
+    [[noreturn]] NOT_NULL_COLD auto throw_null_pointer_error() -> void;
+    template <typename = void>
+    [[noreturn]] NOT_NULL_COLD auto throw_null_pointer_error(const char* file,
+                                                             unsigned line,
+                                                             const char* function) -> void;
+    /// \}
+
+#if defined(NOT_NULL_AUDIT_SAMPLING)
+    static_assert(
+      (NOT_NULL_AUDIT_SAMPLING) > 0,
+      "NOT_NULL_AUDIT_SAMPLING must be a positive sampling interval"
+    );
+
+    /// \brief Determines whether the current call to `assume_not_null`
+    ///        should be audited
+    ///
+    /// This counts down a per-thread counter, and returns `true` once every
+    /// `NOT_NULL_AUDIT_SAMPLING` calls.
+    auto audit_sample_due() noexcept -> bool;
+
+    /// \brief Reports a failed audit of `assume_not_null` and aborts
+    template <typename = void>
+    [[noreturn]] NOT_NULL_COLD auto audit_null_pointer_error() noexcept -> void;
+#endif // defined(NOT_NULL_AUDIT_SAMPLING)
+
+#if defined(__clang__) || defined(__GNUC__)
+    // GCC and Clang can operate atomically on a plain object, which avoids
+    // including '<atomic>' in every translation unit that uses not_null
+    using violation_handler_cell = not_null_violation_handler;
+#else
+    using violation_handler_cell = std::atomic<not_null_violation_handler>;
+#endif
+
+    /// \brief Gets the storage for the installed violation handler
+    auto violation_handler_storage() noexcept -> violation_handler_cell&;
+
+#if defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A fixed-size table of call site counters, written by a single
+    ///        thread and read by any thread
+    ///
+    /// Counters are atomics only so that they may be read while being
+    /// written; the owning thread updates them with relaxed loads and
+    /// stores, which compile to plain moves.
+    ///////////////////////////////////////////////////////////////////////////
+    class check_counter_table
+    {
+    public:
+
+      check_counter_table() noexcept;
+
+      /// \brief Counts one execution of the check at the given call site
+      auto record(const char* file,
+                  unsigned line,
+                  const char* function,
+                  bool failed) noexcept -> void;
+
+      /// \brief Appends the counts of every used slot to \p out
+      auto collect(std::vector<not_null_check_counts>& out) const -> void;
+
+    private:
+
+      struct slot
+      {
+        std::atomic<const char*> file;
+        std::atomic<unsigned> line;
+        std::atomic<const char*> function;
+        std::atomic<std::uint64_t> checks;
+        std::atomic<std::uint64_t> failures;
+      };
+
+      // A power of two. Checks made without a call site, and call sites past
+      // this many per thread, are counted in the last slot, with an unknown
+      // location.
+      static constexpr std::size_t capacity = 256u;
+
+      slot m_slots[capacity];
+    };
+
+    /// \brief The tables of all live threads, and the merged counts of all
+    ///        threads that have exited
+    struct check_counter_registry
+    {
+      std::mutex mutex;
+      std::vector<const check_counter_table*> live;
+      std::vector<not_null_check_counts> retired;
+
+      static auto instance() -> check_counter_registry&;
+    };
+
+    /// \brief Registers a thread's table for the lifetime of the thread
+    class thread_check_counters
+    {
+    public:
+
+      thread_check_counters();
+      ~thread_check_counters();
+
+      thread_check_counters(const thread_check_counters&) = delete;
+      auto operator=(const thread_check_counters&) -> thread_check_counters& = delete;
+
+      check_counter_table table;
+    };
+
+    /// \brief Counts one execution of the check at the given call site on
+    ///        the current thread
+    auto record_check(const char* file,
+                      unsigned line,
+                      const char* function,
+                      bool failed) noexcept -> void;
+
+#endif // defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+
+    /// \{
+    /// \brief Determines whether any element in the range of `n` elements
+    ///        starting at `first` is null
+    ///
+    /// Unlike a loop that exits on the first null, this does not branch
+    /// per element.
+    template <typename T>
+    auto contains_null(const T* first, std::size_t n) noexcept -> bool;
+    template <typename T>
+    auto contains_null(T* const* first, std::size_t n, std::true_type) noexcept -> bool;
+    template <typename T>
+    auto contains_null(const T* first, std::size_t n, std::false_type) noexcept -> bool;
+    /// \}
+
+#if !defined(__cpp_lib_smart_ptr_for_overwrite)
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief An allocator adaptor that default-initializes objects that are
+    ///        constructed without arguments, rather than value-initializing
+    ///        them
+    ///
+    /// This is used to implement the `_for_overwrite` factories with
+    /// `std::allocate_shared`, so that the object and its control block
+    /// remain in a single allocation. It is only needed where the standard
+    /// library lacks `std::allocate_shared_for_overwrite`.
+    ///
+    /// \tparam A the allocator to adapt
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename A>
+    class default_init_allocator : public A
+    {
+      using traits = std::allocator_traits<A>;
+
+    public:
+
+      template <typename U>
+      struct rebind
+      {
+        using other = default_init_allocator<
+          typename traits::template rebind_alloc<U>
+        >;
+      };
+
+      default_init_allocator(const A& alloc) noexcept;
+
+      template <typename U>
+      default_init_allocator(const default_init_allocator<U>& other) noexcept;
+
+      template <typename U>
+      auto construct(U* p)
+        noexcept(std::is_nothrow_default_constructible<U>::value) -> void;
+      template <typename U, typename Arg0, typename...Args>
+      auto construct(U* p, Arg0&& arg0, Args&&...args) -> void;
+    };
+#endif
 
     ///////////////////////////////////////////////////////////////////////////
     /// \brief A private type that exists to construct no_null's using the
@@ -180,6 +572,21 @@ inline namespace bitwizeshift {
 #endif
     constexpr auto mark_nonnull(T* p) noexcept -> T*;
 
+    /// \brief Hint to the compiler that the pointer \p p can never be null,
+    ///        if it is a raw pointer
+    ///
+    /// A `not_null` smart pointer becomes null once it is moved from, so no
+    /// assumption can be made about it without also making every observation
+    /// of a moved-from `not_null` undefined. A raw pointer is left unchanged
+    /// by a move, and so is never null.
+    ///
+    /// \param p the pointer
+    /// \return \p p
+    template <typename T>
+    constexpr auto assume_nonnull_if_raw(T* const& p) noexcept -> T* const&;
+    template <typename T>
+    constexpr auto assume_nonnull_if_raw(const T& p) noexcept -> const T&;
+
     template <typename T, typename U>
     struct not_null_is_explicit_convertible : std::integral_constant<bool,(
       std::is_constructible<T,U>::value &&
@@ -317,11 +724,11 @@ inline namespace bitwizeshift {
     /// \param other the other not_null to convert
     template <typename U,
               typename std::enable_if<detail::not_null_is_implicit_convertible<T,const U&>::value,int>::type = 0>
-    not_null(const not_null<U>& other)
+    constexpr not_null(const not_null<U>& other)
       noexcept(std::is_nothrow_constructible<T,const U&>::value);
     template <typename U,
               typename std::enable_if<detail::not_null_is_explicit_convertible<T,const U&>::value,int>::type = 0>
-    explicit not_null(const not_null<U>& other)
+    constexpr explicit not_null(const not_null<U>& other)
       noexcept(std::is_nothrow_constructible<T,const U&>::value);
     /// \}
 
@@ -363,11 +770,11 @@ inline namespace bitwizeshift {
     /// \param other the other not_null to convert
     template <typename U,
               typename std::enable_if<detail::not_null_is_implicit_convertible<T,U&&>::value,int>::type = 0>
-    not_null(not_null<U>&& other)
+    constexpr not_null(not_null<U>&& other)
       noexcept(std::is_nothrow_constructible<T,U&&>::value);
     template <typename U,
               typename std::enable_if<detail::not_null_is_explicit_convertible<T,U&&>::value,int>::type = 0>
-    explicit not_null(not_null<U>&& other)
+    constexpr explicit not_null(not_null<U>&& other)
       noexcept(std::is_nothrow_constructible<T,U&&>::value);
     /// \}
 
@@ -488,6 +895,9 @@ inline namespace bitwizeshift {
       noexcept(std::is_nothrow_constructible<typename std::decay<P>::type,P>::value);
 
     friend detail::not_null_factory;
+
+    template <typename>
+    friend class not_null;
   };
 
   //===========================================================================
@@ -528,12 +938,43 @@ inline namespace bitwizeshift {
   ///
   /// ```
   ///
+  /// If `NOT_NULL_ENABLE_CHECK_COUNTERS` is defined, the trailing parameters
+  /// default to the location of the caller so that the check is counted at
+  /// its call site; they should not be passed explicitly.
+  ///
   /// \throw not_null_contract_violation if `ptr == nullptr`
   /// \param ptr the pointer to check for nullability first
   /// \return a `not_null` object containing `ptr`
   template <typename T>
+#if defined(NOT_NULL_HAS_BUILTIN_CALL_SITE)
+  constexpr auto check_not_null(T&& ptr,
+                                const char* file = __builtin_FILE(),
+                                unsigned line = static_cast<unsigned>(__builtin_LINE()),
+                                const char* function = __builtin_FUNCTION())
+    -> not_null<typename std::decay<T>::type>;
+#else
   constexpr auto check_not_null(T&& ptr)
     -> not_null<typename std::decay<T>::type>;
+#endif
+
+  /// \brief Creates a `not_null` object by checking that `ptr` is not null
+  ///        first, reporting \p site if it is
+  ///
+  /// ### Examples
+  ///
+  /// Basic use:
+  ///
+  /// ```cpp
+  /// auto w = check_not_null(find_widget(), NOT_NULL_CALL_SITE);
+  /// ```
+  ///
+  /// \throw not_null_contract_violation if `ptr == nullptr`
+  /// \param ptr the pointer to check for nullability first
+  /// \param site the location of this check
+  /// \return a `not_null` object containing `ptr`
+  template <typename T>
+  constexpr auto check_not_null(T&& ptr, const not_null_call_site& site)
+    -> not_null<typename std::decay<T>::type>;
 
   /// \brief Creates a `not_null` object by *assuming* that `ptr` is not null
   ///
@@ -547,6 +988,12 @@ inline namespace bitwizeshift {
   /// `ptr` can never be null, such as for an object's invariant, or when
   /// using `not_null` with already known non-null objects.
   ///
+  /// If `NOT_NULL_AUDIT_SAMPLING` is defined to a positive number `N`, one in
+  /// every `N` calls on each thread checks the assumption. A failed check is
+  /// reported to the installed violation handler, and then aborts the program
+  /// -- since this function is `noexcept`, it cannot throw. Calls evaluated
+  /// at compile-time are never audited.
+  ///
   /// ### Examples
   ///
   /// Basic use:
@@ -577,65 +1024,368 @@ inline namespace bitwizeshift {
     -> not_null<typename std::decay<T>::type>;
 
   //---------------------------------------------------------------------------
-  // Comparisons
+  // Bulk Utilities
   //---------------------------------------------------------------------------
 
+  /// \brief Finds the first null pointer in the contiguous range of `n`
+  ///        pointers starting at `first`
+  ///
+  /// Rather than comparing and branching on every element, the range is
+  /// scanned in fixed-size blocks, and only a single branch is taken for
+  /// each block. The per-block scan contains no control flow, which allows
+  /// the compiler to vectorize it for the instruction set being targeted
+  /// (e.g. with `-mavx2` or `-mavx512f`), making the scan bound by memory
+  /// bandwidth rather than by branch prediction.
+  ///
+  /// ### Examples
+  ///
+  /// Basic use:
+  ///
+  /// ```cpp
+  /// Widget* widgets[] = {&a, nullptr, &b};
+  ///
+  /// assert(find_null(widgets, 3) == 1u);
+  /// ```
+  ///
+  /// \param first pointer to the first pointer in the range
+  /// \param n the number of pointers in the range
+  /// \return the index of the first null pointer, or `n` if there is none
   template <typename T>
-  constexpr auto operator==(const not_null<T>& lhs, std::nullptr_t) noexcept -> bool;
+  auto find_null(T* const* first, std::size_t n) noexcept -> std::size_t;
+
+  /// \brief Checks that every pointer in the contiguous range of `n`
+  ///        pointers starting at `first` is not null
+  ///
+  /// This is equivalent to calling `check_not_null` on every element, except
+  /// that the range is scanned with `find_null`, and the contract violation
+  /// is raised at most once for the whole range.
+  ///
+  /// If the index of the offending pointer is needed, use `find_null`
+  /// directly instead.
+  ///
+  /// ### Examples
+  ///
+  /// Basic use:
+  ///
+  /// ```cpp
+  /// auto ingest(Record* const* records, std::size_t n) -> void
+  /// {
+  ///   // Records from the C API are never expected to be null
+  ///   check_all_not_null(records, n);
+  ///
+  ///   for (auto i = 0u; i < n; ++i) {
+  ///     consume(assume_not_null(records[i]));
+  ///   }
+  /// }
+  /// ```
+  ///
+  /// \throw not_null_contract_violation if any pointer in the range is null
+  /// \param first pointer to the first pointer in the range
+  /// \param n the number of pointers in the range
   template <typename T>
-  constexpr auto operator==(std::nullptr_t, const not_null<T>& rhs) noexcept -> bool;
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() == std::declval<const U&>())>
-  constexpr auto operator==(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() == std::declval<const U&>())>
-  constexpr auto operator==(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() == std::declval<const U&>())>
-  constexpr auto operator==(const T& lhs, const not_null<U>& rhs) noexcept -> bool;
+  auto check_all_not_null(T* const* first, std::size_t n) -> void;
 
+  /// \{
+  /// \brief Adopts a contiguous range of `n` nullable pointers starting at
+  ///        `first` as a range of `not_null` pointers, checking that none
+  ///        of them are null first
+  ///
+  /// `not_null<T>` is guaranteed to have the same size and alignment as `T`,
+  /// and to be standard-layout if `T` is. This allows an existing array of
+  /// `T` (such as the storage of a `std::vector<T>`) to be viewed in-place
+  /// as an array of `not_null<T>`, without moving or copying any elements.
+  ///
+  /// The range is checked as a whole, and the contract violation is raised
+  /// at most once. For ranges of raw pointers, this uses `find_null`.
+  ///
+  /// \note The returned pointer aliases the storage of the input range, and
+  ///       is only valid for as long as that storage is. While it is in use,
+  ///       none of the elements may be set to null through the original
+  ///       range.
+  ///
+  /// ### Examples
+  ///
+  /// Basic use:
+  ///
+  /// ```cpp
+  /// auto widgets = std::vector<std::unique_ptr<Widget>>{ ... };
+  ///
+  /// auto* nn = check_not_null_range(widgets.data(), widgets.size());
+  /// for (auto i = 0u; i < widgets.size(); ++i) {
+  ///   consume(nn[i]); // 'nn[i]' is a 'not_null<std::unique_ptr<Widget>>&'
+  /// }
+  /// ```
+  ///
+  /// \throw not_null_contract_violation if any pointer in the range is null
+  /// \param first pointer to the first element of the range
+  /// \param n the number of elements in the range
+  /// \return a pointer to the first element, as a `not_null`
   template <typename T>
-  constexpr auto operator!=(const not_null<T>& lhs, std::nullptr_t) noexcept -> bool;
+  auto check_not_null_range(T* first, std::size_t n) -> not_null<T>*;
   template <typename T>
-  constexpr auto operator!=(std::nullptr_t, const not_null<T>& rhs) noexcept -> bool;
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() != std::declval<const U&>())>
-  constexpr auto operator!=(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() != std::declval<const U&>())>
-  constexpr auto operator!=(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() != std::declval<const U&>())>
-  constexpr auto operator!=(const T& lhs, const not_null<U>& rhs) noexcept -> bool;
+  auto check_not_null_range(const T* first, std::size_t n) -> const not_null<T>*;
+  /// \}
 
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() < std::declval<const U&>())>
-  constexpr auto operator<(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() < std::declval<const U&>())>
-  constexpr auto operator<(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() < std::declval<const U&>())>
-  constexpr auto operator<(const T& lhs, const not_null<U>& rhs) noexcept -> bool;
+  /// \{
+  /// \brief Adopts a contiguous range of `n` nullable pointers starting at
+  ///        `first` as a range of `not_null` pointers, *assuming* that none
+  ///        of them are null
+  ///
+  /// This is the unchecked counterpart of `check_not_null_range`. Like
+  /// `assume_not_null`, it is up to the user to guarantee that no element
+  /// of the range is null; otherwise the behavior is undefined.
+  ///
+  /// \param first pointer to the first element of the range
+  /// \param n the number of elements in the range
+  /// \return a pointer to the first element, as a `not_null`
+  template <typename T>
+  auto assume_not_null_range(T* first, std::size_t n) noexcept -> not_null<T>*;
+  template <typename T>
+  auto assume_not_null_range(const T* first, std::size_t n) noexcept -> const not_null<T>*;
+  /// \}
 
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() > std::declval<const U&>())>
-  constexpr auto operator>(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() > std::declval<const U&>())>
-  constexpr auto operator>(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() > std::declval<const U&>())>
-  constexpr auto operator>(const T& lhs, const not_null<U>& rhs) noexcept -> bool;
+  //---------------------------------------------------------------------------
+  // Smart Pointer Factories
+  //---------------------------------------------------------------------------
 
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() <= std::declval<const U&>())>
-  constexpr auto operator<=(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() <= std::declval<const U&>())>
-  constexpr auto operator<=(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
-  template <typename T, typename U,
-            typename = decltype(std::declval<const T&>() <= std::declval<const U&>())>
+  /// \brief Creates a `not_null<std::unique_ptr<T>>` to a `T` constructed
+  ///        from \p args
+  ///
+  /// This is equivalent to `assume_not_null(std::make_unique<T>(args...))`,
+  /// except that it is available in C++11, and it never performs an audit
+  /// check -- since allocations throw rather than return null, the result
+  /// is known to not be null without any check.
+  ///
+  /// ### Examples
+  ///
+  /// Basic use:
+  ///
+  /// ```cpp
+  /// auto p = make_not_null_unique<Widget>("name", 42);
+  ///
+  /// consume(std::move(p));
+  /// ```
+  ///
+  /// \tparam T the type to construct. Must not be an array type
+  /// \param args the arguments to forward to the constructor of `T`
+  /// \return a `not_null` owning the constructed `T`
+  template <typename T, typename...Args>
+  auto make_not_null_unique(Args&&...args) -> not_null<std::unique_ptr<T>>;
+
+  /// \brief Creates a `not_null<std::unique_ptr<T>>` to a default-initialized
+  ///        `T`
+  ///
+  /// Unlike `make_not_null_unique<T>()`, trivial types such as large buffers
+  /// are left uninitialized, rather than being zeroed only to be overwritten.
+  ///
+  /// \tparam T the type to construct. Must not be an array type
+  /// \return a `not_null` owning the constructed `T`
+  template <typename T>
+  auto make_not_null_unique_for_overwrite() -> not_null<std::unique_ptr<T>>;
+
+  /// \brief Creates a `not_null<std::shared_ptr<T>>` to a `T` constructed
+  ///        from \p args
+  ///
+  /// The object and its control block are created with a single allocation,
+  /// as with `std::make_shared`.
+  ///
+  /// ### Examples
+  ///
+  /// Basic use:
+  ///
+  /// ```cpp
+  /// auto p = make_not_null_shared<Widget>("name", 42);
+  ///
+  /// share(p);
+  /// ```
+  ///
+  /// \tparam T the type to construct. Must not be an array type
+  /// \param args the arguments to forward to the constructor of `T`
+  /// \return a `not_null` sharing ownership of the constructed `T`
+  template <typename T, typename...Args>
+  auto make_not_null_shared(Args&&...args) -> not_null<std::shared_ptr<T>>;
+
+  /// \brief Creates a `not_null<std::shared_ptr<T>>` to a default-initialized
+  ///        `T`
+  ///
+  /// \tparam T the type to construct. Must not be an array type
+  /// \return a `not_null` sharing ownership of the constructed `T`
+  template <typename T>
+  auto make_not_null_shared_for_overwrite() -> not_null<std::shared_ptr<T>>;
+
+  /// \brief Creates a `not_null<std::shared_ptr<T>>` to a `T` constructed
+  ///        from \p args, using \p alloc for the allocation
+  ///
+  /// \tparam T the type to construct. Must not be an array type
+  /// \param alloc the allocator to allocate the object and control block with
+  /// \param args the arguments to forward to the constructor of `T`
+  /// \return a `not_null` sharing ownership of the constructed `T`
+  template <typename T, typename Allocator, typename...Args>
+  auto allocate_not_null_shared(const Allocator& alloc, Args&&...args)
+    -> not_null<std::shared_ptr<T>>;
+
+  /// \brief Creates a `not_null<std::shared_ptr<T>>` to a default-initialized
+  ///        `T`, using \p alloc for the allocation
+  ///
+  /// \tparam T the type to construct. Must not be an array type
+  /// \param alloc the allocator to allocate the object and control block with
+  /// \return a `not_null` sharing ownership of the constructed `T`
+  template <typename T, typename Allocator>
+  auto allocate_not_null_shared_for_overwrite(const Allocator& alloc)
+    -> not_null<std::shared_ptr<T>>;
+
+  //---------------------------------------------------------------------------
+  // Comparisons
+  //---------------------------------------------------------------------------
+
+#if defined(NOT_NULL_HAS_THREE_WAY_COMPARISON)
+
+  // C++20 synthesizes the reversed and negated forms of these comparisons, so
+  // only one overload per operand combination is needed, and the constraints
+  // are checked with concepts rather than substitution failures
+
+  template <typename T>
+  constexpr auto operator==(const not_null<T>& lhs, std::nullptr_t) noexcept -> bool;
+  template <typename T, typename U>
+    requires requires(const T& t, const U& u) { t == u; }
+  constexpr auto operator==(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U>
+    requires (!is_not_null<U>::value && !std::is_null_pointer<U>::value) &&
+             requires(const T& t, const U& u) { t == u; }
+  constexpr auto operator==(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
+
+  template <typename T, typename U>
+    requires requires(const T& t, const U& u) { t <=> u; }
+  constexpr auto operator<=>(const not_null<T>& lhs, const not_null<U>& rhs)
+    noexcept -> decltype(std::declval<const T&>() <=> std::declval<const U&>());
+  template <typename T, typename U>
+    requires (!is_not_null<U>::value) &&
+             requires(const T& t, const U& u) { t <=> u; }
+  constexpr auto operator<=>(const not_null<T>& lhs, const U& rhs)
+    noexcept -> decltype(std::declval<const T&>() <=> std::declval<const U&>());
+
+  // Pointers that are ordered but not three-way comparable, such as fancy
+  // pointers written before C++20, fall back to their own relational
+  // operators in the same way that 'std::compare_three_way' does
+
+  template <typename T, typename U>
+    requires (!requires(const T& t, const U& u) { t <=> u; }) &&
+             requires(const T& t, const U& u) { t < u; }
+  constexpr auto operator<(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U>
+    requires (!is_not_null<U>::value) &&
+             (!requires(const T& t, const U& u) { t <=> u; }) &&
+             requires(const T& t, const U& u) { t < u; }
+  constexpr auto operator<(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
+  template <typename T, typename U>
+    requires (!is_not_null<T>::value) &&
+             (!requires(const T& t, const U& u) { u <=> t; }) &&
+             requires(const T& t, const U& u) { t < u; }
+  constexpr auto operator<(const T& lhs, const not_null<U>& rhs) noexcept -> bool;
+
+  template <typename T, typename U>
+    requires (!requires(const T& t, const U& u) { t <=> u; }) &&
+             requires(const T& t, const U& u) { t > u; }
+  constexpr auto operator>(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U>
+    requires (!is_not_null<U>::value) &&
+             (!requires(const T& t, const U& u) { t <=> u; }) &&
+             requires(const T& t, const U& u) { t > u; }
+  constexpr auto operator>(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
+  template <typename T, typename U>
+    requires (!is_not_null<T>::value) &&
+             (!requires(const T& t, const U& u) { u <=> t; }) &&
+             requires(const T& t, const U& u) { t > u; }
+  constexpr auto operator>(const T& lhs, const not_null<U>& rhs) noexcept -> bool;
+
+  template <typename T, typename U>
+    requires (!requires(const T& t, const U& u) { t <=> u; }) &&
+             requires(const T& t, const U& u) { t <= u; }
+  constexpr auto operator<=(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U>
+    requires (!is_not_null<U>::value) &&
+             (!requires(const T& t, const U& u) { t <=> u; }) &&
+             requires(const T& t, const U& u) { t <= u; }
+  constexpr auto operator<=(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
+  template <typename T, typename U>
+    requires (!is_not_null<T>::value) &&
+             (!requires(const T& t, const U& u) { u <=> t; }) &&
+             requires(const T& t, const U& u) { t <= u; }
+  constexpr auto operator<=(const T& lhs, const not_null<U>& rhs) noexcept -> bool;
+
+  template <typename T, typename U>
+    requires (!requires(const T& t, const U& u) { t <=> u; }) &&
+             requires(const T& t, const U& u) { t >= u; }
+  constexpr auto operator>=(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U>
+    requires (!is_not_null<U>::value) &&
+             (!requires(const T& t, const U& u) { t <=> u; }) &&
+             requires(const T& t, const U& u) { t >= u; }
+  constexpr auto operator>=(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
+  template <typename T, typename U>
+    requires (!is_not_null<T>::value) &&
+             (!requires(const T& t, const U& u) { u <=> t; }) &&
+             requires(const T& t, const U& u) { t >= u; }
+  constexpr auto operator>=(const T& lhs, const not_null<U>& rhs) noexcept -> bool;
+
+#else
+
+  template <typename T>
+  constexpr auto operator==(const not_null<T>& lhs, std::nullptr_t) noexcept -> bool;
+  template <typename T>
+  constexpr auto operator==(std::nullptr_t, const not_null<T>& rhs) noexcept -> bool;
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() == std::declval<const U&>())>
+  constexpr auto operator==(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() == std::declval<const U&>())>
+  constexpr auto operator==(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() == std::declval<const U&>())>
+  constexpr auto operator==(const T& lhs, const not_null<U>& rhs) noexcept -> bool;
+
+  template <typename T>
+  constexpr auto operator!=(const not_null<T>& lhs, std::nullptr_t) noexcept -> bool;
+  template <typename T>
+  constexpr auto operator!=(std::nullptr_t, const not_null<T>& rhs) noexcept -> bool;
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() != std::declval<const U&>())>
+  constexpr auto operator!=(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() != std::declval<const U&>())>
+  constexpr auto operator!=(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() != std::declval<const U&>())>
+  constexpr auto operator!=(const T& lhs, const not_null<U>& rhs) noexcept -> bool;
+
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() < std::declval<const U&>())>
+  constexpr auto operator<(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() < std::declval<const U&>())>
+  constexpr auto operator<(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() < std::declval<const U&>())>
+  constexpr auto operator<(const T& lhs, const not_null<U>& rhs) noexcept -> bool;
+
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() > std::declval<const U&>())>
+  constexpr auto operator>(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() > std::declval<const U&>())>
+  constexpr auto operator>(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() > std::declval<const U&>())>
+  constexpr auto operator>(const T& lhs, const not_null<U>& rhs) noexcept -> bool;
+
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() <= std::declval<const U&>())>
+  constexpr auto operator<=(const not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() <= std::declval<const U&>())>
+  constexpr auto operator<=(const not_null<T>& lhs, const U& rhs) noexcept -> bool;
+  template <typename T, typename U,
+            typename = decltype(std::declval<const T&>() <= std::declval<const U&>())>
   constexpr auto operator<=(const T& lhs, const not_null<U>& rhs) noexcept -> bool;
 
   template <typename T, typename U,
@@ -648,6 +1398,8 @@ inline namespace bitwizeshift {
             typename = decltype(std::declval<const T&>() >= std::declval<const U&>())>
   constexpr auto operator>=(const T& lhs, const not_null<U>& rhs) noexcept -> bool;
 
+#endif // defined(NOT_NULL_HAS_THREE_WAY_COMPARISON)
+
 } // inline namespace bitwizeshift
 } // namespace cpp
 
@@ -655,12 +1407,33 @@ inline namespace bitwizeshift {
 
 inline
 NOT_NULL_NS_IMPL::not_null_contract_violation::not_null_contract_violation()
-  : logic_error{
-      "check_not_null invoked with null pointer; "
-      "not_null's contruct has been violated"
-    }
+  noexcept
+  : m_call_site{nullptr, 0u, nullptr}
+{
+
+}
+
+inline
+NOT_NULL_NS_IMPL::not_null_contract_violation::not_null_contract_violation(const not_null_call_site& site)
+  noexcept
+  : m_call_site(site)
+{
+
+}
+
+inline
+auto NOT_NULL_NS_IMPL::not_null_contract_violation::what()
+  const noexcept -> const char*
 {
+  return "check_not_null invoked with null pointer; "
+         "not_null's contract has been violated";
+}
 
+inline
+auto NOT_NULL_NS_IMPL::not_null_contract_violation::call_site()
+  const noexcept -> const not_null_call_site&
+{
+  return m_call_site;
 }
 
 #endif // !defined(NOT_NULL_DISABLE_EXCEPTIONS)
@@ -677,15 +1450,20 @@ auto NOT_NULL_NS_IMPL::detail::not_null_to_address(U* p)
   return p;
 }
 
-inline NOT_NULL_INLINE_VISIBILITY
+template <typename>
 auto NOT_NULL_NS_IMPL::detail::throw_null_pointer_error()
   -> void
 {
+  const auto handler = get_not_null_violation_handler();
+  if (handler != nullptr) {
+    handler(not_null_call_site{nullptr, 0u, nullptr});
+  }
+
 #if defined(NOT_NULL_DISABLE_EXCEPTIONS)
   std::fprintf(
     stderr,
     "check_not_null invoked with null pointer; "
-    "not_null's contruct has been violated"
+    "not_null's contract has been violated\n"
   );
   std::abort();
 #else
@@ -693,32 +1471,444 @@ auto NOT_NULL_NS_IMPL::detail::throw_null_pointer_error()
 #endif
 }
 
-template <typename T>
-inline constexpr NOT_NULL_INLINE_VISIBILITY
-auto NOT_NULL_NS_IMPL::detail::mark_nonnull(T* p) noexcept -> T*
+template <typename>
+auto NOT_NULL_NS_IMPL::detail::throw_null_pointer_error(const char* file,
+                                                        unsigned line,
+                                                        const char* function)
+  -> void
+{
+  const auto site = not_null_call_site{file, line, function};
+
+  const auto handler = get_not_null_violation_handler();
+  if (handler != nullptr) {
+    handler(site);
+  }
+
+#if defined(NOT_NULL_DISABLE_EXCEPTIONS)
+  std::fprintf(
+    stderr,
+    "%s:%u: %s: check_not_null invoked with null pointer; "
+    "not_null's contract has been violated\n",
+    (file != nullptr) ? file : "<unknown>",
+    line,
+    (function != nullptr) ? function : "<unknown>"
+  );
+  std::abort();
+#else
+  throw not_null_contract_violation{site};
+#endif
+}
+
+#if defined(NOT_NULL_AUDIT_SAMPLING)
+
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::audit_sample_due()
+  noexcept -> bool
+{
+  // Constant-initialized, so this does not need a thread-local guard
+  static thread_local unsigned s_countdown = (NOT_NULL_AUDIT_SAMPLING);
+
+  if (NOT_NULL_UNLIKELY(--s_countdown == 0u)) {
+    s_countdown = (NOT_NULL_AUDIT_SAMPLING);
+    return true;
+  }
+  return false;
+}
+
+template <typename>
+auto NOT_NULL_NS_IMPL::detail::audit_null_pointer_error()
+  noexcept -> void
+{
+  const auto handler = get_not_null_violation_handler();
+  if (handler != nullptr) {
+    handler(not_null_call_site{nullptr, 0u, nullptr});
+  }
+
+  std::fprintf(
+    stderr,
+    "assume_not_null invoked with null pointer (detected by audit sampling); "
+    "not_null's contract has been violated\n"
+  );
+  std::abort();
+}
+
+#endif // defined(NOT_NULL_AUDIT_SAMPLING)
+
+inline
+auto NOT_NULL_NS_IMPL::detail::violation_handler_storage()
+  noexcept -> violation_handler_cell&
+{
+  // Constant-initialized, so this is safe to use during static
+  // initialization and destruction
+  static violation_handler_cell s_handler{nullptr};
+
+  return s_handler;
+}
+
+#if defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+
+//-----------------------------------------------------------------------------
+// class : check_counter_table
+//-----------------------------------------------------------------------------
+
+inline
+NOT_NULL_NS_IMPL::detail::check_counter_table::check_counter_table()
+  noexcept
+{
+  for (auto& s : m_slots) {
+    s.file.store(nullptr, std::memory_order_relaxed);
+    s.line.store(0u, std::memory_order_relaxed);
+    s.function.store(nullptr, std::memory_order_relaxed);
+    s.checks.store(0u, std::memory_order_relaxed);
+    s.failures.store(0u, std::memory_order_relaxed);
+  }
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::check_counter_table::record(const char* file,
+                                                           unsigned line,
+                                                           const char* function,
+                                                           bool failed)
+  noexcept -> void
+{
+  const auto mask = capacity - 1u;
+  const auto hash = (reinterpret_cast<std::size_t>(file) >> 3u) ^
+                    (static_cast<std::size_t>(line) * 2654435761u);
+
+  // The last slot is reserved for checks with an unknown location. Those
+  // made without a call site must not be hashed, since a null file marks an
+  // unclaimed slot, and the next call site to probe it would take over
+  // their counts.
+  auto* target = &m_slots[capacity - 1u];
+  for (auto i = std::size_t{0u}; file != nullptr && i < capacity - 1u; ++i) {
+    auto& s = m_slots[(hash + i) & mask];
+    if (&s == &m_slots[capacity - 1u]) {
+      continue;
+    }
+    const auto* const slot_file = s.file.load(std::memory_order_relaxed);
+    if (slot_file == nullptr) {
+      // Only this thread writes to this table, so the slot can be claimed
+      // without a compare-exchange. The file is published last, so that a
+      // reader never observes a partially-claimed slot.
+      s.line.store(line, std::memory_order_relaxed);
+      s.function.store(function, std::memory_order_relaxed);
+      s.file.store(file, std::memory_order_release);
+      target = &s;
+      break;
+    }
+    if (slot_file == file && s.line.load(std::memory_order_relaxed) == line) {
+      target = &s;
+      break;
+    }
+  }
+
+  target->checks.store(
+    target->checks.load(std::memory_order_relaxed) + 1u,
+    std::memory_order_relaxed
+  );
+  if (failed) {
+    target->failures.store(
+      target->failures.load(std::memory_order_relaxed) + 1u,
+      std::memory_order_relaxed
+    );
+  }
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::check_counter_table::collect(std::vector<not_null_check_counts>& out)
+  const -> void
+{
+  for (auto i = std::size_t{0u}; i < capacity; ++i) {
+    const auto& s = m_slots[i];
+    const auto checks = s.checks.load(std::memory_order_relaxed);
+    if (checks == 0u) {
+      continue;
+    }
+    const auto* const file = s.file.load(std::memory_order_acquire);
+
+    out.push_back(not_null_check_counts{
+      not_null_call_site{
+        file,
+        (file != nullptr) ? s.line.load(std::memory_order_relaxed) : 0u,
+        (file != nullptr) ? s.function.load(std::memory_order_relaxed) : nullptr
+      },
+      checks,
+      s.failures.load(std::memory_order_relaxed)
+    });
+  }
+}
+
+//-----------------------------------------------------------------------------
+// class : check_counter_registry
+//-----------------------------------------------------------------------------
+
+inline
+auto NOT_NULL_NS_IMPL::detail::check_counter_registry::instance()
+  -> check_counter_registry&
+{
+  static check_counter_registry s_registry;
+
+  return s_registry;
+}
+
+//-----------------------------------------------------------------------------
+// class : thread_check_counters
+//-----------------------------------------------------------------------------
+
+inline
+NOT_NULL_NS_IMPL::detail::thread_check_counters::thread_check_counters()
+{
+  auto& registry = check_counter_registry::instance();
+  const std::lock_guard<std::mutex> lock{registry.mutex};
+
+  registry.live.push_back(&table);
+}
+
+inline
+NOT_NULL_NS_IMPL::detail::thread_check_counters::~thread_check_counters()
+{
+  auto& registry = check_counter_registry::instance();
+  const std::lock_guard<std::mutex> lock{registry.mutex};
+
+  table.collect(registry.retired);
+  registry.live.erase(
+    std::find(registry.live.begin(), registry.live.end(), &table)
+  );
+}
+
+//-----------------------------------------------------------------------------
+
+inline
+auto NOT_NULL_NS_IMPL::detail::record_check(const char* file,
+                                            unsigned line,
+                                            const char* function,
+                                            bool failed)
+  noexcept -> void
+{
+  static thread_local thread_check_counters s_counters{};
+
+  s_counters.table.record(file, line, function, failed);
+}
+
+#endif // defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+
+//=============================================================================
+// utilities : violation handler
+//=============================================================================
+
+inline
+auto NOT_NULL_NS_IMPL::set_not_null_violation_handler(not_null_violation_handler handler)
+  noexcept -> not_null_violation_handler
+{
+#if defined(__clang__) || defined(__GNUC__)
+  return __atomic_exchange_n(
+    &detail::violation_handler_storage(),
+    handler,
+    __ATOMIC_ACQ_REL
+  );
+#else
+  return detail::violation_handler_storage().exchange(handler, std::memory_order_acq_rel);
+#endif
+}
+
+inline
+auto NOT_NULL_NS_IMPL::get_not_null_violation_handler()
+  noexcept -> not_null_violation_handler
+{
+#if defined(__clang__) || defined(__GNUC__)
+  return __atomic_load_n(&detail::violation_handler_storage(), __ATOMIC_ACQUIRE);
+#else
+  return detail::violation_handler_storage().load(std::memory_order_acquire);
+#endif
+}
+
+#if defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+
+//=============================================================================
+// utilities : check counters
+//=============================================================================
+
+inline
+auto NOT_NULL_NS_IMPL::collect_not_null_check_counts()
+  -> std::vector<not_null_check_counts>
+{
+  auto counts = std::vector<not_null_check_counts>{};
+  {
+    auto& registry = detail::check_counter_registry::instance();
+    const std::lock_guard<std::mutex> lock{registry.mutex};
+
+    counts = registry.retired;
+    for (const auto* table : registry.live) {
+      table->collect(counts);
+    }
+  }
+
+  // The same call site appears once per thread, and a file name may have a
+  // different address in each translation unit, so merge by value
+  const auto less = [](const not_null_check_counts& lhs,
+                       const not_null_check_counts& rhs) -> bool {
+    if (lhs.site.file == nullptr || rhs.site.file == nullptr) {
+      return (lhs.site.file == nullptr) && (rhs.site.file != nullptr);
+    }
+    const auto compare = std::strcmp(lhs.site.file, rhs.site.file);
+    return (compare < 0) || ((compare == 0) && (lhs.site.line < rhs.site.line));
+  };
+  std::sort(counts.begin(), counts.end(), less);
+
+  auto merged = std::vector<not_null_check_counts>{};
+  for (const auto& c : counts) {
+    if (!merged.empty() && !less(merged.back(), c) && !less(c, merged.back())) {
+      merged.back().checks += c.checks;
+      merged.back().failures += c.failures;
+    } else {
+      merged.push_back(c);
+    }
+  }
+  return merged;
+}
+
+inline
+auto NOT_NULL_NS_IMPL::dump_not_null_check_counts(std::FILE* out)
+  -> void
+{
+  for (const auto& c : collect_not_null_check_counts()) {
+    std::fprintf(
+      out,
+      "%s:%u: %s: %llu checks, %llu failures\n",
+      (c.site.file != nullptr) ? c.site.file : "<unknown>",
+      c.site.line,
+      (c.site.function != nullptr) ? c.site.function : "<unknown>",
+      static_cast<unsigned long long>(c.checks),
+      static_cast<unsigned long long>(c.failures)
+    );
+  }
+}
+
+#endif // defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+
+template <typename T>
+inline
+auto NOT_NULL_NS_IMPL::detail::contains_null(const T* first, std::size_t n)
+  noexcept -> bool
+{
+  return contains_null(first, n, std::is_pointer<T>{});
+}
+
+template <typename T>
+inline
+auto NOT_NULL_NS_IMPL::detail::contains_null(T* const* first,
+                                             std::size_t n,
+                                             std::true_type)
+  noexcept -> bool
+{
+  return find_null(first, n) != n;
+}
+
+template <typename T>
+inline
+auto NOT_NULL_NS_IMPL::detail::contains_null(const T* first,
+                                             std::size_t n,
+                                             std::false_type)
+  noexcept -> bool
+{
+  auto nulls = false;
+  for (auto i = std::size_t{0u}; i < n; ++i) {
+    nulls |= (first[i] == nullptr);
+  }
+  return nulls;
+}
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::mark_nonnull(T* p) noexcept -> T*
+{
+  // 'gnu::returns_nonnull' is lost once this function is inlined, so the
+  // assumption is additionally made here to keep the hint visible at the
+  // call site
+  return (NOT_NULL_ASSUME(p != nullptr), p);
+}
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::assume_nonnull_if_raw(T* const& p)
+  noexcept -> T* const&
+{
+  return (NOT_NULL_ASSUME(p != nullptr), p);
+}
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::assume_nonnull_if_raw(const T& p)
+  noexcept -> const T&
+{
+  return p;
+}
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::not_null_factory::make(T&& p)
+  -> not_null<typename std::decay<T>::type>
+{
+  using value_type = typename std::decay<T>::type;
+
+  return not_null<value_type>{
+    typename not_null<value_type>::ctor_tag{},
+    not_null_forward<T>(p)
+  };
+}
+
+#if !defined(__cpp_lib_smart_ptr_for_overwrite)
+
+//=============================================================================
+// class : default_init_allocator
+//=============================================================================
+
+template <typename A>
+inline
+NOT_NULL_NS_IMPL::detail::default_init_allocator<A>::default_init_allocator(const A& alloc)
+  noexcept
+  : A(alloc)
+{
+
+}
+
+template <typename A>
+template <typename U>
+inline
+NOT_NULL_NS_IMPL::detail::default_init_allocator<A>::default_init_allocator(const default_init_allocator<U>& other)
+  noexcept
+  : A(static_cast<const U&>(other))
+{
+
+}
+
+template <typename A>
+template <typename U>
+inline
+auto NOT_NULL_NS_IMPL::detail::default_init_allocator<A>::construct(U* p)
+  noexcept(std::is_nothrow_default_constructible<U>::value) -> void
 {
-#if defined(_MSC_VER)
-  // use Microsoft's builtin '__assume' to hint to the compiler that p
-  // cannot be null
-  return (__assume(p != nullptr), p);
-#else
-  return p; // nullability is confirmed with gnu::returns_nonnull
-#endif
+  ::new (static_cast<void*>(p)) U;
 }
 
-template <typename T>
-inline constexpr NOT_NULL_INLINE_VISIBILITY
-auto NOT_NULL_NS_IMPL::detail::not_null_factory::make(T&& p)
-  -> not_null<typename std::decay<T>::type>
+template <typename A>
+template <typename U, typename Arg0, typename...Args>
+inline
+auto NOT_NULL_NS_IMPL::detail::default_init_allocator<A>::construct(U* p,
+                                                                    Arg0&& arg0,
+                                                                    Args&&...args)
+  -> void
 {
-  using value_type = typename std::decay<T>::type;
-
-  return not_null<value_type>{
-    typename not_null<value_type>::ctor_tag{},
-    not_null_forward<T>(p)
-  };
+  traits::construct(
+    static_cast<A&>(*this),
+    p,
+    std::forward<Arg0>(arg0),
+    std::forward<Args>(args)...
+  );
 }
 
+#endif // !defined(__cpp_lib_smart_ptr_for_overwrite)
+
 //=============================================================================
 // class : not_null
 //=============================================================================
@@ -730,6 +1920,7 @@ auto NOT_NULL_NS_IMPL::detail::not_null_factory::make(T&& p)
 template <typename T>
 template <typename U,
           typename std::enable_if<NOT_NULL_NS_IMPL::detail::not_null_is_implicit_convertible<T,const U&>::value,int>::type>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
 NOT_NULL_NS_IMPL::not_null<T>::not_null(const not_null<U>& other)
   noexcept(std::is_nothrow_constructible<T,const U&>::value)
   : m_pointer(other.as_nullable())
@@ -740,6 +1931,7 @@ NOT_NULL_NS_IMPL::not_null<T>::not_null(const not_null<U>& other)
 template <typename T>
 template <typename U,
           typename std::enable_if<NOT_NULL_NS_IMPL::detail::not_null_is_explicit_convertible<T,const U&>::value,int>::type>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
 NOT_NULL_NS_IMPL::not_null<T>::not_null(const not_null<U>& other)
   noexcept(std::is_nothrow_constructible<T,const U&>::value)
   : m_pointer(other.as_nullable())
@@ -750,9 +1942,10 @@ NOT_NULL_NS_IMPL::not_null<T>::not_null(const not_null<U>& other)
 template <typename T>
 template <typename U,
           typename std::enable_if<NOT_NULL_NS_IMPL::detail::not_null_is_implicit_convertible<T,U&&>::value,int>::type>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
 NOT_NULL_NS_IMPL::not_null<T>::not_null(not_null<U>&& other)
   noexcept(std::is_nothrow_constructible<T,U&&>::value)
-  : m_pointer(static_cast<not_null<U>&&>(other).as_nullable())
+  : m_pointer(static_cast<U&&>(other.m_pointer))
 {
 
 }
@@ -760,9 +1953,10 @@ NOT_NULL_NS_IMPL::not_null<T>::not_null(not_null<U>&& other)
 template <typename T>
 template <typename U,
           typename std::enable_if<NOT_NULL_NS_IMPL::detail::not_null_is_explicit_convertible<T,U&&>::value,int>::type>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
 NOT_NULL_NS_IMPL::not_null<T>::not_null(not_null<U>&& other)
   noexcept(std::is_nothrow_constructible<T,U&&>::value)
-  : m_pointer(static_cast<not_null<U>&&>(other).as_nullable())
+  : m_pointer(static_cast<U&&>(other.m_pointer))
 {
 
 }
@@ -816,7 +2010,10 @@ inline constexpr NOT_NULL_INLINE_VISIBILITY
 auto NOT_NULL_NS_IMPL::not_null<T>::as_nullable()
   const & noexcept -> const T&
 {
-  return m_pointer;
+  // A raw pointer extracted from a not_null is still known to not be null,
+  // so that checks by the caller are removed. This cannot be assumed of a
+  // smart pointer, which may have been moved from.
+  return detail::assume_nonnull_if_raw(m_pointer);
 }
 
 template<typename T>
@@ -824,7 +2021,10 @@ inline NOT_NULL_CPP14_CONSTEXPR NOT_NULL_INLINE_VISIBILITY
 auto NOT_NULL_NS_IMPL::not_null<T>::as_nullable()
   && noexcept -> T&&
 {
-  return static_cast<T&&>(m_pointer);
+  return (
+    static_cast<void>(detail::assume_nonnull_if_raw(m_pointer)),
+    static_cast<T&&>(m_pointer)
+  );
 }
 
 //-----------------------------------------------------------------------------
@@ -884,13 +2084,52 @@ NOT_NULL_NS_IMPL::not_null<T>::not_null(ctor_tag, P&& ptr)
 # pragma GCC diagnostic ignored "-Wunused-value"
 #endif // defined(__GNUC__)
 
+#if defined(NOT_NULL_HAS_BUILTIN_CALL_SITE)
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::check_not_null(T&& ptr,
+                                      const char* file,
+                                      unsigned line,
+                                      const char* function)
+  -> not_null<typename std::decay<T>::type>
+{
+  return check_not_null(
+    detail::not_null_forward<T>(ptr),
+    not_null_call_site{file, line, function}
+  );
+}
+#else
 template <typename T>
 inline constexpr NOT_NULL_INLINE_VISIBILITY
 auto NOT_NULL_NS_IMPL::check_not_null(T&& ptr)
   -> not_null<typename std::decay<T>::type>
 {
-  return (ptr != nullptr || (detail::throw_null_pointer_error(), true)),
-    assume_not_null(detail::not_null_forward<T>(ptr));
+#if defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+  return (NOT_NULL_IS_CONSTANT_EVALUATED() ||
+          (detail::record_check(nullptr, 0u, nullptr, ptr == nullptr), true)),
+    (NOT_NULL_LIKELY(ptr != nullptr) || (detail::throw_null_pointer_error(), true)),
+    detail::not_null_factory::make(detail::not_null_forward<T>(ptr));
+#else
+  return (NOT_NULL_LIKELY(ptr != nullptr) || (detail::throw_null_pointer_error(), true)),
+    detail::not_null_factory::make(detail::not_null_forward<T>(ptr));
+#endif
+}
+#endif
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::check_not_null(T&& ptr, const not_null_call_site& site)
+  -> not_null<typename std::decay<T>::type>
+{
+#if defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+  return (NOT_NULL_IS_CONSTANT_EVALUATED() ||
+          (detail::record_check(site.file, site.line, site.function, ptr == nullptr), true)),
+    (NOT_NULL_LIKELY(ptr != nullptr) || (detail::throw_null_pointer_error(site.file, site.line, site.function), true)),
+    detail::not_null_factory::make(detail::not_null_forward<T>(ptr));
+#else
+  return (NOT_NULL_LIKELY(ptr != nullptr) || (detail::throw_null_pointer_error(site.file, site.line, site.function), true)),
+    detail::not_null_factory::make(detail::not_null_forward<T>(ptr));
+#endif
 }
 
 #if defined(__clang__)
@@ -905,13 +2144,398 @@ auto NOT_NULL_NS_IMPL::assume_not_null(T&& ptr)
   noexcept(std::is_nothrow_constructible<typename std::decay<T>::type,T>::value)
   -> not_null<typename std::decay<T>::type>
 {
+#if defined(NOT_NULL_AUDIT_SAMPLING)
+  return (NOT_NULL_IS_CONSTANT_EVALUATED() ||
+          !detail::audit_sample_due() ||
+          ptr != nullptr ||
+          (detail::audit_null_pointer_error(), true)),
+    detail::not_null_factory::make(detail::not_null_forward<T>(ptr));
+#else
   return detail::not_null_factory::make(detail::not_null_forward<T>(ptr));
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Bulk Utilities
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline
+auto NOT_NULL_NS_IMPL::find_null(T* const* first, std::size_t n)
+  noexcept -> std::size_t
+{
+  // The size of each block is a tradeoff between the number of branches
+  // taken and the amount of work wasted past the first null. 32 pointers
+  // is a few cache lines, and a whole number of vectors on current hardware.
+  const auto block_size = std::size_t{32u};
+
+  auto i = std::size_t{0u};
+  for (; n - i >= block_size; i += block_size) {
+    const auto* const block = first + i;
+
+    // Deliberately accumulated without branching so that this vectorizes
+    auto nulls = std::size_t{0u};
+    for (auto j = std::size_t{0u}; j < block_size; ++j) {
+      nulls |= static_cast<std::size_t>(block[j] == nullptr);
+    }
+    if (nulls != 0u) {
+      break;
+    }
+  }
+  for (; i < n; ++i) {
+    if (first[i] == nullptr) {
+      return i;
+    }
+  }
+  return n;
+}
+
+template <typename T>
+inline
+auto NOT_NULL_NS_IMPL::check_all_not_null(T* const* first, std::size_t n)
+  -> void
+{
+  if (NOT_NULL_UNLIKELY(find_null(first, n) != n)) {
+    detail::throw_null_pointer_error();
+  }
+}
+
+template <typename T>
+inline
+auto NOT_NULL_NS_IMPL::check_not_null_range(T* first, std::size_t n)
+  -> not_null<T>*
+{
+  if (NOT_NULL_UNLIKELY(detail::contains_null(first, n))) {
+    detail::throw_null_pointer_error();
+  }
+
+  return assume_not_null_range(first, n);
+}
+
+template <typename T>
+inline
+auto NOT_NULL_NS_IMPL::check_not_null_range(const T* first, std::size_t n)
+  -> const not_null<T>*
+{
+  if (NOT_NULL_UNLIKELY(detail::contains_null(first, n))) {
+    detail::throw_null_pointer_error();
+  }
+
+  return assume_not_null_range(first, n);
+}
+
+template <typename T>
+inline
+auto NOT_NULL_NS_IMPL::assume_not_null_range(T* first, std::size_t)
+  noexcept -> not_null<T>*
+{
+  static_assert(
+    sizeof(not_null<T>) == sizeof(T) && alignof(not_null<T>) == alignof(T),
+    "not_null<T> must have the same size and alignment as T"
+  );
+  static_assert(
+    std::is_standard_layout<not_null<T>>::value == std::is_standard_layout<T>::value,
+    "not_null<T> must be standard-layout if T is"
+  );
+
+  // not_null<T> has the same layout as its only member, 'T', so an array of
+  // 'T' can be viewed as an array of 'not_null<T>'
+  return reinterpret_cast<not_null<T>*>(first);
+}
+
+template <typename T>
+inline
+auto NOT_NULL_NS_IMPL::assume_not_null_range(const T* first, std::size_t n)
+  noexcept -> const not_null<T>*
+{
+  return assume_not_null_range(const_cast<T*>(first), n);
+}
+
+//-----------------------------------------------------------------------------
+// Smart Pointer Factories
+//-----------------------------------------------------------------------------
+
+template <typename T, typename...Args>
+inline
+auto NOT_NULL_NS_IMPL::make_not_null_unique(Args&&...args)
+  -> not_null<std::unique_ptr<T>>
+{
+  static_assert(
+    !std::is_array<T>::value,
+    "make_not_null_unique<T[]> is ill-formed. "
+    "not_null does not support array pointers."
+  );
+
+  return detail::not_null_factory::make(
+    std::unique_ptr<T>(new T(std::forward<Args>(args)...))
+  );
+}
+
+template <typename T>
+inline
+auto NOT_NULL_NS_IMPL::make_not_null_unique_for_overwrite()
+  -> not_null<std::unique_ptr<T>>
+{
+  static_assert(
+    !std::is_array<T>::value,
+    "make_not_null_unique_for_overwrite<T[]> is ill-formed. "
+    "not_null does not support array pointers."
+  );
+
+  return detail::not_null_factory::make(std::unique_ptr<T>(new T));
+}
+
+template <typename T, typename...Args>
+inline
+auto NOT_NULL_NS_IMPL::make_not_null_shared(Args&&...args)
+  -> not_null<std::shared_ptr<T>>
+{
+  static_assert(
+    !std::is_array<T>::value,
+    "make_not_null_shared<T[]> is ill-formed. "
+    "not_null does not support array pointers."
+  );
+
+  return detail::not_null_factory::make(
+    std::make_shared<T>(std::forward<Args>(args)...)
+  );
+}
+
+template <typename T>
+inline
+auto NOT_NULL_NS_IMPL::make_not_null_shared_for_overwrite()
+  -> not_null<std::shared_ptr<T>>
+{
+  using value_type = typename std::remove_cv<T>::type;
+
+  return allocate_not_null_shared_for_overwrite<T>(std::allocator<value_type>{});
+}
+
+template <typename T, typename Allocator, typename...Args>
+inline
+auto NOT_NULL_NS_IMPL::allocate_not_null_shared(const Allocator& alloc,
+                                                Args&&...args)
+  -> not_null<std::shared_ptr<T>>
+{
+  static_assert(
+    !std::is_array<T>::value,
+    "allocate_not_null_shared<T[]> is ill-formed. "
+    "not_null does not support array pointers."
+  );
+
+  return detail::not_null_factory::make(
+    std::allocate_shared<T>(alloc, std::forward<Args>(args)...)
+  );
+}
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::allocate_not_null_shared_for_overwrite(const Allocator& alloc)
+  -> not_null<std::shared_ptr<T>>
+{
+  static_assert(
+    !std::is_array<T>::value,
+    "allocate_not_null_shared_for_overwrite<T[]> is ill-formed. "
+    "not_null does not support array pointers."
+  );
+
+#if defined(__cpp_lib_smart_ptr_for_overwrite)
+  return detail::not_null_factory::make(
+    std::allocate_shared_for_overwrite<T>(alloc)
+  );
+#else
+  using allocator_type = detail::default_init_allocator<Allocator>;
+
+  return detail::not_null_factory::make(
+    std::allocate_shared<T>(allocator_type{alloc})
+  );
+#endif
 }
 
 //-----------------------------------------------------------------------------
 // Comparisons
 //-----------------------------------------------------------------------------
 
+#if defined(NOT_NULL_HAS_THREE_WAY_COMPARISON)
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator==(const not_null<T>&, std::nullptr_t)
+  noexcept -> bool
+{
+  return false;
+}
+
+template <typename T, typename U>
+  requires requires(const T& t, const U& u) { t == u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator==(const not_null<T>& lhs, const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() == rhs.as_nullable();
+}
+
+template <typename T, typename U>
+  requires (!NOT_NULL_NS_IMPL::is_not_null<U>::value && !std::is_null_pointer<U>::value) &&
+           requires(const T& t, const U& u) { t == u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator==(const not_null<T>& lhs, const U& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() == rhs;
+}
+
+template <typename T, typename U>
+  requires requires(const T& t, const U& u) { t <=> u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator<=>(const not_null<T>& lhs, const not_null<U>& rhs)
+  noexcept -> decltype(std::declval<const T&>() <=> std::declval<const U&>())
+{
+  return lhs.as_nullable() <=> rhs.as_nullable();
+}
+
+template <typename T, typename U>
+  requires (!NOT_NULL_NS_IMPL::is_not_null<U>::value) &&
+           requires(const T& t, const U& u) { t <=> u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator<=>(const not_null<T>& lhs, const U& rhs)
+  noexcept -> decltype(std::declval<const T&>() <=> std::declval<const U&>())
+{
+  return lhs.as_nullable() <=> rhs;
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T, typename U>
+  requires (!requires(const T& t, const U& u) { t <=> u; }) &&
+           requires(const T& t, const U& u) { t < u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator<(const not_null<T>& lhs, const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() < rhs.as_nullable();
+}
+
+template <typename T, typename U>
+  requires (!NOT_NULL_NS_IMPL::is_not_null<U>::value) &&
+           (!requires(const T& t, const U& u) { t <=> u; }) &&
+           requires(const T& t, const U& u) { t < u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator<(const not_null<T>& lhs, const U& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() < rhs;
+}
+
+template <typename T, typename U>
+  requires (!NOT_NULL_NS_IMPL::is_not_null<T>::value) &&
+           (!requires(const T& t, const U& u) { u <=> t; }) &&
+           requires(const T& t, const U& u) { t < u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator<(const T& lhs, const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs < rhs.as_nullable();
+}
+
+template <typename T, typename U>
+  requires (!requires(const T& t, const U& u) { t <=> u; }) &&
+           requires(const T& t, const U& u) { t > u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator>(const not_null<T>& lhs, const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() > rhs.as_nullable();
+}
+
+template <typename T, typename U>
+  requires (!NOT_NULL_NS_IMPL::is_not_null<U>::value) &&
+           (!requires(const T& t, const U& u) { t <=> u; }) &&
+           requires(const T& t, const U& u) { t > u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator>(const not_null<T>& lhs, const U& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() > rhs;
+}
+
+template <typename T, typename U>
+  requires (!NOT_NULL_NS_IMPL::is_not_null<T>::value) &&
+           (!requires(const T& t, const U& u) { u <=> t; }) &&
+           requires(const T& t, const U& u) { t > u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator>(const T& lhs, const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs > rhs.as_nullable();
+}
+
+template <typename T, typename U>
+  requires (!requires(const T& t, const U& u) { t <=> u; }) &&
+           requires(const T& t, const U& u) { t <= u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator<=(const not_null<T>& lhs, const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() <= rhs.as_nullable();
+}
+
+template <typename T, typename U>
+  requires (!NOT_NULL_NS_IMPL::is_not_null<U>::value) &&
+           (!requires(const T& t, const U& u) { t <=> u; }) &&
+           requires(const T& t, const U& u) { t <= u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator<=(const not_null<T>& lhs, const U& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() <= rhs;
+}
+
+template <typename T, typename U>
+  requires (!NOT_NULL_NS_IMPL::is_not_null<T>::value) &&
+           (!requires(const T& t, const U& u) { u <=> t; }) &&
+           requires(const T& t, const U& u) { t <= u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator<=(const T& lhs, const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs <= rhs.as_nullable();
+}
+
+template <typename T, typename U>
+  requires (!requires(const T& t, const U& u) { t <=> u; }) &&
+           requires(const T& t, const U& u) { t >= u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator>=(const not_null<T>& lhs, const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() >= rhs.as_nullable();
+}
+
+template <typename T, typename U>
+  requires (!NOT_NULL_NS_IMPL::is_not_null<U>::value) &&
+           (!requires(const T& t, const U& u) { t <=> u; }) &&
+           requires(const T& t, const U& u) { t >= u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator>=(const not_null<T>& lhs, const U& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() >= rhs;
+}
+
+template <typename T, typename U>
+  requires (!NOT_NULL_NS_IMPL::is_not_null<T>::value) &&
+           (!requires(const T& t, const U& u) { u <=> t; }) &&
+           requires(const T& t, const U& u) { t >= u; }
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator>=(const T& lhs, const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs >= rhs.as_nullable();
+}
+
+#else
+
 template <typename T>
 inline constexpr NOT_NULL_INLINE_VISIBILITY
 auto NOT_NULL_NS_IMPL::operator==(const not_null<T>&, std::nullptr_t)
@@ -1088,4 +2712,6 @@ auto NOT_NULL_NS_IMPL::operator>=(const T& lhs, const not_null<U>& rhs)
   return lhs >= rhs.as_nullable();
 }
 
+#endif // defined(NOT_NULL_HAS_THREE_WAY_COMPARISON)
+
 #endif /* CPP_BITWIZESHIFT_NOT_NULL_HPP */
@@ -0,0 +1,462 @@
+/*****************************************************************************
+ * \file not_null_function_ref.hpp
+ *
+ * \brief This header defines non-nullable references to callables, and a
+ *        not_null adaptor for std::function
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2019 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CPP_BITWIZESHIFT_NOT_NULL_FUNCTION_REF_HPP
+#define CPP_BITWIZESHIFT_NOT_NULL_FUNCTION_REF_HPP
+
+#include "not_null.hpp"
+
+#include <functional>  // std::function
+#include <memory>      // std::addressof
+#include <type_traits> // std::enable_if, std::is_function
+#include <utility>     // std::forward, std::move
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+  template <typename Signature>
+  class not_null_function_ref;
+
+  namespace detail {
+
+    template <typename T, typename R>
+    struct function_ref_is_void_or_convertible
+      : std::is_convertible<T,R>{};
+
+    template <typename T>
+    struct function_ref_is_void_or_convertible<T,void>
+      : std::true_type{};
+
+    /// \brief Determines whether an lvalue of \p F may be called with
+    ///        \p Args, and the result converted to \p R
+    template <typename F, typename R, typename Args, typename = void>
+    struct function_ref_is_invocable : std::false_type{};
+
+    template <typename F, typename R, typename...Args>
+    struct function_ref_is_invocable<F, R, void(Args...),
+      typename std::enable_if<true,decltype(std::declval<F&>()(std::declval<Args>()...), void())>::type
+    > : function_ref_is_void_or_convertible<
+          decltype(std::declval<F&>()(std::declval<Args>()...)), R
+        >{};
+
+  } // namespace detail
+
+  //===========================================================================
+  // class : not_null_function_ref
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief A non-owning reference to a callable, which is never empty
+  ///
+  /// A `not_null_function_ref` is two words: a pointer to the referenced
+  /// callable, and a pointer to a function that invokes it. Unlike
+  /// `std::function`, it never allocates, is trivially copyable, and calling
+  /// it performs no check for emptiness, since there is no way to construct
+  /// an empty `not_null_function_ref`.
+  ///
+  /// The referenced callable must outlive every call made through the
+  /// reference. This makes `not_null_function_ref` best suited to function
+  /// parameters, in place of a `const std::function&` or a template.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// auto for_each_widget(cpp::not_null_function_ref<void(widget&)> f) -> void
+  /// {
+  ///   for (auto& w : g_widgets) {
+  ///     f(w);
+  ///   }
+  /// }
+  ///
+  /// for_each_widget([&](widget& w){ w.draw(canvas); });
+  /// ```
+  ///
+  /// \tparam Signature the function signature, e.g. `R(Args...)`
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename R, typename...Args>
+  class not_null_function_ref<R(Args...)>
+  {
+    //-------------------------------------------------------------------------
+    // Public Member Types
+    //-------------------------------------------------------------------------
+  public:
+
+    using result_type = R;
+
+    //-------------------------------------------------------------------------
+    // Constructors / Assignment
+    //-------------------------------------------------------------------------
+  public:
+
+    // not_null_function_ref is not default-constructible, since it must
+    // refer to something
+    not_null_function_ref() = delete;
+
+    /// \brief Constructs a reference to the callable \p fn
+    ///
+    /// \note This only participates in overload resolution if an lvalue of
+    ///       `F` can be called with `Args...`, and the result is convertible
+    ///       to `R`. Function pointers, which may be null, must instead be
+    ///       passed as a `not_null`
+    ///
+    /// \param fn the callable to refer to
+    template <typename F,
+              typename = typename std::enable_if<
+                !std::is_same<typename std::decay<F>::type,not_null_function_ref>::value &&
+                !std::is_function<typename std::remove_reference<F>::type>::value &&
+                !std::is_pointer<typename std::decay<F>::type>::value &&
+                detail::function_ref_is_invocable<typename std::remove_reference<F>::type,R,void(Args...)>::value
+              >::type>
+    not_null_function_ref(F&& fn) noexcept;
+
+    /// \brief Constructs a reference to the function \p fn
+    ///
+    /// \param fn the function to refer to
+    template <typename FR, typename...FArgs,
+              typename = typename std::enable_if<
+                detail::function_ref_is_invocable<FR(FArgs...),R,void(Args...)>::value
+              >::type>
+    not_null_function_ref(FR(&fn)(FArgs...)) noexcept;
+
+    /// \brief Constructs a reference to the function pointed to by \p fn
+    ///
+    /// \param fn the function to refer to
+    template <typename FR, typename...FArgs,
+              typename = typename std::enable_if<
+                detail::function_ref_is_invocable<FR(FArgs...),R,void(Args...)>::value
+              >::type>
+    not_null_function_ref(not_null<FR(*)(FArgs...)> fn) noexcept;
+
+    not_null_function_ref(const not_null_function_ref& other) = default;
+
+    //-------------------------------------------------------------------------
+
+    auto operator=(const not_null_function_ref& other)
+      -> not_null_function_ref& = default;
+
+    //-------------------------------------------------------------------------
+    // Observers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Invokes the referenced callable with \p args
+    ///
+    /// \param args the arguments to forward
+    /// \return the result of the call
+    auto operator()(Args...args) const -> R;
+
+    //-------------------------------------------------------------------------
+    // Private Member Types
+    //-------------------------------------------------------------------------
+  private:
+
+    // Function pointers may not portably be converted to 'void*', so they
+    // are stored as a generic function pointer instead
+    union storage
+    {
+      void* object;
+      void(*function)();
+    };
+
+    using invoker = R(*)(storage, Args&&...);
+
+    //-------------------------------------------------------------------------
+    // Private Static Functions
+    //-------------------------------------------------------------------------
+  private:
+
+    template <typename F>
+    static auto invoke_object(storage s, Args&&...args) -> R;
+
+    template <typename F>
+    static auto invoke_function(storage s, Args&&...args) -> R;
+
+    //-------------------------------------------------------------------------
+    // Private Members
+    //-------------------------------------------------------------------------
+  private:
+
+    storage m_storage;
+    invoker m_invoke;
+  };
+
+  //===========================================================================
+  // class : not_null<std::function>
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief A `std::function` that is never empty
+  ///
+  /// `std::function::operator()` checks for emptiness on every call, and
+  /// throws `std::bad_function_call` if it is empty. A `not_null` function is
+  /// checked once on construction, by `check_not_null`, and its call
+  /// operator hints to the compiler that the function is not empty, so that
+  /// the check is removed from each call once inlined.
+  ///
+  /// Unlike `not_null_function_ref`, this owns the callable.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// auto on_event(cpp::not_null<std::function<void(const event&)>> f) -> void
+  /// {
+  ///   m_handlers.push_back(std::move(f));
+  /// }
+  ///
+  /// ...
+  ///
+  /// for (const auto& handler : m_handlers) {
+  ///   handler(e); // no emptiness check
+  /// }
+  /// ```
+  ///
+  /// \tparam R the result type
+  /// \tparam Args the argument types
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename R, typename...Args>
+  class not_null<std::function<R(Args...)>>
+  {
+    //-------------------------------------------------------------------------
+    // Public Member Types
+    //-------------------------------------------------------------------------
+  public:
+
+    using element_type = std::function<R(Args...)>;
+    using result_type  = R;
+
+    //-------------------------------------------------------------------------
+    // Constructors / Assignment
+    //-------------------------------------------------------------------------
+  public:
+
+    // not_null is not default-constructible, since it must hold a callable
+    not_null() = delete;
+
+    not_null(const not_null& other) = default;
+    not_null(not_null&& other) = default;
+
+    //-------------------------------------------------------------------------
+
+    auto operator=(const not_null& other) -> not_null& = default;
+    auto operator=(not_null&& other) -> not_null& = default;
+
+    //-------------------------------------------------------------------------
+    // Observers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Contextually convertible to `true`
+    constexpr explicit operator bool() const noexcept;
+
+    /// \{
+    /// \brief Gets the underlying std::function
+    ///
+    /// \return the underlying std::function
+    auto as_nullable() const & noexcept -> const element_type&;
+    auto as_nullable() && noexcept -> element_type&&;
+    /// \}
+
+    /// \brief Invokes the underlying function with \p args, without
+    ///        checking for emptiness
+    ///
+    /// \param args the arguments to forward
+    /// \return the result of the call
+    auto operator()(Args...args) const -> R;
+
+    //-------------------------------------------------------------------------
+    // Private Members
+    //-------------------------------------------------------------------------
+  private:
+
+    element_type m_function;
+
+    //-------------------------------------------------------------------------
+    // Private Constructors
+    //-------------------------------------------------------------------------
+  private:
+
+    struct ctor_tag{};
+
+    template <typename F>
+    not_null(ctor_tag, F&& fn)
+      noexcept(std::is_nothrow_constructible<element_type,F>::value);
+
+    friend detail::not_null_factory;
+  };
+
+} // inline namespace bitwizeshift
+} // namespace cpp
+
+//=============================================================================
+// class : not_null_function_ref
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+template <typename R, typename...Args>
+template <typename F, typename>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::not_null_function_ref<R(Args...)>::not_null_function_ref(F&& fn)
+  noexcept
+  : m_storage(),
+    m_invoke(&invoke_object<typename std::remove_reference<F>::type>)
+{
+  m_storage.object = const_cast<void*>(
+    static_cast<const volatile void*>(std::addressof(fn))
+  );
+}
+
+template <typename R, typename...Args>
+template <typename FR, typename...FArgs, typename>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::not_null_function_ref<R(Args...)>::not_null_function_ref(FR(&fn)(FArgs...))
+  noexcept
+  : m_storage(),
+    m_invoke(&invoke_function<FR(*)(FArgs...)>)
+{
+  m_storage.function = reinterpret_cast<void(*)()>(&fn);
+}
+
+template <typename R, typename...Args>
+template <typename FR, typename...FArgs, typename>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::not_null_function_ref<R(Args...)>::not_null_function_ref(not_null<FR(*)(FArgs...)> fn)
+  noexcept
+  : not_null_function_ref(*fn.as_nullable())
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+template <typename R, typename...Args>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_function_ref<R(Args...)>::operator()(Args...args)
+  const -> R
+{
+  return m_invoke(m_storage, std::forward<Args>(args)...);
+}
+
+//-----------------------------------------------------------------------------
+// Private Static Functions
+//-----------------------------------------------------------------------------
+
+template <typename R, typename...Args>
+template <typename F>
+inline
+auto NOT_NULL_NS_IMPL::not_null_function_ref<R(Args...)>::invoke_object(storage s,
+                                                                        Args&&...args)
+  -> R
+{
+  return static_cast<R>(
+    (*static_cast<F*>(s.object))(std::forward<Args>(args)...)
+  );
+}
+
+template <typename R, typename...Args>
+template <typename F>
+inline
+auto NOT_NULL_NS_IMPL::not_null_function_ref<R(Args...)>::invoke_function(storage s,
+                                                                          Args&&...args)
+  -> R
+{
+  return static_cast<R>(
+    reinterpret_cast<F>(s.function)(std::forward<Args>(args)...)
+  );
+}
+
+//=============================================================================
+// class : not_null<std::function>
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+template <typename R, typename...Args>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::not_null<std::function<R(Args...)>>::operator bool()
+  const noexcept
+{
+  return true;
+}
+
+template <typename R, typename...Args>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null<std::function<R(Args...)>>::as_nullable()
+  const & noexcept -> const element_type&
+{
+  return m_function;
+}
+
+template <typename R, typename...Args>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null<std::function<R(Args...)>>::as_nullable()
+  && noexcept -> element_type&&
+{
+  return static_cast<element_type&&>(m_function);
+}
+
+template <typename R, typename...Args>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null<std::function<R(Args...)>>::operator()(Args...args)
+  const -> R
+{
+  // 'std::function::operator()' branches on the same state that
+  // 'operator bool' observes, so marking the empty case unreachable removes
+  // that branch once both are inlined
+  NOT_NULL_ASSUME(static_cast<bool>(m_function));
+
+  return m_function(std::forward<Args>(args)...);
+}
+
+//-----------------------------------------------------------------------------
+// Private Constructors
+//-----------------------------------------------------------------------------
+
+template <typename R, typename...Args>
+template <typename F>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::not_null<std::function<R(Args...)>>::not_null(ctor_tag, F&& fn)
+  noexcept(std::is_nothrow_constructible<element_type,F>::value)
+  : m_function(std::forward<F>(fn))
+{
+
+}
+
+#endif /* CPP_BITWIZESHIFT_NOT_NULL_FUNCTION_REF_HPP */
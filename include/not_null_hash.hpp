@@ -0,0 +1,273 @@
+/*****************************************************************************
+ * \file not_null_hash.hpp
+ *
+ * \brief This header defines the hashing and transparent key functors for
+ *        using not_null pointers as the keys of associative containers
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2019 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CPP_BITWIZESHIFT_NOT_NULL_HASH_HPP
+#define CPP_BITWIZESHIFT_NOT_NULL_HASH_HPP
+
+#include "not_null.hpp"
+
+#include <cstddef>     // std::size_t
+#include <functional>  // std::hash, std::less
+#include <type_traits> // std::is_convertible, std::true_type
+
+NOT_NULL_EXPORT namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+  //===========================================================================
+  // functors : not_null keys
+  //===========================================================================
+
+  namespace detail {
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A utility for retrieving the raw pointer from any of the key
+    ///        types accepted by the transparent not_null functors
+    ///
+    /// \tparam T the underlying pointer type of the not_null key
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    struct not_null_key
+    {
+      using pointer = typename not_null<T>::pointer;
+
+      static constexpr auto get(const not_null<T>& p) noexcept -> pointer;
+
+      template <typename U>
+      static constexpr auto get(const U& p) noexcept -> pointer;
+
+    private:
+
+      // Raw pointers (and nullptr) are used as-is
+      template <typename U>
+      static constexpr auto get(const U& p, std::true_type) noexcept -> pointer;
+
+      // Everything else is treated as a (possibly null) fancy pointer
+      template <typename U>
+      static constexpr auto get(const U& p, std::false_type) noexcept -> pointer;
+    };
+  } // namespace detail
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief A transparent hash functor for `not_null<T>` keys
+  ///
+  /// This hashes `not_null<T>`, `T`, and the raw `pointer` type identically,
+  /// which allows unordered containers keyed on `not_null<T>` to be searched
+  /// with any of these types without constructing a temporary `not_null` (or
+  /// a temporary smart pointer).
+  ///
+  /// The hash produced is the same as `std::hash<not_null<T>>`.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// using key_type = not_null<std::unique_ptr<Node>>;
+  ///
+  /// auto map = std::unordered_map<
+  ///   key_type, Value, not_null_hash<key_type>, not_null_equal_to<key_type>
+  /// >{};
+  ///
+  /// ...
+  ///
+  /// Node* node = ...;
+  /// auto it = map.find(node); // no unique_ptr is constructed (C++20)
+  /// ```
+  ///
+  /// \tparam T the not_null key type, or its underlying pointer type
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  struct not_null_hash;
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief A transparent equality functor for `not_null<T>` keys
+  ///
+  /// This compares any combination of `not_null<T>`, `T`, and the raw
+  /// `pointer` type by the address they point to.
+  ///
+  /// \tparam T the not_null key type, or its underlying pointer type
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  struct not_null_equal_to;
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief A transparent ordering functor for `not_null<T>` keys
+  ///
+  /// This orders any combination of `not_null<T>`, `T`, and the raw
+  /// `pointer` type by the address they point to, using the total order of
+  /// `std::less<pointer>`.
+  ///
+  /// \tparam T the not_null key type, or its underlying pointer type
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  struct not_null_less;
+
+  template <typename T>
+  struct not_null_hash
+  {
+    using is_transparent = void;
+
+    template <typename U>
+    auto operator()(const U& p) const noexcept -> std::size_t;
+  };
+
+  template <typename T>
+  struct not_null_equal_to
+  {
+    using is_transparent = void;
+
+    template <typename U, typename V>
+    constexpr auto operator()(const U& lhs, const V& rhs) const noexcept -> bool;
+  };
+
+  template <typename T>
+  struct not_null_less
+  {
+    using is_transparent = void;
+
+    template <typename U, typename V>
+    auto operator()(const U& lhs, const V& rhs) const noexcept -> bool;
+  };
+
+  template <typename T>
+  struct not_null_hash<not_null<T>> : not_null_hash<T>{};
+
+  template <typename T>
+  struct not_null_equal_to<not_null<T>> : not_null_equal_to<T>{};
+
+  template <typename T>
+  struct not_null_less<not_null<T>> : not_null_less<T>{};
+
+} // inline namespace bitwizeshift
+} // namespace cpp
+
+namespace std {
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief Hashes a `not_null` by the address it points to
+  ///
+  /// For `std::unique_ptr` and `std::shared_ptr`, this produces the same
+  /// hash as the underlying smart pointer.
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  struct hash<::NOT_NULL_NS_IMPL::not_null<T>>
+  {
+    auto operator()(const ::NOT_NULL_NS_IMPL::not_null<T>& p)
+      const noexcept -> std::size_t;
+  };
+
+} // namespace std
+
+//=============================================================================
+// functors : not_null keys
+//=============================================================================
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::not_null_key<T>::get(const not_null<T>& p)
+  noexcept -> pointer
+{
+  // 'not_null::get' assumes a non-null result, which does not hold for a
+  // moved-from smart pointer that is still hashed or compared
+  return not_null_to_address(p.as_nullable());
+}
+
+template <typename T>
+template <typename U>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::not_null_key<T>::get(const U& p)
+  noexcept -> pointer
+{
+  return get(p, std::is_convertible<const U&,pointer>{});
+}
+
+template <typename T>
+template <typename U>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::not_null_key<T>::get(const U& p, std::true_type)
+  noexcept -> pointer
+{
+  return p;
+}
+
+template <typename T>
+template <typename U>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::not_null_key<T>::get(const U& p, std::false_type)
+  noexcept -> pointer
+{
+  return not_null_to_address(p);
+}
+
+template <typename T>
+template <typename U>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_hash<T>::operator()(const U& p)
+  const noexcept -> std::size_t
+{
+  using pointer = typename detail::not_null_key<T>::pointer;
+
+  return std::hash<pointer>{}(detail::not_null_key<T>::get(p));
+}
+
+template <typename T>
+template <typename U, typename V>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_equal_to<T>::operator()(const U& lhs,
+                                                        const V& rhs)
+  const noexcept -> bool
+{
+  return detail::not_null_key<T>::get(lhs) == detail::not_null_key<T>::get(rhs);
+}
+
+template <typename T>
+template <typename U, typename V>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_less<T>::operator()(const U& lhs,
+                                                    const V& rhs)
+  const noexcept -> bool
+{
+  using pointer = typename detail::not_null_key<T>::pointer;
+
+  return std::less<pointer>{}(
+    detail::not_null_key<T>::get(lhs),
+    detail::not_null_key<T>::get(rhs)
+  );
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto std::hash<NOT_NULL_NS_IMPL::not_null<T>>::operator()(
+  const ::NOT_NULL_NS_IMPL::not_null<T>& p
+) const noexcept -> std::size_t
+{
+  return ::NOT_NULL_NS_IMPL::not_null_hash<T>{}(p);
+}
+
+#endif /* CPP_BITWIZESHIFT_NOT_NULL_HASH_HPP */
@@ -0,0 +1,945 @@
+/*****************************************************************************
+ * \file not_null_pool.hpp
+ *
+ * \brief This header defines a fixed-size object pool that hands out
+ *        not_null owning pointers
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2019 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CPP_BITWIZESHIFT_NOT_NULL_POOL_HPP
+#define CPP_BITWIZESHIFT_NOT_NULL_POOL_HPP
+
+#include "not_null.hpp"
+
+#include <algorithm>   // std::find, std::max
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint64_t, std::uintptr_t
+#include <memory>      // std::unique_ptr
+#include <mutex>       // std::mutex, std::lock_guard
+#include <new>         // ::new
+#include <type_traits> // std::is_array, std::remove_cv
+#include <utility>     // std::forward, std::move
+#include <vector>      // std::vector
+#if __cplusplus >= 201703L && defined(__has_include)
+# if __has_include(<memory_resource>)
+#   include <memory_resource> // std::pmr::memory_resource
+#   if defined(__cpp_lib_memory_resource)
+#     define NOT_NULL_HAS_MEMORY_RESOURCE 1
+#   endif
+# endif
+#endif
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+  namespace detail {
+
+    class pool_core;
+
+    /// \brief The pools that have not yet been destroyed
+    struct pool_registry
+    {
+      std::mutex mutex;
+      std::vector<const pool_core*> live;
+      std::uint64_t next_id;
+
+      static auto instance() -> pool_registry&;
+
+      /// \brief Determines whether \p core is the live pool with the given
+      ///        \p id, rather than a destroyed pool, or a different pool that
+      ///        reused its address
+      ///
+      /// \pre mutex is held
+      auto is_live(const pool_core* core, std::uint64_t id) const noexcept -> bool;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief The type-erased storage of a `not_null_pool`
+    ///
+    /// Objects are carved out of slabs, each of which holds a fixed number of
+    /// objects. Every object is preceded by a pointer to the pool that owns
+    /// it, so that objects can be returned to their pool by a stateless
+    /// deleter. Free objects form an intrusive list through their storage.
+    ///
+    /// The free objects are shared between threads under a mutex, and are
+    /// moved to and from per-thread caches in batches.
+    ///////////////////////////////////////////////////////////////////////////
+    class pool_core
+    {
+    public:
+
+      /// \brief Constructs a pool of objects of the given size and alignment
+      ///
+      /// \param size the size of each object
+      /// \param alignment the alignment of each object
+      /// \param objects_per_slab the number of objects allocated at once, or
+      ///        0 to allocate slabs of roughly 64 KiB
+      pool_core(std::size_t size,
+                std::size_t alignment,
+                std::size_t objects_per_slab);
+      pool_core(const pool_core&) = delete;
+
+      /// \brief Frees all slabs
+      ///
+      /// \pre every object has been deallocated
+      ~pool_core();
+
+      auto operator=(const pool_core&) -> pool_core& = delete;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Allocates storage for one object, using the current thread's
+      ///        cache
+      ///
+      /// \return storage for one object
+      auto allocate() -> void*;
+
+      /// \brief Returns the storage \p p to the pool that allocated it, using
+      ///        the current thread's cache
+      ///
+      /// \param p storage previously returned by `allocate`
+      static auto deallocate(void* p) noexcept -> void;
+
+      /// \brief Gets the pool that allocated the storage \p p
+      ///
+      /// \param p storage previously returned by `allocate`
+      /// \return the owning pool
+      static auto owner(void* p) noexcept -> pool_core*;
+
+      //-----------------------------------------------------------------------
+
+      /// \brief Moves up to \p n free objects from the shared list to \p head,
+      ///        allocating a new slab if there are none
+      ///
+      /// \param n the maximum number of objects to take
+      /// \param head receives the first object of the taken list
+      /// \return the number of objects taken, which is at least 1
+      auto take(std::size_t n, void*& head) -> std::size_t;
+
+      /// \brief Moves the list of free objects from \p head to \p tail back
+      ///        to the shared list
+      ///
+      /// \param head the first object of the list
+      /// \param tail the last object of the list
+      auto give(void* head, void* tail) noexcept -> void;
+
+      //-----------------------------------------------------------------------
+
+      auto id() const noexcept -> std::uint64_t;
+      auto object_size() const noexcept -> std::size_t;
+      auto object_alignment() const noexcept -> std::size_t;
+      auto objects_per_slab() const noexcept -> std::size_t;
+
+      //-----------------------------------------------------------------------
+
+      static auto next(void* p) noexcept -> void*;
+      static auto set_next(void* p, void* next) noexcept -> void;
+
+    private:
+
+      std::uint64_t m_id;
+      std::size_t m_size;
+      std::size_t m_alignment;
+      std::size_t m_header_size; ///< The owner pointer, padded for alignment
+      std::size_t m_stride;
+      std::size_t m_objects_per_slab;
+
+      std::mutex m_mutex;
+      void* m_free;
+      std::vector<std::unique_ptr<unsigned char[]>> m_slabs;
+
+      /// \brief Allocates a new slab, and adds its objects to the free list
+      ///
+      /// \pre m_mutex is held
+      auto grow() -> void;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief The free objects that the current thread has cached for each
+    ///        pool that it uses
+    ///
+    /// A thread caches objects for a fixed number of pools at once, so that
+    /// the cache itself never allocates. Using another pool evicts the least
+    /// recently used one, returning its cached objects to it. Cached objects
+    /// are also returned to their pools when the thread exits.
+    ///////////////////////////////////////////////////////////////////////////
+    class pool_thread_cache
+    {
+    public:
+
+      pool_thread_cache() noexcept;
+      pool_thread_cache(const pool_thread_cache&) = delete;
+      ~pool_thread_cache();
+
+      auto operator=(const pool_thread_cache&) -> pool_thread_cache& = delete;
+
+      //-----------------------------------------------------------------------
+
+      auto allocate(pool_core& core) -> void*;
+      auto deallocate(pool_core& core, void* p) noexcept -> void;
+
+    private:
+
+      struct entry
+      {
+        pool_core* core; ///< null if unused
+        std::uint64_t id;
+        void* head;
+        std::size_t count;
+        std::uint64_t last_use; ///< When this entry last became m_last
+      };
+
+      /// The number of pools that can be cached at once
+      ///
+      /// A thread that alternates between more pools than this evicts an
+      /// entry each time it switches to a pool that is not cached, which
+      /// takes the registry mutex and moves up to a batch of objects each
+      /// way. Bursts of use of the same pool amortize this cost.
+      static constexpr std::size_t max_entries = 8u;
+
+      /// The number of objects moved to or from a pool at once
+      static constexpr std::size_t batch_size = 32u;
+
+      entry m_entries[max_entries];
+      std::size_t m_last;   ///< The most recently used entry
+      std::uint64_t m_uses; ///< The number of times m_last has changed
+
+      /// \brief Finds the entry for \p core, claiming an unused entry or
+      ///        evicting the least recently used one if there is none
+      ///
+      /// \return the entry
+      auto find(pool_core& core) noexcept -> entry&;
+
+      /// \brief Returns the objects cached in \p e to its pool
+      ///
+      /// \pre the registry mutex is held, and the pool of \p e is live
+      static auto release(entry& e) noexcept -> void;
+    };
+
+    /// \brief Gets the pool cache of the current thread
+    auto this_pool_thread_cache() -> pool_thread_cache&;
+
+    /// \brief Returns storage to its pool without destroying an object
+    struct pool_storage_deleter
+    {
+      auto operator()(void* p) const noexcept -> void;
+    };
+
+#if defined(NOT_NULL_HAS_MEMORY_RESOURCE)
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A `std::pmr::memory_resource` that allocates from a pool
+    ///
+    /// Allocations that fit in an object of the pool are taken from the
+    /// pool; larger or more aligned allocations are forwarded to the
+    /// upstream resource.
+    ///////////////////////////////////////////////////////////////////////////
+    class pool_resource : public std::pmr::memory_resource
+    {
+    public:
+
+      pool_resource(pool_core& core,
+                    std::pmr::memory_resource* upstream) noexcept;
+
+    private:
+
+      pool_core* m_core;
+      std::pmr::memory_resource* m_upstream;
+
+      auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override;
+      auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override;
+      auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override;
+
+      auto is_pooled(std::size_t bytes, std::size_t alignment) const noexcept -> bool;
+    };
+
+#endif // defined(NOT_NULL_HAS_MEMORY_RESOURCE)
+
+  } // namespace detail
+
+  //===========================================================================
+  // struct : pool_deleter
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief The deleter of objects acquired from a `not_null_pool`
+  ///
+  /// The deleter is stateless; the pool that owns an object is found from
+  /// the object itself. This keeps a `std::unique_ptr<T, pool_deleter<T>>`
+  /// the size of a single pointer.
+  ///
+  /// \tparam T the type of the pooled object
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  struct pool_deleter
+  {
+    /// \brief Destroys \p p, and returns its storage to its pool
+    ///
+    /// \param p an object acquired from a `not_null_pool<T>`
+    auto operator()(T* p) const noexcept -> void;
+  };
+
+  //===========================================================================
+  // class : not_null_pool
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief A pool of fixed-size objects, which hands out `not_null` owning
+  ///        pointers
+  ///
+  /// Storage is allocated in slabs of many objects at once, and objects that
+  /// are released are reused by later acquisitions. Each thread keeps a
+  /// small cache of free objects for every pool it uses, so that acquiring
+  /// and releasing objects does not usually take a lock.
+  ///
+  /// Objects may be released on any thread, but must not outlive the pool
+  /// that they were acquired from.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// cpp::not_null_pool<message> pool{};
+  ///
+  /// auto m = pool.acquire("hello", 42);
+  /// queue.push(std::move(m)); // released back to 'pool' when destroyed
+  /// ```
+  ///
+  /// \tparam T the type of the pooled objects
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  class not_null_pool
+  {
+    static_assert(
+      !std::is_array<T>::value && !std::is_reference<T>::value,
+      "not_null_pool<T> requires T to be an object type that is not an array."
+    );
+
+    //-------------------------------------------------------------------------
+    // Public Member Types
+    //-------------------------------------------------------------------------
+  public:
+
+    using value_type = T;
+    using deleter_type = pool_deleter<T>;
+    using pointer = not_null<std::unique_ptr<T, deleter_type>>;
+
+    //-------------------------------------------------------------------------
+    // Constructors / Assignment
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Constructs a pool that allocates slabs of roughly 64 KiB
+    not_null_pool();
+
+    /// \brief Constructs a pool that allocates \p objects_per_slab objects
+    ///        at once
+    ///
+    /// \param objects_per_slab the number of objects in each slab
+    explicit not_null_pool(std::size_t objects_per_slab);
+
+    not_null_pool(const not_null_pool&) = delete;
+
+    /// \brief Frees all storage of this pool
+    ///
+    /// \pre every object acquired from this pool has been released
+    ~not_null_pool() = default;
+
+    //-------------------------------------------------------------------------
+
+    auto operator=(const not_null_pool&) -> not_null_pool& = delete;
+
+    //-------------------------------------------------------------------------
+    // Modifiers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Acquires an object from this pool, constructed from \p args
+    ///
+    /// No check for null is performed; the storage is either acquired, or
+    /// `std::bad_alloc` is thrown.
+    ///
+    /// \param args the arguments to forward to the constructor of `T`
+    /// \return a `not_null` owning the constructed object
+    template <typename...Args>
+    auto acquire(Args&&...args) -> pointer;
+
+    //-------------------------------------------------------------------------
+    // Observers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Gets the number of objects allocated in each slab
+    ///
+    /// \return the number of objects in each slab
+    auto objects_per_slab() const noexcept -> std::size_t;
+
+#if defined(NOT_NULL_HAS_MEMORY_RESOURCE)
+    /// \brief Gets a memory resource that allocates from this pool
+    ///
+    /// Allocations no larger and no more aligned than `T` are taken from
+    /// this pool; others are forwarded to the default resource at the time
+    /// that this pool was constructed. This allows node-based `std::pmr`
+    /// containers of `T`-sized nodes to share this pool.
+    ///
+    /// \note Only available when compiling as C++17 or above
+    ///
+    /// \return the memory resource of this pool
+    auto resource() noexcept -> not_null<std::pmr::memory_resource*>;
+#endif
+
+    //-------------------------------------------------------------------------
+    // Private Members
+    //-------------------------------------------------------------------------
+  private:
+
+    detail::pool_core m_core;
+#if defined(NOT_NULL_HAS_MEMORY_RESOURCE)
+    detail::pool_resource m_resource;
+#endif
+  };
+
+} // inline namespace bitwizeshift
+} // namespace cpp
+
+//=============================================================================
+// class : pool_registry
+//=============================================================================
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_registry::instance()
+  -> pool_registry&
+{
+  static pool_registry s_registry{{}, {}, 1u};
+
+  return s_registry;
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_registry::is_live(const pool_core* core,
+                                                      std::uint64_t id)
+  const noexcept -> bool
+{
+  return std::find(live.begin(), live.end(), core) != live.end() &&
+         core->id() == id;
+}
+
+//=============================================================================
+// class : pool_core
+//=============================================================================
+
+inline
+NOT_NULL_NS_IMPL::detail::pool_core::pool_core(std::size_t size,
+                                               std::size_t alignment,
+                                               std::size_t objects_per_slab)
+  : m_id{0u},
+    m_size{(std::max)(size, sizeof(void*))},
+    m_alignment{(std::max)(alignment, alignof(void*))},
+    m_header_size{0u},
+    m_stride{0u},
+    m_objects_per_slab{objects_per_slab},
+    m_mutex{},
+    m_free{nullptr},
+    m_slabs{}
+{
+  const auto round_up = [this](std::size_t n) {
+    return (n + m_alignment - 1u) / m_alignment * m_alignment;
+  };
+
+  m_header_size = round_up(sizeof(pool_core*));
+  m_stride = m_header_size + round_up(m_size);
+  if (m_objects_per_slab == 0u) {
+    m_objects_per_slab = (std::max)(std::size_t{1u}, (64u * 1024u) / m_stride);
+  }
+
+  auto& registry = pool_registry::instance();
+  const std::lock_guard<std::mutex> lock{registry.mutex};
+
+  registry.live.push_back(this);
+  m_id = registry.next_id++;
+}
+
+inline
+NOT_NULL_NS_IMPL::detail::pool_core::~pool_core()
+{
+  auto& registry = pool_registry::instance();
+  const std::lock_guard<std::mutex> lock{registry.mutex};
+
+  registry.live.erase(
+    std::find(registry.live.begin(), registry.live.end(), this)
+  );
+}
+
+//-----------------------------------------------------------------------------
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_core::allocate()
+  -> void*
+{
+  return this_pool_thread_cache().allocate(*this);
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_core::deallocate(void* p)
+  noexcept -> void
+{
+  this_pool_thread_cache().deallocate(*owner(p), p);
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_core::owner(void* p)
+  noexcept -> pool_core*
+{
+  // The owner is stored immediately before the object, regardless of how
+  // much padding the header has
+  return *reinterpret_cast<pool_core* const*>(
+    static_cast<unsigned char*>(p) - sizeof(pool_core*)
+  );
+}
+
+//-----------------------------------------------------------------------------
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_core::take(std::size_t n, void*& head)
+  -> std::size_t
+{
+  const std::lock_guard<std::mutex> lock{m_mutex};
+
+  if (m_free == nullptr) {
+    grow();
+  }
+
+  auto* tail = m_free;
+  auto count = std::size_t{1u};
+  for (; count < n && next(tail) != nullptr; ++count) {
+    tail = next(tail);
+  }
+
+  head = m_free;
+  m_free = next(tail);
+  set_next(tail, nullptr);
+
+  return count;
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_core::give(void* head, void* tail)
+  noexcept -> void
+{
+  const std::lock_guard<std::mutex> lock{m_mutex};
+
+  set_next(tail, m_free);
+  m_free = head;
+}
+
+//-----------------------------------------------------------------------------
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_core::id()
+  const noexcept -> std::uint64_t
+{
+  return m_id;
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_core::object_size()
+  const noexcept -> std::size_t
+{
+  return m_size;
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_core::object_alignment()
+  const noexcept -> std::size_t
+{
+  return m_alignment;
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_core::objects_per_slab()
+  const noexcept -> std::size_t
+{
+  return m_objects_per_slab;
+}
+
+//-----------------------------------------------------------------------------
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_core::next(void* p)
+  noexcept -> void*
+{
+  return *static_cast<void**>(p);
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_core::set_next(void* p, void* next)
+  noexcept -> void
+{
+  ::new (p) void*(next);
+}
+
+//-----------------------------------------------------------------------------
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_core::grow()
+  -> void
+{
+  // Over-allocate so that the first header can be aligned to the object
+  // alignment, which may exceed the alignment of 'new[]'
+  const auto bytes = m_stride * m_objects_per_slab + m_alignment;
+  auto slab = std::unique_ptr<unsigned char[]>{new unsigned char[bytes]};
+
+  m_slabs.reserve(m_slabs.size() + 1u);
+
+  const auto address = reinterpret_cast<std::uintptr_t>(slab.get());
+  const auto offset = (m_alignment - (address % m_alignment)) % m_alignment;
+  auto* const first = slab.get() + offset;
+
+  // Linked in reverse, so that objects are handed out in address order
+  for (auto i = m_objects_per_slab; i > 0u; --i) {
+    auto* const object = first + (i - 1u) * m_stride + m_header_size;
+
+    ::new (static_cast<void*>(object - sizeof(pool_core*))) pool_core*(this);
+    set_next(object, m_free);
+    m_free = object;
+  }
+
+  m_slabs.push_back(std::move(slab));
+}
+
+//=============================================================================
+// class : pool_thread_cache
+//=============================================================================
+
+inline
+NOT_NULL_NS_IMPL::detail::pool_thread_cache::pool_thread_cache()
+  noexcept
+  : m_entries{},
+    m_last{0u},
+    m_uses{0u}
+{
+
+}
+
+inline
+NOT_NULL_NS_IMPL::detail::pool_thread_cache::~pool_thread_cache()
+{
+  auto& registry = pool_registry::instance();
+
+  // The registry is held while returning objects, so that no pool can be
+  // destroyed part-way through
+  const std::lock_guard<std::mutex> lock{registry.mutex};
+
+  for (auto& e : m_entries) {
+    if (e.core != nullptr && registry.is_live(e.core, e.id)) {
+      release(e);
+    }
+  }
+}
+
+constexpr std::size_t NOT_NULL_NS_IMPL::detail::pool_thread_cache::max_entries;
+constexpr std::size_t NOT_NULL_NS_IMPL::detail::pool_thread_cache::batch_size;
+
+//-----------------------------------------------------------------------------
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_thread_cache::allocate(pool_core& core)
+  -> void*
+{
+  auto& e = find(core);
+
+  if (NOT_NULL_UNLIKELY(e.count == 0u)) {
+    e.count = core.take(batch_size, e.head);
+  }
+
+  auto* const p = e.head;
+  e.head = pool_core::next(p);
+  --e.count;
+
+  return p;
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_thread_cache::deallocate(pool_core& core,
+                                                             void* p)
+  noexcept -> void
+{
+  auto& e = find(core);
+
+  pool_core::set_next(p, e.head);
+  e.head = p;
+  ++e.count;
+
+  // Threads that only release objects, such as consumers of a queue, return
+  // them in batches rather than accumulating them
+  if (NOT_NULL_UNLIKELY(e.count > 2u * batch_size)) {
+    auto* const head = e.head;
+    auto* tail = head;
+    for (auto i = std::size_t{1u}; i < batch_size; ++i) {
+      tail = pool_core::next(tail);
+    }
+    e.head = pool_core::next(tail);
+    e.count -= batch_size;
+    core.give(head, tail);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_thread_cache::find(pool_core& core)
+  noexcept -> entry&
+{
+  const auto id = core.id();
+
+  if (NOT_NULL_LIKELY(m_entries[m_last].core == &core && m_entries[m_last].id == id)) {
+    return m_entries[m_last];
+  }
+
+  // An entry stays most recently used from when it becomes 'm_last' until
+  // another entry does, so stamping it only then is enough to order the
+  // entries by their last use
+  for (auto i = std::size_t{0u}; i < max_entries; ++i) {
+    if (m_entries[i].core == &core && m_entries[i].id == id) {
+      m_last = i;
+      m_entries[i].last_use = ++m_uses;
+      return m_entries[i];
+    }
+  }
+
+  auto& registry = pool_registry::instance();
+  const std::lock_guard<std::mutex> lock{registry.mutex};
+
+  // Entries of destroyed pools refer to slabs that have already been freed,
+  // so they are dropped rather than returned
+  for (auto& e : m_entries) {
+    if (e.core != nullptr && !registry.is_live(e.core, e.id)) {
+      e = entry{};
+    }
+  }
+  auto victim = std::size_t{0u};
+  for (auto i = std::size_t{0u}; i < max_entries; ++i) {
+    if (m_entries[i].core == nullptr) {
+      victim = i;
+      break;
+    }
+    if (m_entries[i].last_use < m_entries[victim].last_use) {
+      victim = i;
+    }
+  }
+  if (m_entries[victim].core != nullptr) {
+    release(m_entries[victim]);
+  }
+
+  m_entries[victim] = entry{&core, id, nullptr, 0u, ++m_uses};
+  m_last = victim;
+  return m_entries[victim];
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_thread_cache::release(entry& e)
+  noexcept -> void
+{
+  if (e.count == 0u) {
+    return;
+  }
+  auto* tail = e.head;
+  for (auto i = std::size_t{1u}; i < e.count; ++i) {
+    tail = pool_core::next(tail);
+  }
+  e.core->give(e.head, tail);
+  e.head = nullptr;
+  e.count = 0u;
+}
+
+//-----------------------------------------------------------------------------
+
+inline
+auto NOT_NULL_NS_IMPL::detail::this_pool_thread_cache()
+  -> pool_thread_cache&
+{
+  static thread_local pool_thread_cache s_cache{};
+
+  return s_cache;
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_storage_deleter::operator()(void* p)
+  const noexcept -> void
+{
+  pool_core::deallocate(p);
+}
+
+#if defined(NOT_NULL_HAS_MEMORY_RESOURCE)
+
+//=============================================================================
+// class : pool_resource
+//=============================================================================
+
+inline
+NOT_NULL_NS_IMPL::detail::pool_resource::pool_resource(pool_core& core,
+                                                       std::pmr::memory_resource* upstream)
+  noexcept
+  : m_core{&core},
+    m_upstream{upstream}
+{
+
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_resource::do_allocate(std::size_t bytes,
+                                                          std::size_t alignment)
+  -> void*
+{
+  if (is_pooled(bytes, alignment)) {
+    return m_core->allocate();
+  }
+  return m_upstream->allocate(bytes, alignment);
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_resource::do_deallocate(void* p,
+                                                            std::size_t bytes,
+                                                            std::size_t alignment)
+  -> void
+{
+  if (is_pooled(bytes, alignment)) {
+    pool_core::deallocate(p);
+  } else {
+    m_upstream->deallocate(p, bytes, alignment);
+  }
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_resource::do_is_equal(const std::pmr::memory_resource& other)
+  const noexcept -> bool
+{
+  return this == &other;
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::pool_resource::is_pooled(std::size_t bytes,
+                                                        std::size_t alignment)
+  const noexcept -> bool
+{
+  return bytes <= m_core->object_size() &&
+         alignment <= m_core->object_alignment();
+}
+
+#endif // defined(NOT_NULL_HAS_MEMORY_RESOURCE)
+
+//=============================================================================
+// struct : pool_deleter
+//=============================================================================
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::pool_deleter<T>::operator()(T* p)
+  const noexcept -> void
+{
+  using value_type = typename std::remove_cv<T>::type;
+
+  p->~T();
+  detail::pool_core::deallocate(const_cast<value_type*>(p));
+}
+
+//=============================================================================
+// class : not_null_pool
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline
+NOT_NULL_NS_IMPL::not_null_pool<T>::not_null_pool()
+  : not_null_pool{0u}
+{
+
+}
+
+template <typename T>
+inline
+NOT_NULL_NS_IMPL::not_null_pool<T>::not_null_pool(std::size_t objects_per_slab)
+  : m_core{sizeof(T), alignof(T), objects_per_slab}
+#if defined(NOT_NULL_HAS_MEMORY_RESOURCE)
+  , m_resource{m_core, std::pmr::get_default_resource()}
+#endif
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Modifiers
+//-----------------------------------------------------------------------------
+
+template <typename T>
+template <typename...Args>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_pool<T>::acquire(Args&&...args)
+  -> pointer
+{
+  // Returns the storage to the pool if the constructor throws
+  auto storage = std::unique_ptr<void, detail::pool_storage_deleter>{
+    m_core.allocate()
+  };
+
+  auto* const p = ::new (storage.get()) T(std::forward<Args>(args)...);
+  storage.release();
+
+  return detail::not_null_factory::make(
+    std::unique_ptr<T, deleter_type>{p}
+  );
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline
+auto NOT_NULL_NS_IMPL::not_null_pool<T>::objects_per_slab()
+  const noexcept -> std::size_t
+{
+  return m_core.objects_per_slab();
+}
+
+#if defined(NOT_NULL_HAS_MEMORY_RESOURCE)
+
+template <typename T>
+inline
+auto NOT_NULL_NS_IMPL::not_null_pool<T>::resource()
+  noexcept -> not_null<std::pmr::memory_resource*>
+{
+  return detail::not_null_factory::make(
+    static_cast<std::pmr::memory_resource*>(&m_resource)
+  );
+}
+
+#endif // defined(NOT_NULL_HAS_MEMORY_RESOURCE)
+
+#endif /* CPP_BITWIZESHIFT_NOT_NULL_POOL_HPP */
@@ -0,0 +1,329 @@
+/*****************************************************************************
+ * \file not_null_prefetch.hpp
+ *
+ * \brief This header defines software-prefetching utilities for not_null
+ *        pointers, and algorithms that prefetch ahead over ranges of them
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2019 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CPP_BITWIZESHIFT_NOT_NULL_PREFETCH_HPP
+#define CPP_BITWIZESHIFT_NOT_NULL_PREFETCH_HPP
+
+#include "not_null.hpp"
+
+#include <cstddef>     // std::size_t
+#include <iterator>    // std::begin, std::end, std::iterator_traits
+#include <type_traits> // std::is_object, std::is_convertible
+#include <utility>     // std::move
+
+#if defined(_MSC_VER) && !defined(__clang__) && \
+    (defined(_M_IX86) || defined(_M_X64))
+# include <xmmintrin.h> // _mm_prefetch
+#endif
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+  //===========================================================================
+  // enum class : prefetch_locality
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief A hint for how long prefetched data should remain in the cache
+  ///
+  /// The values correspond to the `locality` argument of
+  /// `__builtin_prefetch`: `none` prefetches without keeping the data in the
+  /// cache after use, and `high` keeps the data in every level of the cache.
+  /////////////////////////////////////////////////////////////////////////////
+  enum class prefetch_locality
+  {
+    none,     ///< The data is used once, and need not remain in the cache
+    low,      ///< The data should remain in the last level of the cache
+    moderate, ///< The data should remain in the outer levels of the cache
+    high,     ///< The data should remain in every level of the cache
+  };
+
+  //===========================================================================
+  // non-member functions : class : not_null
+  //===========================================================================
+
+  //---------------------------------------------------------------------------
+  // Prefetching
+  //---------------------------------------------------------------------------
+
+  /// \brief Hints to the processor that the object pointed to by \p p will
+  ///        soon be read
+  ///
+  /// Since a `not_null` always points to an object, the prefetch is issued
+  /// unconditionally; no check for null is required at the call site. A
+  /// prefetch never faults, and has no observable effect other than on
+  /// performance.
+  ///
+  /// On compilers and architectures without a prefetch instruction, this
+  /// function does nothing.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// auto visit(cpp::not_null<const node*> n) -> void
+  /// {
+  ///   cpp::prefetch(n->next);
+  ///   process(*n);
+  /// }
+  /// ```
+  ///
+  /// \param p the pointer to the object to prefetch
+  /// \param locality how long the object should remain in the cache
+  template <typename T>
+  auto prefetch(const not_null<T>& p,
+                prefetch_locality locality = prefetch_locality::high)
+    noexcept -> void;
+
+  //---------------------------------------------------------------------------
+  // Algorithms
+  //---------------------------------------------------------------------------
+
+  /// \brief Calls \p f on every element in the range [\p first, \p last),
+  ///        while prefetching the object pointed to by the element
+  ///        \p distance positions ahead
+  ///
+  /// Every element of the range must be a `not_null`, and so the pointers
+  /// being prefetched are never checked for null. This makes the algorithm
+  /// suitable for scans over graphs of individually allocated objects, where
+  /// the latency of each load would otherwise be exposed.
+  ///
+  /// The best \p distance depends on the cost of \p f relative to the
+  /// latency of memory, and should be determined by measurement. A
+  /// \p distance of `0` performs no prefetching.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// auto nodes = std::vector<cpp::not_null<node*>>{...};
+  ///
+  /// auto total = 0;
+  /// cpp::prefetching_for_each(nodes.begin(), nodes.end(), 8u,
+  ///   [&](cpp::not_null<node*> n){
+  ///     total += n->value;
+  ///   }
+  /// );
+  /// ```
+  ///
+  /// \pre [\p first, \p last) is a valid range
+  ///
+  /// \tparam ForwardIt a forward iterator whose value type is a `not_null`
+  /// \param first the start of the range
+  /// \param last the end of the range
+  /// \param distance the number of elements ahead to prefetch
+  /// \param f the function to call with each element
+  /// \param locality how long prefetched objects should remain in the cache
+  /// \return \p f
+  template <typename ForwardIt, typename UnaryFunction>
+  auto prefetching_for_each(ForwardIt first,
+                            ForwardIt last,
+                            std::size_t distance,
+                            UnaryFunction f,
+                            prefetch_locality locality = prefetch_locality::high)
+    -> UnaryFunction;
+
+  /// \brief Calls \p f on every element in \p range, while prefetching the
+  ///        object pointed to by the element \p distance positions ahead
+  ///
+  /// This is equivalent to calling `prefetching_for_each` with the beginning
+  /// and end of \p range.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// auto total = 0;
+  /// cpp::prefetching_for_each(nodes, 8u, [&](cpp::not_null<node*> n){
+  ///   total += n->value;
+  /// });
+  /// ```
+  ///
+  /// \param range the range of `not_null` elements
+  /// \param distance the number of elements ahead to prefetch
+  /// \param f the function to call with each element
+  /// \param locality how long prefetched objects should remain in the cache
+  /// \return \p f
+  template <typename ForwardRange, typename UnaryFunction>
+  auto prefetching_for_each(ForwardRange&& range,
+                            std::size_t distance,
+                            UnaryFunction f,
+                            prefetch_locality locality = prefetch_locality::high)
+    -> UnaryFunction;
+
+  namespace detail {
+
+    /// \brief Prefetches the byte at \p p with the specified \p locality
+    ///
+    /// The locality of a prefetch must be a constant expression, so each
+    /// enumerator is dispatched to separately; this folds away entirely when
+    /// \p locality is a constant.
+    auto prefetch_address(const void* p, prefetch_locality locality)
+      noexcept -> void;
+
+  } // namespace detail
+
+} // inline namespace bitwizeshift
+} // namespace cpp
+
+//=============================================================================
+// non-member functions : class : not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Prefetching
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::prefetch(const not_null<T>& p,
+                                prefetch_locality locality)
+  noexcept -> void
+{
+  using element_type = typename not_null<T>::element_type;
+
+  static_assert(
+    std::is_object<element_type>::value,
+    "Only pointers to objects may be prefetched"
+  );
+
+  detail::prefetch_address(
+    const_cast<const void*>(static_cast<const volatile void*>(p.get())),
+    locality
+  );
+}
+
+//-----------------------------------------------------------------------------
+// Algorithms
+//-----------------------------------------------------------------------------
+
+template <typename ForwardIt, typename UnaryFunction>
+inline
+auto NOT_NULL_NS_IMPL::prefetching_for_each(ForwardIt first,
+                                            ForwardIt last,
+                                            std::size_t distance,
+                                            UnaryFunction f,
+                                            prefetch_locality locality)
+  -> UnaryFunction
+{
+  using category = typename std::iterator_traits<ForwardIt>::iterator_category;
+
+  static_assert(
+    std::is_convertible<category,std::forward_iterator_tag>::value,
+    "prefetching_for_each requires a multi-pass range, since elements are "
+    "visited once to be prefetched and again to be passed to the function"
+  );
+
+  // Prefetch the first 'distance' elements before visiting any of them, so
+  // that the lead iterator is 'distance' elements ahead of 'first'.
+  auto lead = first;
+  for (auto i = std::size_t{0}; i < distance && lead != last; ++i, ++lead) {
+    prefetch(*lead, locality);
+  }
+  for (; lead != last; ++lead, ++first) {
+    prefetch(*lead, locality);
+    f(*first);
+  }
+  for (; first != last; ++first) {
+    f(*first);
+  }
+  return f;
+}
+
+template <typename ForwardRange, typename UnaryFunction>
+inline
+auto NOT_NULL_NS_IMPL::prefetching_for_each(ForwardRange&& range,
+                                            std::size_t distance,
+                                            UnaryFunction f,
+                                            prefetch_locality locality)
+  -> UnaryFunction
+{
+  using std::begin;
+  using std::end;
+
+  return prefetching_for_each(
+    begin(range),
+    end(range),
+    distance,
+    std::move(f),
+    locality
+  );
+}
+
+//=============================================================================
+// detail utilities
+//=============================================================================
+
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::prefetch_address(const void* p,
+                                                prefetch_locality locality)
+  noexcept -> void
+{
+#if defined(__clang__) || defined(__GNUC__)
+  switch (locality) {
+    case prefetch_locality::none:
+      __builtin_prefetch(p, 0, 0);
+      break;
+    case prefetch_locality::low:
+      __builtin_prefetch(p, 0, 1);
+      break;
+    case prefetch_locality::moderate:
+      __builtin_prefetch(p, 0, 2);
+      break;
+    case prefetch_locality::high:
+      __builtin_prefetch(p, 0, 3);
+      break;
+  }
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  const auto* const address = static_cast<const char*>(p);
+  switch (locality) {
+    case prefetch_locality::none:
+      _mm_prefetch(address, _MM_HINT_NTA);
+      break;
+    case prefetch_locality::low:
+      _mm_prefetch(address, _MM_HINT_T2);
+      break;
+    case prefetch_locality::moderate:
+      _mm_prefetch(address, _MM_HINT_T1);
+      break;
+    case prefetch_locality::high:
+      _mm_prefetch(address, _MM_HINT_T0);
+      break;
+  }
+#else
+  static_cast<void>(p);
+  static_cast<void>(locality);
+#endif
+}
+
+#endif /* CPP_BITWIZESHIFT_NOT_NULL_PREFETCH_HPP */
@@ -0,0 +1,950 @@
+/*****************************************************************************
+ * \file not_null_span.hpp
+ *
+ * \brief This header defines a contiguous view whose data pointer can never
+ *        be null
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2019 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CPP_BITWIZESHIFT_NOT_NULL_SPAN_HPP
+#define CPP_BITWIZESHIFT_NOT_NULL_SPAN_HPP
+
+#include "not_null.hpp"
+
+#include <array>       // std::array
+#include <cstddef>     // std::size_t, std::ptrdiff_t
+#include <iterator>    // std::reverse_iterator
+#include <limits>      // std::numeric_limits
+#include <type_traits> // std::is_convertible, std::enable_if
+#if __cplusplus >= 202002L && defined(__has_include)
+# if __has_include(<span>)
+#   include <span> // std::span
+#   if defined(__cpp_lib_span)
+#     define NOT_NULL_HAS_SPAN 1
+#   endif
+# endif
+#endif
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+  /// \brief The extent of a `not_null_span` whose size is only known at
+  ///        runtime
+  constexpr std::size_t dynamic_extent = (std::numeric_limits<std::size_t>::max)();
+
+  template <typename T, std::size_t Extent = dynamic_extent>
+  class not_null_span;
+
+  namespace detail {
+
+    /// \{
+    /// \brief The size of a `not_null_span`, which is only stored for
+    ///        spans of dynamic extent
+    template <std::size_t Extent>
+    class not_null_span_extent
+    {
+    public:
+
+      constexpr explicit not_null_span_extent(std::size_t) noexcept;
+
+      constexpr auto size() const noexcept -> std::size_t;
+    };
+
+    template <>
+    class not_null_span_extent<dynamic_extent>
+    {
+    public:
+
+      constexpr explicit not_null_span_extent(std::size_t size) noexcept;
+
+      constexpr auto size() const noexcept -> std::size_t;
+
+    private:
+
+      std::size_t m_size;
+    };
+    /// \}
+
+    /// \brief The extent of `not_null_span<T,Extent>::subspan<Offset,Count>`
+    template <std::size_t Extent, std::size_t Offset, std::size_t Count>
+    struct not_null_subspan_extent : std::integral_constant<std::size_t,(
+      (Count != dynamic_extent)
+        ? Count
+        : (Extent != dynamic_extent) ? (Extent - Offset) : dynamic_extent
+    )>{};
+
+    /// \brief Determines whether a span of \p From elements can be viewed as
+    ///        a span of \p To elements
+    template <typename From, typename To>
+    struct not_null_span_is_compatible
+      : std::is_convertible<From(*)[],To(*)[]>{};
+
+    /// \brief Gets a non-null, suitably aligned pointer that does not point
+    ///        to any object, for use as the data of an empty span
+    ///
+    /// This is the same sentinel that Rust uses for the data of an empty
+    /// slice. It must never be dereferenced.
+    template <typename T>
+    auto not_null_span_dangling() noexcept -> T*;
+
+    /// \brief Checks the \p data of a span of \p size elements for null
+    ///
+    /// An empty range may have null data, such as an empty `std::vector` or
+    /// a default-constructed `std::span`. Since the data of an empty span is
+    /// never dereferenced, it is only checked when \p size is not `0`, and
+    /// null data is otherwise replaced with `not_null_span_dangling<T>()`.
+    ///
+    /// \param data pointer to the first element
+    /// \param size the number of elements
+    /// \return \p data, or a dangling pointer if it is null and \p size is 0
+    template <typename T>
+    constexpr auto not_null_span_check_data(T* data, std::size_t size)
+      -> not_null<T*>;
+
+    /// \brief Assumes that the \p data of a span of \p size elements is not
+    ///        null, unless \p size is `0`
+    ///
+    /// Null data of an empty span is replaced with
+    /// `not_null_span_dangling<T>()`, as in `not_null_span_check_data`.
+    ///
+    /// \param data pointer to the first element
+    /// \param size the number of elements
+    /// \return \p data, or a dangling pointer if it is null and \p size is 0
+    template <typename T>
+    constexpr auto not_null_span_assume_data(T* data, std::size_t size)
+      noexcept -> not_null<T*>;
+
+  } // namespace detail
+
+  //===========================================================================
+  // class : not_null_span
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief A view of a contiguous sequence of objects, whose `data()` is
+  ///        never null
+  ///
+  /// Unlike `std::span`, an empty `not_null_span` still points somewhere --
+  /// such as one past the end of the sequence it was taken from -- so code
+  /// receiving one never needs to guard `memcpy`, `memset`, or vectorized
+  /// kernels against a null base pointer. Subviews are taken from a pointer
+  /// that is already known to not be null, so they are never checked again.
+  ///
+  /// Spans of a static `Extent` store only their pointer, and can be used
+  /// in constant expressions.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// auto encode(not_null_span<const std::byte> in,
+  ///             not_null_span<std::byte> out) -> void
+  /// {
+  ///   // no null or empty guard needed
+  ///   std::memcpy(out.data().get(), in.data().get(), in.size());
+  ///
+  ///   encode(in.subspan(header_size), out.subspan(header_size));
+  /// }
+  /// ```
+  ///
+  /// \tparam T the element type
+  /// \tparam Extent the number of elements, or `dynamic_extent`
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T, std::size_t Extent>
+  class not_null_span : private detail::not_null_span_extent<Extent>
+  {
+    using extent_type = detail::not_null_span_extent<Extent>;
+
+    template <std::size_t E, typename U = void>
+    using enable_if_dynamic = std::enable_if<E == dynamic_extent, U>;
+    template <std::size_t E, typename U = void>
+    using enable_if_static = std::enable_if<E != dynamic_extent, U>;
+
+    //-------------------------------------------------------------------------
+    // Public Member Types
+    //-------------------------------------------------------------------------
+  public:
+
+    using element_type     = T;
+    using value_type       = typename std::remove_cv<T>::type;
+    using size_type        = std::size_t;
+    using difference_type  = std::ptrdiff_t;
+    using pointer          = T*;
+    using const_pointer    = const T*;
+    using reference        = T&;
+    using const_reference  = const T&;
+    using iterator         = T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    //-------------------------------------------------------------------------
+    // Public Static Members
+    //-------------------------------------------------------------------------
+  public:
+
+    static constexpr std::size_t extent = Extent;
+
+    //-------------------------------------------------------------------------
+    // Constructors / Assignment
+    //-------------------------------------------------------------------------
+  public:
+
+    // not_null_span is not default-constructible, since it must point
+    // somewhere
+    not_null_span() = delete;
+
+    /// \{
+    /// \brief Constructs a span of the \p count elements starting at \p data
+    ///
+    /// This constructor is explicit for spans of static extent.
+    ///
+    /// \pre If `Extent` is not `dynamic_extent`, \p count is `Extent`
+    /// \param data pointer to the first element
+    /// \param count the number of elements
+    template <std::size_t E = Extent,
+              typename = typename enable_if_dynamic<E>::type>
+    constexpr not_null_span(not_null<T*> data, size_type count) noexcept;
+    template <std::size_t E = Extent,
+              typename = typename enable_if_static<E>::type,
+              typename = void>
+    constexpr explicit not_null_span(not_null<T*> data, size_type count) noexcept;
+    /// \}
+
+    /// \brief Constructs a span of the elements of the array \p arr
+    ///
+    /// Arrays always have at least one element, so they can never be null.
+    ///
+    /// \param arr the array to view
+    template <typename U, std::size_t N,
+              typename = typename std::enable_if<
+                (Extent == dynamic_extent || Extent == N) &&
+                detail::not_null_span_is_compatible<U,T>::value
+              >::type>
+    constexpr not_null_span(U (&arr)[N]) noexcept;
+
+    /// \{
+    /// \brief Constructs a span of the elements of the array \p arr
+    ///
+    /// Arrays of no elements are not accepted, since they may have a null
+    /// `data()`.
+    ///
+    /// \param arr the array to view
+    template <typename U, std::size_t N,
+              typename = typename std::enable_if<
+                (N > 0u) &&
+                (Extent == dynamic_extent || Extent == N) &&
+                detail::not_null_span_is_compatible<U,T>::value
+              >::type>
+    constexpr not_null_span(std::array<U,N>& arr) noexcept;
+    template <typename U, std::size_t N,
+              typename = typename std::enable_if<
+                (N > 0u) &&
+                (Extent == dynamic_extent || Extent == N) &&
+                detail::not_null_span_is_compatible<const U,T>::value
+              >::type>
+    constexpr not_null_span(const std::array<U,N>& arr) noexcept;
+    /// \}
+
+    /// \{
+    /// \brief Converts a span of compatible elements to this span
+    ///
+    /// This constructor is explicit when converting a span of dynamic extent
+    /// to a span of static extent.
+    ///
+    /// \pre If `Extent` is not `dynamic_extent`, `other.size()` is `Extent`
+    /// \param other the span to convert
+    template <typename U, std::size_t N,
+              typename = typename std::enable_if<
+                (Extent == dynamic_extent || Extent == N) &&
+                detail::not_null_span_is_compatible<U,T>::value
+              >::type>
+    constexpr not_null_span(const not_null_span<U,N>& other) noexcept;
+    template <typename U, std::size_t N,
+              typename = typename std::enable_if<
+                (Extent != dynamic_extent && N == dynamic_extent) &&
+                detail::not_null_span_is_compatible<U,T>::value
+              >::type,
+              typename = void>
+    constexpr explicit not_null_span(const not_null_span<U,N>& other) noexcept;
+    /// \}
+
+    constexpr not_null_span(const not_null_span& other) noexcept = default;
+
+    //-------------------------------------------------------------------------
+
+    auto operator=(const not_null_span& other) noexcept -> not_null_span& = default;
+
+    //-------------------------------------------------------------------------
+    // Conversions
+    //-------------------------------------------------------------------------
+  public:
+
+#if defined(NOT_NULL_HAS_SPAN)
+    /// \brief Converts this span to a `std::span`
+    ///
+    /// \note Only available when compiling as C++20 or above
+    ///
+    /// \return a `std::span` of the same elements
+    constexpr operator std::span<T,Extent>() const noexcept;
+#endif
+
+    //-------------------------------------------------------------------------
+    // Observers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Gets a pointer to the first element
+    ///
+    /// If this span is empty, the pointer must not be dereferenced.
+    ///
+    /// \return a pointer to the first element
+    constexpr auto data() const noexcept -> not_null<T*>;
+
+    /// \brief Gets the number of elements
+    ///
+    /// \return the number of elements
+    constexpr auto size() const noexcept -> size_type;
+
+    /// \brief Gets the size of the elements, in bytes
+    ///
+    /// \return the size in bytes
+    constexpr auto size_bytes() const noexcept -> size_type;
+
+    /// \brief Queries whether this span has no elements
+    ///
+    /// \return `true` if `size() == 0`
+    constexpr auto empty() const noexcept -> bool;
+
+    //-------------------------------------------------------------------------
+    // Element Access
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Accesses the element at \p index
+    ///
+    /// \pre `index < size()`
+    /// \param index the index of the element
+    /// \return reference to the element
+    constexpr auto operator[](size_type index) const noexcept -> reference;
+
+    /// \brief Accesses the first element
+    ///
+    /// \pre `!empty()`
+    /// \return reference to the first element
+    constexpr auto front() const noexcept -> reference;
+
+    /// \brief Accesses the last element
+    ///
+    /// \pre `!empty()`
+    /// \return reference to the last element
+    constexpr auto back() const noexcept -> reference;
+
+    //-------------------------------------------------------------------------
+    // Iterators
+    //-------------------------------------------------------------------------
+  public:
+
+    constexpr auto begin() const noexcept -> iterator;
+    constexpr auto end() const noexcept -> iterator;
+    auto rbegin() const noexcept -> reverse_iterator;
+    auto rend() const noexcept -> reverse_iterator;
+
+    //-------------------------------------------------------------------------
+    // Subviews
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \{
+    /// \brief Gets a span of the first \p Count or \p count elements
+    ///
+    /// \pre `count <= size()`
+    /// \param count the number of elements
+    /// \return the span of the first elements
+    template <std::size_t Count>
+    constexpr auto first() const noexcept -> not_null_span<T,Count>;
+    constexpr auto first(size_type count) const noexcept -> not_null_span<T>;
+    /// \}
+
+    /// \{
+    /// \brief Gets a span of the last \p Count or \p count elements
+    ///
+    /// \pre `count <= size()`
+    /// \param count the number of elements
+    /// \return the span of the last elements
+    template <std::size_t Count>
+    constexpr auto last() const noexcept -> not_null_span<T,Count>;
+    constexpr auto last(size_type count) const noexcept -> not_null_span<T>;
+    /// \}
+
+    /// \{
+    /// \brief Gets a span of the \p count elements starting at \p offset,
+    ///        or of every element after \p offset if \p count is
+    ///        `dynamic_extent`
+    ///
+    /// \pre `offset <= size()`, and `offset + count <= size()` if \p count
+    ///      is not `dynamic_extent`
+    /// \param offset the index of the first element
+    /// \param count the number of elements
+    /// \return the span of the elements
+    template <std::size_t Offset, std::size_t Count = dynamic_extent>
+    constexpr auto subspan() const noexcept
+      -> not_null_span<T,detail::not_null_subspan_extent<Extent,Offset,Count>::value>;
+    constexpr auto subspan(size_type offset,
+                           size_type count = dynamic_extent) const noexcept
+      -> not_null_span<T>;
+    /// \}
+
+    //-------------------------------------------------------------------------
+    // Private Members
+    //-------------------------------------------------------------------------
+  private:
+
+    not_null<T*> m_data;
+  };
+
+#if defined(__cpp_deduction_guides)
+
+  template <typename T, std::size_t N>
+  not_null_span(T (&)[N]) -> not_null_span<T,N>;
+
+  template <typename T, std::size_t N>
+  not_null_span(std::array<T,N>&) -> not_null_span<T,N>;
+
+  template <typename T, std::size_t N>
+  not_null_span(const std::array<T,N>&) -> not_null_span<const T,N>;
+
+  template <typename T>
+  not_null_span(not_null<T*>, std::size_t) -> not_null_span<T>;
+
+#endif
+
+  //===========================================================================
+  // non-member functions : class : not_null_span
+  //===========================================================================
+
+  //---------------------------------------------------------------------------
+  // Utilities
+  //---------------------------------------------------------------------------
+
+  /// \{
+  /// \brief Creates a `not_null_span` from a nullable span, checking that its
+  ///        data is not null first
+  ///
+  /// The data of an empty span is not checked. If it is null, as it is for
+  /// an empty `std::vector` or a default-constructed `std::span`, the result
+  /// instead points to a suitably aligned address that must not be
+  /// dereferenced.
+  ///
+  /// ### Examples
+  ///
+  /// Basic use:
+  ///
+  /// ```cpp
+  /// auto s = check_not_null_span(buffer.data(), buffer.size());
+  /// ```
+  ///
+  /// \throw not_null_contract_violation if the data is null and the size is
+  ///        not `0`
+  /// \param data pointer to the first element
+  /// \param size the number of elements
+  /// \param s the span to check
+  /// \return a not_null_span of the same elements
+  template <typename T>
+  constexpr auto check_not_null_span(T* data, std::size_t size)
+    -> not_null_span<T>;
+#if defined(NOT_NULL_HAS_SPAN)
+  template <typename T, std::size_t Extent>
+  constexpr auto check_not_null_span(std::span<T,Extent> s)
+    -> not_null_span<T,Extent>;
+#endif
+  /// \}
+
+  /// \{
+  /// \brief Creates a `not_null_span` from a nullable span, *assuming* that
+  ///        its data is not null
+  ///
+  /// As with `check_not_null_span`, the data of an empty span may be null,
+  /// in which case the result points to a suitably aligned address that must
+  /// not be dereferenced.
+  ///
+  /// \pre the data is not null, or the size is `0`
+  /// \param data pointer to the first element
+  /// \param size the number of elements
+  /// \param s the span to adopt
+  /// \return a not_null_span of the same elements
+  template <typename T>
+  constexpr auto assume_not_null_span(T* data, std::size_t size)
+    noexcept -> not_null_span<T>;
+#if defined(NOT_NULL_HAS_SPAN)
+  template <typename T, std::size_t Extent>
+  constexpr auto assume_not_null_span(std::span<T,Extent> s)
+    noexcept -> not_null_span<T,Extent>;
+#endif
+  /// \}
+
+} // inline namespace bitwizeshift
+} // namespace cpp
+
+#if defined(NOT_NULL_HAS_SPAN) && defined(__cpp_lib_ranges)
+
+namespace std::ranges {
+
+  // A not_null_span does not own its elements, so iterators obtained from a
+  // temporary span remain valid, as with std::span
+  template <typename T, std::size_t Extent>
+  inline constexpr bool enable_borrowed_range<
+    ::NOT_NULL_NS_IMPL::not_null_span<T,Extent>
+  > = true;
+
+} // namespace std::ranges
+
+#endif
+
+//=============================================================================
+// class : not_null_span_extent
+//=============================================================================
+
+template <std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::detail::not_null_span_extent<Extent>::not_null_span_extent(std::size_t)
+  noexcept
+{
+
+}
+
+template <std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::not_null_span_extent<Extent>::size()
+  const noexcept -> std::size_t
+{
+  return Extent;
+}
+
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::detail::not_null_span_extent<NOT_NULL_NS_IMPL::dynamic_extent>::not_null_span_extent(std::size_t size)
+  noexcept
+  : m_size{size}
+{
+
+}
+
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::not_null_span_extent<NOT_NULL_NS_IMPL::dynamic_extent>::size()
+  const noexcept -> std::size_t
+{
+  return m_size;
+}
+
+//=============================================================================
+// detail utilities
+//=============================================================================
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::not_null_span_dangling()
+  noexcept -> T*
+{
+  return reinterpret_cast<T*>(alignof(T));
+}
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::not_null_span_check_data(T* data,
+                                                        std::size_t size)
+  -> not_null<T*>
+{
+  return (size == 0u)
+    ? not_null_factory::make((data == nullptr) ? not_null_span_dangling<T>() : data)
+    : check_not_null(data);
+}
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::not_null_span_assume_data(T* data,
+                                                         std::size_t size)
+  noexcept -> not_null<T*>
+{
+  return (size == 0u && data == nullptr)
+    ? not_null_factory::make(not_null_span_dangling<T>())
+    : assume_not_null(data);
+}
+
+//=============================================================================
+// class : not_null_span
+//=============================================================================
+
+template <typename T, std::size_t Extent>
+constexpr std::size_t NOT_NULL_NS_IMPL::not_null_span<T,Extent>::extent;
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+template <typename T, std::size_t Extent>
+template <std::size_t E, typename>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::not_null_span<T,Extent>::not_null_span(not_null<T*> data,
+                                                         size_type count)
+  noexcept
+  : extent_type{count},
+    m_data{data}
+{
+
+}
+
+template <typename T, std::size_t Extent>
+template <std::size_t E, typename, typename>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::not_null_span<T,Extent>::not_null_span(not_null<T*> data,
+                                                         size_type count)
+  noexcept
+  : extent_type{count},
+    m_data{data}
+{
+
+}
+
+template <typename T, std::size_t Extent>
+template <typename U, std::size_t N, typename>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::not_null_span<T,Extent>::not_null_span(U (&arr)[N])
+  noexcept
+  : extent_type{N},
+    m_data{detail::not_null_factory::make(static_cast<T*>(arr))}
+{
+
+}
+
+template <typename T, std::size_t Extent>
+template <typename U, std::size_t N, typename>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::not_null_span<T,Extent>::not_null_span(std::array<U,N>& arr)
+  noexcept
+  : extent_type{N},
+    m_data{detail::not_null_factory::make(static_cast<T*>(arr.data()))}
+{
+
+}
+
+template <typename T, std::size_t Extent>
+template <typename U, std::size_t N, typename>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::not_null_span<T,Extent>::not_null_span(const std::array<U,N>& arr)
+  noexcept
+  : extent_type{N},
+    m_data{detail::not_null_factory::make(static_cast<T*>(arr.data()))}
+{
+
+}
+
+template <typename T, std::size_t Extent>
+template <typename U, std::size_t N, typename>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::not_null_span<T,Extent>::not_null_span(const not_null_span<U,N>& other)
+  noexcept
+  : extent_type{other.size()},
+    m_data{other.data()}
+{
+
+}
+
+template <typename T, std::size_t Extent>
+template <typename U, std::size_t N, typename, typename>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::not_null_span<T,Extent>::not_null_span(const not_null_span<U,N>& other)
+  noexcept
+  : extent_type{other.size()},
+    m_data{other.data()}
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Conversions
+//-----------------------------------------------------------------------------
+
+#if defined(NOT_NULL_HAS_SPAN)
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::not_null_span<T,Extent>::operator std::span<T,Extent>()
+  const noexcept
+{
+  return std::span<T,Extent>{m_data.get(), size()};
+}
+
+#endif
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::data()
+  const noexcept -> not_null<T*>
+{
+  return m_data;
+}
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::size()
+  const noexcept -> size_type
+{
+  return extent_type::size();
+}
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::size_bytes()
+  const noexcept -> size_type
+{
+  return size() * sizeof(T);
+}
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::empty()
+  const noexcept -> bool
+{
+  return size() == 0u;
+}
+
+//-----------------------------------------------------------------------------
+// Element Access
+//-----------------------------------------------------------------------------
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::operator[](size_type index)
+  const noexcept -> reference
+{
+  return m_data.get()[index];
+}
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::front()
+  const noexcept -> reference
+{
+  return *m_data;
+}
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::back()
+  const noexcept -> reference
+{
+  return m_data.get()[size() - 1u];
+}
+
+//-----------------------------------------------------------------------------
+// Iterators
+//-----------------------------------------------------------------------------
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::begin()
+  const noexcept -> iterator
+{
+  return m_data.get();
+}
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::end()
+  const noexcept -> iterator
+{
+  return m_data.get() + size();
+}
+
+template <typename T, std::size_t Extent>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::rbegin()
+  const noexcept -> reverse_iterator
+{
+  return reverse_iterator{end()};
+}
+
+template <typename T, std::size_t Extent>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::rend()
+  const noexcept -> reverse_iterator
+{
+  return reverse_iterator{begin()};
+}
+
+//-----------------------------------------------------------------------------
+// Subviews
+//-----------------------------------------------------------------------------
+
+// Subviews point within, or one past the end of, a sequence that is already
+// known to not be null, so they are constructed without any checks
+
+template <typename T, std::size_t Extent>
+template <std::size_t Count>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::first()
+  const noexcept -> not_null_span<T,Count>
+{
+  static_assert(
+    Extent == dynamic_extent || Count <= Extent,
+    "first<Count>() cannot have more elements than the span"
+  );
+
+  return not_null_span<T,Count>{m_data, Count};
+}
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::first(size_type count)
+  const noexcept -> not_null_span<T>
+{
+  return not_null_span<T>{m_data, count};
+}
+
+template <typename T, std::size_t Extent>
+template <std::size_t Count>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::last()
+  const noexcept -> not_null_span<T,Count>
+{
+  static_assert(
+    Extent == dynamic_extent || Count <= Extent,
+    "last<Count>() cannot have more elements than the span"
+  );
+
+  return not_null_span<T,Count>{
+    detail::not_null_factory::make(m_data.get() + (size() - Count)),
+    Count
+  };
+}
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::last(size_type count)
+  const noexcept -> not_null_span<T>
+{
+  return not_null_span<T>{
+    detail::not_null_factory::make(m_data.get() + (size() - count)),
+    count
+  };
+}
+
+template <typename T, std::size_t Extent>
+template <std::size_t Offset, std::size_t Count>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::subspan()
+  const noexcept
+  -> not_null_span<T,detail::not_null_subspan_extent<Extent,Offset,Count>::value>
+{
+  static_assert(
+    Extent == dynamic_extent || Offset <= Extent,
+    "subspan<Offset,Count>() cannot start past the end of the span"
+  );
+  static_assert(
+    Extent == dynamic_extent || Count == dynamic_extent || Count <= Extent - Offset,
+    "subspan<Offset,Count>() cannot have more elements than the span"
+  );
+
+  using result_type = not_null_span<
+    T,
+    detail::not_null_subspan_extent<Extent,Offset,Count>::value
+  >;
+
+  return result_type{
+    detail::not_null_factory::make(m_data.get() + Offset),
+    (Count == dynamic_extent) ? (size() - Offset) : Count
+  };
+}
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_span<T,Extent>::subspan(size_type offset,
+                                                        size_type count)
+  const noexcept -> not_null_span<T>
+{
+  return not_null_span<T>{
+    detail::not_null_factory::make(m_data.get() + offset),
+    (count == dynamic_extent) ? (size() - offset) : count
+  };
+}
+
+//=============================================================================
+// non-member functions : class : not_null_span
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Utilities
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::check_not_null_span(T* data, std::size_t size)
+  -> not_null_span<T>
+{
+  return not_null_span<T>{detail::not_null_span_check_data(data, size), size};
+}
+
+#if defined(NOT_NULL_HAS_SPAN)
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::check_not_null_span(std::span<T,Extent> s)
+  -> not_null_span<T,Extent>
+{
+  return not_null_span<T,Extent>{
+    detail::not_null_span_check_data(s.data(), s.size()),
+    s.size()
+  };
+}
+
+#endif
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::assume_not_null_span(T* data, std::size_t size)
+  noexcept -> not_null_span<T>
+{
+  return not_null_span<T>{detail::not_null_span_assume_data(data, size), size};
+}
+
+#if defined(NOT_NULL_HAS_SPAN)
+
+template <typename T, std::size_t Extent>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::assume_not_null_span(std::span<T,Extent> s)
+  noexcept -> not_null_span<T,Extent>
+{
+  return not_null_span<T,Extent>{
+    detail::not_null_span_assume_data(s.data(), s.size()),
+    s.size()
+  };
+}
+
+#endif
+
+#endif /* CPP_BITWIZESHIFT_NOT_NULL_SPAN_HPP */
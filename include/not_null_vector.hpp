@@ -0,0 +1,966 @@
+/*****************************************************************************
+ * \file not_null_vector.hpp
+ *
+ * \brief This header defines a contiguous container of non-nullable
+ *        pointers
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2019 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CPP_BITWIZESHIFT_NOT_NULL_VECTOR_HPP
+#define CPP_BITWIZESHIFT_NOT_NULL_VECTOR_HPP
+
+#include "not_null.hpp"
+
+#include <cstddef>     // std::size_t
+#include <iterator>    // std::iterator_traits, std::make_move_iterator
+#include <memory>      // std::allocator
+#include <type_traits> // std::is_pointer
+#include <utility>     // std::move
+#include <vector>      // std::vector
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+  template <typename T, typename Allocator = std::allocator<T>>
+  class not_null_vector;
+
+  template <typename T, typename Allocator>
+  auto check_not_null_vector(std::vector<T,Allocator> v)
+    -> not_null_vector<T,Allocator>;
+
+  template <typename T, typename Allocator>
+  auto assume_not_null_vector(std::vector<T,Allocator> v)
+    noexcept -> not_null_vector<T,Allocator>;
+
+  namespace detail {
+
+    /// \brief Queries whether any element in the range [first, last) is
+    ///        null, without modifying the range
+    ///
+    /// \param first the start of the range
+    /// \param last the end of the range
+    /// \return `true` if any element is null
+    template <typename ForwardIt>
+    auto range_contains_null(ForwardIt first, ForwardIt last) -> bool;
+
+  } // namespace detail
+
+  //===========================================================================
+  // class : not_null_vector
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief A contiguous container of `not_null<T>` pointers
+  ///
+  /// Internally, this stores a `std::vector<T>` of the nullable pointers,
+  /// and views its storage as `not_null<T>` elements in-place (see
+  /// `assume_not_null_range`). This allows elements to be inserted in bulk
+  /// from nullable sources with a single check for the whole batch, and to
+  /// be accessed as `not_null` without any checks -- while remaining as
+  /// compact and as fast to iterate as a `std::vector<T>`.
+  ///
+  /// All insertions from nullable sources are either `checked` or `assumed`,
+  /// mirroring `check_not_null` and `assume_not_null`.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// auto widgets = not_null_vector<std::unique_ptr<Widget>>{};
+  ///
+  /// // Checks the whole batch once
+  /// widgets.append_checked(
+  ///   std::make_move_iterator(legacy.begin()),
+  ///   std::make_move_iterator(legacy.end())
+  /// );
+  ///
+  /// for (const auto& w : widgets) {
+  ///   w->draw(); // no null checks
+  /// }
+  /// ```
+  ///
+  /// \tparam T the underlying nullable pointer type
+  /// \tparam Allocator the allocator for the underlying storage
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T, typename Allocator>
+  class not_null_vector
+  {
+    //-------------------------------------------------------------------------
+    // Public Member Types
+    //-------------------------------------------------------------------------
+  public:
+
+    using value_type      = not_null<T>;
+    using nullable_type   = std::vector<T,Allocator>;
+    using allocator_type  = Allocator;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using iterator        = value_type*;
+    using const_iterator  = const value_type*;
+    using pointer         = typename value_type::pointer;
+
+    //-------------------------------------------------------------------------
+    // Constructors / Assignment
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Constructs an empty not_null_vector
+    not_null_vector() = default;
+
+    /// \brief Constructs an empty not_null_vector that uses \p alloc for its
+    ///        storage
+    ///
+    /// \param alloc the allocator to use
+    explicit not_null_vector(const Allocator& alloc);
+
+    not_null_vector(const not_null_vector& other) = default;
+    not_null_vector(not_null_vector&& other) = default;
+
+    //-------------------------------------------------------------------------
+
+    auto operator=(const not_null_vector& other) -> not_null_vector& = default;
+    auto operator=(not_null_vector&& other) -> not_null_vector& = default;
+
+    //-------------------------------------------------------------------------
+    // Element Access
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \{
+    /// \brief Accesses the element at index \p n, without bounds checking
+    ///
+    /// \param n the index of the element
+    /// \return reference to the element
+    auto operator[](size_type n) noexcept -> reference;
+    auto operator[](size_type n) const noexcept -> const_reference;
+    /// \}
+
+    /// \brief Gets the raw pointer of the element at index \p n, without
+    ///        bounds checking
+    ///
+    /// This is equivalent to `(*this)[n].get()`, retaining the non-null
+    /// guarantee in the type.
+    ///
+    /// \param n the index of the element
+    /// \return the underlying raw pointer of the element
+    auto get(size_type n) const noexcept -> not_null<pointer>;
+
+    /// \{
+    /// \brief Accesses the first element
+    ///
+    /// \pre `!empty()`
+    /// \return reference to the first element
+    auto front() noexcept -> reference;
+    auto front() const noexcept -> const_reference;
+    /// \}
+
+    /// \{
+    /// \brief Accesses the last element
+    ///
+    /// \pre `!empty()`
+    /// \return reference to the last element
+    auto back() noexcept -> reference;
+    auto back() const noexcept -> const_reference;
+    /// \}
+
+    /// \{
+    /// \brief Gets a pointer to the contiguous storage of not_null elements
+    ///
+    /// \return pointer to the first element
+    auto data() noexcept -> value_type*;
+    auto data() const noexcept -> const value_type*;
+    /// \}
+
+    //-------------------------------------------------------------------------
+    // Iterators
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \{
+    /// \brief Gets an iterator to the first element
+    ///
+    /// \return an iterator to the first element
+    auto begin() noexcept -> iterator;
+    auto begin() const noexcept -> const_iterator;
+    auto cbegin() const noexcept -> const_iterator;
+    /// \}
+
+    /// \{
+    /// \brief Gets an iterator past the last element
+    ///
+    /// \return an iterator past the last element
+    auto end() noexcept -> iterator;
+    auto end() const noexcept -> const_iterator;
+    auto cend() const noexcept -> const_iterator;
+    /// \}
+
+    //-------------------------------------------------------------------------
+    // Capacity
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Queries whether this container is empty
+    ///
+    /// \return `true` if this contains no elements
+    auto empty() const noexcept -> bool;
+
+    /// \brief Gets the number of elements in this container
+    ///
+    /// \return the number of elements
+    auto size() const noexcept -> size_type;
+
+    /// \brief Gets the number of elements that can be held without
+    ///        reallocating
+    ///
+    /// \return the capacity
+    auto capacity() const noexcept -> size_type;
+
+    /// \brief Reserves storage for at least \p n elements
+    ///
+    /// \param n the number of elements to reserve
+    auto reserve(size_type n) -> void;
+
+    /// \brief Reduces the capacity to fit the size
+    auto shrink_to_fit() -> void;
+
+    //-------------------------------------------------------------------------
+    // Modifiers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \{
+    /// \brief Appends a single not_null element
+    ///
+    /// \param p the element to append
+    auto push_back(const value_type& p) -> void;
+    auto push_back(value_type&& p) -> void;
+    /// \}
+
+    /// \brief Appends the nullable pointers in the range [first, last),
+    ///        checking that none of them are null
+    ///
+    /// If any pointer is null, the contract violation is raised and the
+    /// contents of this container are left unmodified (the strong exception
+    /// guarantee):
+    ///
+    /// * For forward iterators, the range is checked in full before anything
+    ///   is inserted. On violation, nothing has been read out of the range,
+    ///   so no element of a `std::move_iterator` range has been moved from.
+    /// * For input iterators, the range can only be read once, so it is
+    ///   first read into temporary storage and checked there. On violation,
+    ///   elements that were moved out of the range are destroyed with the
+    ///   temporary storage.
+    ///
+    /// \throw not_null_contract_violation if any pointer in the range is
+    ///        null
+    /// \param first the start of the range
+    /// \param last the end of the range
+    template <typename InputIt>
+    auto append_checked(InputIt first, InputIt last) -> void;
+
+    /// \brief Appends the nullable pointers in the range [first, last),
+    ///        *assuming* that none of them are null
+    ///
+    /// Like `assume_not_null`, it is up to the user to guarantee that no
+    /// element of the range is null; otherwise the behavior is undefined.
+    ///
+    /// \param first the start of the range
+    /// \param last the end of the range
+    template <typename InputIt>
+    auto append_assumed(InputIt first, InputIt last) -> void;
+
+    /// \brief Replaces the contents with the nullable pointers in the range
+    ///        [first, last), checking that none of them are null
+    ///
+    /// If any pointer is null, the contract violation is raised and the
+    /// previous contents of this container are left unmodified (the strong
+    /// exception guarantee). This is checked in the same way as for
+    /// `append_checked`: forward ranges are checked before anything is
+    /// assigned, and input ranges are read into temporary storage that
+    /// replaces the contents only once it has been checked.
+    ///
+    /// \throw not_null_contract_violation if any pointer in the range is
+    ///        null
+    /// \param first the start of the range
+    /// \param last the end of the range
+    template <typename InputIt>
+    auto assign_checked(InputIt first, InputIt last) -> void;
+
+    /// \brief Replaces the contents with the nullable pointers in the range
+    ///        [first, last), *assuming* that none of them are null
+    ///
+    /// \param first the start of the range
+    /// \param last the end of the range
+    template <typename InputIt>
+    auto assign_assumed(InputIt first, InputIt last) -> void;
+
+    /// \brief Resizes this container to contain \p n elements, appending
+    ///        copies of \p p if this grows
+    ///
+    /// \param n the new size
+    /// \param p the value to append
+    auto resize(size_type n, const value_type& p) -> void;
+
+    /// \brief Removes the last element
+    ///
+    /// \pre `!empty()`
+    auto pop_back() -> void;
+
+    /// \{
+    /// \brief Removes the element(s) at \p pos or in [first, last)
+    ///
+    /// \return an iterator following the last removed element
+    auto erase(const_iterator pos) -> iterator;
+    auto erase(const_iterator first, const_iterator last) -> iterator;
+    /// \}
+
+    /// \brief Removes all elements
+    auto clear() noexcept -> void;
+
+    /// \brief Swaps the contents of this with \p other
+    ///
+    /// \param other the other container to swap with
+    auto swap(not_null_vector& other) noexcept -> void;
+
+    //-------------------------------------------------------------------------
+    // Observers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \{
+    /// \brief Extracts the underlying vector of nullable pointers
+    ///
+    /// \note The r-value overload steals the underlying storage, leaving
+    ///       this container empty.
+    ///
+    /// \return the underlying vector
+    auto as_nullable() const & noexcept -> const nullable_type&;
+    auto as_nullable() && noexcept -> nullable_type&&;
+    /// \}
+
+    /// \brief Gets the allocator of the underlying storage
+    ///
+    /// \return the allocator
+    auto get_allocator() const -> allocator_type;
+
+    //-------------------------------------------------------------------------
+    // Private Members
+    //-------------------------------------------------------------------------
+  private:
+
+    nullable_type m_storage;
+
+    //-------------------------------------------------------------------------
+    // Private Modifiers
+    //-------------------------------------------------------------------------
+  private:
+
+    template <typename ForwardIt>
+    auto append_checked(ForwardIt first, ForwardIt last,
+                        std::forward_iterator_tag) -> void;
+    template <typename InputIt>
+    auto append_checked(InputIt first, InputIt last,
+                        std::input_iterator_tag) -> void;
+
+    template <typename ForwardIt>
+    auto assign_checked(ForwardIt first, ForwardIt last,
+                        std::forward_iterator_tag) -> void;
+    template <typename InputIt>
+    auto assign_checked(InputIt first, InputIt last,
+                        std::input_iterator_tag) -> void;
+
+    //-------------------------------------------------------------------------
+    // Private Constructors
+    //-------------------------------------------------------------------------
+  private:
+
+    struct ctor_tag{};
+
+    not_null_vector(ctor_tag, nullable_type&& storage) noexcept;
+
+    template <typename U, typename A>
+    friend auto check_not_null_vector(std::vector<U,A> v)
+      -> not_null_vector<U,A>;
+
+    template <typename U, typename A>
+    friend auto assume_not_null_vector(std::vector<U,A> v)
+      noexcept -> not_null_vector<U,A>;
+  };
+
+  //===========================================================================
+  // non-member functions : class : not_null_vector
+  //===========================================================================
+
+  //---------------------------------------------------------------------------
+  // Utilities
+  //---------------------------------------------------------------------------
+
+  /// \brief Adopts a vector of nullable pointers as a `not_null_vector`,
+  ///        checking that none of them are null first
+  ///
+  /// The storage of \p v is moved into the result; no element is moved or
+  /// copied.
+  ///
+  /// \throw not_null_contract_violation if any pointer in \p v is null
+  /// \param v the vector to adopt
+  /// \return a not_null_vector containing the elements of \p v
+  template <typename T, typename Allocator>
+  auto check_not_null_vector(std::vector<T,Allocator> v)
+    -> not_null_vector<T,Allocator>;
+
+  /// \brief Adopts a vector of nullable pointers as a `not_null_vector`,
+  ///        *assuming* that none of them are null
+  ///
+  /// \param v the vector to adopt
+  /// \return a not_null_vector containing the elements of \p v
+  template <typename T, typename Allocator>
+  auto assume_not_null_vector(std::vector<T,Allocator> v)
+    noexcept -> not_null_vector<T,Allocator>;
+
+  /// \brief Swaps the contents of \p lhs and \p rhs
+  ///
+  /// \param lhs the left container to swap
+  /// \param rhs the right container to swap
+  template <typename T, typename Allocator>
+  auto swap(not_null_vector<T,Allocator>& lhs,
+            not_null_vector<T,Allocator>& rhs) noexcept -> void;
+
+  //---------------------------------------------------------------------------
+  // Comparisons
+  //---------------------------------------------------------------------------
+
+  template <typename T, typename Allocator>
+  auto operator==(const not_null_vector<T,Allocator>& lhs,
+                  const not_null_vector<T,Allocator>& rhs) -> bool;
+  template <typename T, typename Allocator>
+  auto operator!=(const not_null_vector<T,Allocator>& lhs,
+                  const not_null_vector<T,Allocator>& rhs) -> bool;
+
+} // inline namespace bitwizeshift
+} // namespace cpp
+
+//=============================================================================
+// class : not_null_vector
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Allocator>
+inline
+NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::not_null_vector(const Allocator& alloc)
+  : m_storage(alloc)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Element Access
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::operator[](size_type n)
+  noexcept -> reference
+{
+  return data()[n];
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::operator[](size_type n)
+  const noexcept -> const_reference
+{
+  return data()[n];
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::get(size_type n)
+  const noexcept -> not_null<pointer>
+{
+  return detail::not_null_factory::make(data()[n].get());
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::front()
+  noexcept -> reference
+{
+  return data()[0];
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::front()
+  const noexcept -> const_reference
+{
+  return data()[0];
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::back()
+  noexcept -> reference
+{
+  return data()[size() - 1u];
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::back()
+  const noexcept -> const_reference
+{
+  return data()[size() - 1u];
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::data()
+  noexcept -> value_type*
+{
+  return assume_not_null_range(m_storage.data(), m_storage.size());
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::data()
+  const noexcept -> const value_type*
+{
+  return assume_not_null_range(m_storage.data(), m_storage.size());
+}
+
+//-----------------------------------------------------------------------------
+// Iterators
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::begin()
+  noexcept -> iterator
+{
+  return data();
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::begin()
+  const noexcept -> const_iterator
+{
+  return data();
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::cbegin()
+  const noexcept -> const_iterator
+{
+  return data();
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::end()
+  noexcept -> iterator
+{
+  return data() + size();
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::end()
+  const noexcept -> const_iterator
+{
+  return data() + size();
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::cend()
+  const noexcept -> const_iterator
+{
+  return data() + size();
+}
+
+//-----------------------------------------------------------------------------
+// Capacity
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::empty()
+  const noexcept -> bool
+{
+  return m_storage.empty();
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::size()
+  const noexcept -> size_type
+{
+  return m_storage.size();
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::capacity()
+  const noexcept -> size_type
+{
+  return m_storage.capacity();
+}
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::reserve(size_type n)
+  -> void
+{
+  m_storage.reserve(n);
+}
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::shrink_to_fit()
+  -> void
+{
+  m_storage.shrink_to_fit();
+}
+
+//-----------------------------------------------------------------------------
+// Modifiers
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::push_back(const value_type& p)
+  -> void
+{
+  m_storage.push_back(p.as_nullable());
+}
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::push_back(value_type&& p)
+  -> void
+{
+  m_storage.push_back(std::move(p).as_nullable());
+}
+
+template <typename T, typename Allocator>
+template <typename InputIt>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::append_checked(InputIt first,
+                                                                    InputIt last)
+  -> void
+{
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+
+  append_checked(first, last, category{});
+}
+
+template <typename T, typename Allocator>
+template <typename InputIt>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::append_assumed(InputIt first,
+                                                                    InputIt last)
+  -> void
+{
+  m_storage.insert(m_storage.end(), first, last);
+}
+
+template <typename T, typename Allocator>
+template <typename InputIt>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::assign_checked(InputIt first,
+                                                                    InputIt last)
+  -> void
+{
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+
+  assign_checked(first, last, category{});
+}
+
+template <typename T, typename Allocator>
+template <typename InputIt>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::assign_assumed(InputIt first,
+                                                                    InputIt last)
+  -> void
+{
+  m_storage.assign(first, last);
+}
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::resize(size_type n,
+                                                            const value_type& p)
+  -> void
+{
+  m_storage.resize(n, p.as_nullable());
+}
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::pop_back()
+  -> void
+{
+  m_storage.pop_back();
+}
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::erase(const_iterator pos)
+  -> iterator
+{
+  return erase(pos, pos + 1);
+}
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::erase(const_iterator first,
+                                                           const_iterator last)
+  -> iterator
+{
+  const auto offset = first - cbegin();
+  const auto count = last - first;
+  const auto it = m_storage.begin() + offset;
+
+  m_storage.erase(it, it + count);
+
+  return begin() + offset;
+}
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::clear()
+  noexcept -> void
+{
+  m_storage.clear();
+}
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::swap(not_null_vector& other)
+  noexcept -> void
+{
+  m_storage.swap(other.m_storage);
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::as_nullable()
+  const & noexcept -> const nullable_type&
+{
+  return m_storage;
+}
+
+template <typename T, typename Allocator>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::as_nullable()
+  && noexcept -> nullable_type&&
+{
+  return static_cast<nullable_type&&>(m_storage);
+}
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::get_allocator()
+  const -> allocator_type
+{
+  return m_storage.get_allocator();
+}
+
+//-----------------------------------------------------------------------------
+// Private Modifiers
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Allocator>
+template <typename ForwardIt>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::append_checked(ForwardIt first,
+                                                                    ForwardIt last,
+                                                                    std::forward_iterator_tag)
+  -> void
+{
+  // The range is checked without reading anything out of it, so that nothing
+  // is moved from a 'std::move_iterator' range on violation
+  if (NOT_NULL_UNLIKELY(detail::range_contains_null(first, last))) {
+    detail::throw_null_pointer_error();
+  }
+  m_storage.insert(m_storage.end(), first, last);
+}
+
+template <typename T, typename Allocator>
+template <typename InputIt>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::append_checked(InputIt first,
+                                                                    InputIt last,
+                                                                    std::input_iterator_tag)
+  -> void
+{
+  auto storage = nullable_type(first, last, m_storage.get_allocator());
+
+  if (NOT_NULL_UNLIKELY(detail::contains_null(storage.data(), storage.size()))) {
+    detail::throw_null_pointer_error();
+  }
+  m_storage.insert(
+    m_storage.end(),
+    std::make_move_iterator(storage.begin()),
+    std::make_move_iterator(storage.end())
+  );
+}
+
+template <typename T, typename Allocator>
+template <typename ForwardIt>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::assign_checked(ForwardIt first,
+                                                                    ForwardIt last,
+                                                                    std::forward_iterator_tag)
+  -> void
+{
+  if (NOT_NULL_UNLIKELY(detail::range_contains_null(first, last))) {
+    detail::throw_null_pointer_error();
+  }
+  m_storage.assign(first, last);
+}
+
+template <typename T, typename Allocator>
+template <typename InputIt>
+inline
+auto NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::assign_checked(InputIt first,
+                                                                    InputIt last,
+                                                                    std::input_iterator_tag)
+  -> void
+{
+  auto storage = nullable_type(first, last, m_storage.get_allocator());
+
+  if (NOT_NULL_UNLIKELY(detail::contains_null(storage.data(), storage.size()))) {
+    detail::throw_null_pointer_error();
+  }
+  m_storage.swap(storage);
+}
+
+//-----------------------------------------------------------------------------
+// Private Constructors
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Allocator>
+inline
+NOT_NULL_NS_IMPL::not_null_vector<T,Allocator>::not_null_vector(ctor_tag,
+                                                                nullable_type&& storage)
+  noexcept
+  : m_storage(std::move(storage))
+{
+
+}
+
+//=============================================================================
+// non-member functions : class : not_null_vector
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Utilities
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::check_not_null_vector(std::vector<T,Allocator> v)
+  -> not_null_vector<T,Allocator>
+{
+  if (NOT_NULL_UNLIKELY(detail::contains_null(v.data(), v.size()))) {
+    detail::throw_null_pointer_error();
+  }
+  return assume_not_null_vector(std::move(v));
+}
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::assume_not_null_vector(std::vector<T,Allocator> v)
+  noexcept -> not_null_vector<T,Allocator>
+{
+  using result_type = not_null_vector<T,Allocator>;
+
+  return result_type{typename result_type::ctor_tag{}, std::move(v)};
+}
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::swap(not_null_vector<T,Allocator>& lhs,
+                            not_null_vector<T,Allocator>& rhs)
+  noexcept -> void
+{
+  lhs.swap(rhs);
+}
+
+//-----------------------------------------------------------------------------
+// Comparisons
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::operator==(const not_null_vector<T,Allocator>& lhs,
+                                  const not_null_vector<T,Allocator>& rhs)
+  -> bool
+{
+  return lhs.as_nullable() == rhs.as_nullable();
+}
+
+template <typename T, typename Allocator>
+inline
+auto NOT_NULL_NS_IMPL::operator!=(const not_null_vector<T,Allocator>& lhs,
+                                  const not_null_vector<T,Allocator>& rhs)
+  -> bool
+{
+  return lhs.as_nullable() != rhs.as_nullable();
+}
+
+//=============================================================================
+// detail utilities
+//=============================================================================
+
+template <typename ForwardIt>
+inline
+auto NOT_NULL_NS_IMPL::detail::range_contains_null(ForwardIt first,
+                                                   ForwardIt last)
+  -> bool
+{
+  // Accumulated without branching on each element, like 'contains_null', so
+  // that this may be vectorized
+  auto nulls = false;
+  for (; first != last; ++first) {
+    nulls |= (*first == nullptr);
+  }
+  return nulls;
+}
+
+#endif /* CPP_BITWIZESHIFT_NOT_NULL_VECTOR_HPP */
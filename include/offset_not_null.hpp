@@ -0,0 +1,506 @@
+/*****************************************************************************
+ * \file offset_not_null.hpp
+ *
+ * \brief This header defines a self-relative non-nullable pointer that
+ *        remains valid when the memory containing it is relocated
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2019 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CPP_BITWIZESHIFT_OFFSET_NOT_NULL_HPP
+#define CPP_BITWIZESHIFT_OFFSET_NOT_NULL_HPP
+
+#include "not_null.hpp"
+
+#include <cstdint>     // std::int32_t, std::intptr_t, std::uintptr_t
+#include <type_traits> // std::is_integral, std::is_signed
+#if !defined(NDEBUG)
+# include <cstdio>     // std::fprintf
+# include <cstdlib>    // std::abort
+# include <limits>     // std::numeric_limits
+#endif
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+  //===========================================================================
+  // class : offset_not_null
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief A non-nullable pointer that stores the distance from its own
+  ///        address to the object it points to
+  ///
+  /// Since the pointee is found relative to the `offset_not_null` itself,
+  /// a graph of objects connected by `offset_not_null` remains valid when
+  /// the block of memory containing both is mapped at a different address,
+  /// such as a memory-mapped file or a shared-memory segment. No fix-ups or
+  /// deserialization are required when loading such a block.
+  ///
+  /// Copying an `offset_not_null` recomputes the offset for the address of
+  /// the copy, so that the copy points to the same object. Consequently this
+  /// type is not trivially copyable; it must not be copied with `memcpy`
+  /// except as part of relocating the entire block that also contains the
+  /// pointee.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// struct node {
+  ///   cpp::offset_not_null<const node> next;
+  ///   int value;
+  /// };
+  ///
+  /// const auto* root = static_cast<const node*>(mmap(...));
+  ///
+  /// use(root->next->value); // no pointer fix-ups required
+  /// ```
+  ///
+  /// \pre The distance, in bytes, between an `offset_not_null` and the object
+  ///      it points to must be representable by `Offset`. Unless `NDEBUG` is
+  ///      defined, this is checked whenever the offset is computed; a
+  ///      violation is reported to the installed violation handler, and then
+  ///      aborts. Otherwise the offset silently wraps.
+  ///
+  /// \tparam T the type of the object being pointed to
+  /// \tparam Offset the signed integral type used to store the distance
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T, typename Offset = std::int32_t>
+  class offset_not_null
+  {
+    static_assert(
+      std::is_integral<Offset>::value && std::is_signed<Offset>::value,
+      "Offset must be a signed integral type"
+    );
+    static_assert(
+      sizeof(Offset) <= sizeof(std::intptr_t),
+      "Offset must not be wider than a pointer"
+    );
+
+    //-------------------------------------------------------------------------
+    // Public Member Types
+    //-------------------------------------------------------------------------
+  public:
+
+    using element_type = T;
+    using pointer      = T*;
+    using offset_type  = Offset;
+
+    //-------------------------------------------------------------------------
+    // Constructors / Assignment
+    //-------------------------------------------------------------------------
+  public:
+
+    // offset_not_null is not default-constructible, since it must point
+    // somewhere
+    offset_not_null() = delete;
+
+    /// \brief Constructs an offset_not_null that points to the same object
+    ///        as \p p
+    ///
+    /// \param p the pointer to refer to
+    offset_not_null(not_null<T*> p) noexcept;
+
+    /// \brief Constructs an offset_not_null that points to the same object
+    ///        as \p other
+    ///
+    /// \param other the other offset_not_null to copy
+    offset_not_null(const offset_not_null& other) noexcept;
+
+    //-------------------------------------------------------------------------
+
+    /// \brief Points this offset_not_null to the same object as \p p
+    ///
+    /// \param p the pointer to refer to
+    /// \return reference to `(*this)`
+    auto operator=(not_null<T*> p) noexcept -> offset_not_null&;
+
+    /// \brief Points this offset_not_null to the same object as \p other
+    ///
+    /// \param other the other offset_not_null to copy
+    /// \return reference to `(*this)`
+    auto operator=(const offset_not_null& other) noexcept -> offset_not_null&;
+
+    //-------------------------------------------------------------------------
+    // Observers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Gets the address of the object being pointed to
+    ///
+    /// \return the underlying pointer
+    auto get() const noexcept -> pointer;
+
+    /// \brief Gets the address of the object being pointed to as a not_null
+    ///
+    /// \return the underlying pointer
+    auto as_not_null() const noexcept -> not_null<pointer>;
+
+    /// \brief Gets the distance in bytes from this offset_not_null to the
+    ///        object being pointed to
+    ///
+    /// \return the offset
+    constexpr auto offset() const noexcept -> offset_type;
+
+    //-------------------------------------------------------------------------
+
+    /// \brief Dereferences the underlying pointer
+    ///
+    /// \return the underlying pointer
+    auto operator->() const noexcept -> pointer;
+
+    /// \brief Dereferences the underlying pointer
+    ///
+    /// \return reference to the underlying object
+    auto operator*() const noexcept -> T&;
+
+    //-------------------------------------------------------------------------
+    // Private Member Functions
+    //-------------------------------------------------------------------------
+  private:
+
+    /// \brief Computes the offset from this object to \p p
+    ///
+    /// Unless `NDEBUG` is defined, this aborts if the offset is not
+    /// representable by `offset_type`.
+    auto offset_to(const volatile void* p) const noexcept -> offset_type;
+
+    //-------------------------------------------------------------------------
+    // Private Members
+    //-------------------------------------------------------------------------
+  private:
+
+    offset_type m_offset;
+  };
+
+  //===========================================================================
+  // non-member functions : class : offset_not_null
+  //===========================================================================
+
+  //---------------------------------------------------------------------------
+  // Comparisons
+  //---------------------------------------------------------------------------
+
+  template <typename T, typename O1, typename U, typename O2>
+  auto operator==(const offset_not_null<T,O1>& lhs,
+                  const offset_not_null<U,O2>& rhs) noexcept -> bool;
+  template <typename T, typename O1, typename U, typename O2>
+  auto operator!=(const offset_not_null<T,O1>& lhs,
+                  const offset_not_null<U,O2>& rhs) noexcept -> bool;
+  template <typename T, typename O1, typename U, typename O2>
+  auto operator<(const offset_not_null<T,O1>& lhs,
+                 const offset_not_null<U,O2>& rhs) noexcept -> bool;
+  template <typename T, typename O1, typename U, typename O2>
+  auto operator>(const offset_not_null<T,O1>& lhs,
+                 const offset_not_null<U,O2>& rhs) noexcept -> bool;
+  template <typename T, typename O1, typename U, typename O2>
+  auto operator<=(const offset_not_null<T,O1>& lhs,
+                  const offset_not_null<U,O2>& rhs) noexcept -> bool;
+  template <typename T, typename O1, typename U, typename O2>
+  auto operator>=(const offset_not_null<T,O1>& lhs,
+                  const offset_not_null<U,O2>& rhs) noexcept -> bool;
+
+  //---------------------------------------------------------------------------
+
+  template <typename T, typename Offset, typename U>
+  auto operator==(const offset_not_null<T,Offset>& lhs,
+                  const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U, typename Offset>
+  auto operator==(const not_null<T>& lhs,
+                  const offset_not_null<U,Offset>& rhs) noexcept -> bool;
+  template <typename T, typename Offset, typename U>
+  auto operator!=(const offset_not_null<T,Offset>& lhs,
+                  const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U, typename Offset>
+  auto operator!=(const not_null<T>& lhs,
+                  const offset_not_null<U,Offset>& rhs) noexcept -> bool;
+
+  //===========================================================================
+  // detail utilities
+  //===========================================================================
+
+#if !defined(NDEBUG)
+  namespace detail {
+
+    /// \brief Reports an offset that is not representable by the `Offset`
+    ///        of an `offset_not_null`, and aborts
+    template <typename = void>
+    [[noreturn]] NOT_NULL_COLD auto offset_out_of_range_error() noexcept -> void;
+
+  } // namespace detail
+#endif
+
+} // inline namespace bitwizeshift
+} // namespace cpp
+
+//=============================================================================
+// class : offset_not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Offset>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::offset_not_null<T,Offset>::offset_not_null(not_null<T*> p)
+  noexcept
+  : m_offset(offset_to(p.get()))
+{
+
+}
+
+template <typename T, typename Offset>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::offset_not_null<T,Offset>::offset_not_null(const offset_not_null& other)
+  noexcept
+  : m_offset(offset_to(other.get()))
+{
+
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Offset>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::offset_not_null<T,Offset>::operator=(not_null<T*> p)
+  noexcept -> offset_not_null&
+{
+  m_offset = offset_to(p.get());
+  return (*this);
+}
+
+template <typename T, typename Offset>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::offset_not_null<T,Offset>::operator=(const offset_not_null& other)
+  noexcept -> offset_not_null&
+{
+  m_offset = offset_to(other.get());
+  return (*this);
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Offset>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::offset_not_null<T,Offset>::get()
+  const noexcept -> pointer
+{
+  // The address is computed with unsigned integer arithmetic, since the
+  // pointee is generally not part of the same array as this object
+  const auto self = reinterpret_cast<std::uintptr_t>(this);
+  const auto address = self + static_cast<std::uintptr_t>(
+    static_cast<std::intptr_t>(m_offset)
+  );
+
+  return detail::mark_nonnull(reinterpret_cast<pointer>(address));
+}
+
+template <typename T, typename Offset>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::offset_not_null<T,Offset>::as_not_null()
+  const noexcept -> not_null<pointer>
+{
+  return detail::not_null_factory::make(get());
+}
+
+template <typename T, typename Offset>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::offset_not_null<T,Offset>::offset()
+  const noexcept -> offset_type
+{
+  return m_offset;
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Offset>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::offset_not_null<T,Offset>::operator->()
+  const noexcept -> pointer
+{
+  return get();
+}
+
+template <typename T, typename Offset>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::offset_not_null<T,Offset>::operator*()
+  const noexcept -> T&
+{
+  return *get();
+}
+
+//-----------------------------------------------------------------------------
+// Private Member Functions
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Offset>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::offset_not_null<T,Offset>::offset_to(const volatile void* p)
+  const noexcept -> offset_type
+{
+  const auto self = reinterpret_cast<std::uintptr_t>(this);
+  const auto target = reinterpret_cast<std::uintptr_t>(p);
+  const auto offset = static_cast<std::intptr_t>(target - self);
+
+#if !defined(NDEBUG)
+  if (NOT_NULL_UNLIKELY(offset < std::intptr_t{(std::numeric_limits<offset_type>::min)()} ||
+                        offset > std::intptr_t{(std::numeric_limits<offset_type>::max)()})) {
+    detail::offset_out_of_range_error();
+  }
+#endif
+
+  return static_cast<offset_type>(offset);
+}
+
+//=============================================================================
+// non-member functions : class : offset_not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Comparisons
+//-----------------------------------------------------------------------------
+
+template <typename T, typename O1, typename U, typename O2>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator==(const offset_not_null<T,O1>& lhs,
+                                  const offset_not_null<U,O2>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() == rhs.get();
+}
+
+template <typename T, typename O1, typename U, typename O2>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator!=(const offset_not_null<T,O1>& lhs,
+                                  const offset_not_null<U,O2>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() != rhs.get();
+}
+
+template <typename T, typename O1, typename U, typename O2>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator<(const offset_not_null<T,O1>& lhs,
+                                 const offset_not_null<U,O2>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() < rhs.get();
+}
+
+template <typename T, typename O1, typename U, typename O2>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator>(const offset_not_null<T,O1>& lhs,
+                                 const offset_not_null<U,O2>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() > rhs.get();
+}
+
+template <typename T, typename O1, typename U, typename O2>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator<=(const offset_not_null<T,O1>& lhs,
+                                  const offset_not_null<U,O2>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() <= rhs.get();
+}
+
+template <typename T, typename O1, typename U, typename O2>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator>=(const offset_not_null<T,O1>& lhs,
+                                  const offset_not_null<U,O2>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() >= rhs.get();
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T, typename Offset, typename U>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator==(const offset_not_null<T,Offset>& lhs,
+                                  const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() == rhs.get();
+}
+
+template <typename T, typename U, typename Offset>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator==(const not_null<T>& lhs,
+                                  const offset_not_null<U,Offset>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() == rhs.get();
+}
+
+template <typename T, typename Offset, typename U>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator!=(const offset_not_null<T,Offset>& lhs,
+                                  const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() != rhs.get();
+}
+
+template <typename T, typename U, typename Offset>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator!=(const not_null<T>& lhs,
+                                  const offset_not_null<U,Offset>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() != rhs.get();
+}
+
+#if !defined(NDEBUG)
+
+//=============================================================================
+// detail utilities
+//=============================================================================
+
+template <typename>
+auto NOT_NULL_NS_IMPL::detail::offset_out_of_range_error()
+  noexcept -> void
+{
+  const auto handler = get_not_null_violation_handler();
+  if (handler != nullptr) {
+    handler(not_null_call_site{nullptr, 0u, nullptr});
+  }
+
+  std::fprintf(
+    stderr,
+    "offset_not_null points to an object whose distance is not "
+    "representable by its offset type\n"
+  );
+  std::abort();
+}
+
+#endif // !defined(NDEBUG)
+
+#endif /* CPP_BITWIZESHIFT_OFFSET_NOT_NULL_HPP */
@@ -0,0 +1,972 @@
+/*****************************************************************************
+ * \file optional_not_null.hpp
+ *
+ * \brief This header defines an optional non-nullable pointer that uses the
+ *        null state of the pointer to represent the empty state
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2019 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CPP_BITWIZESHIFT_OPTIONAL_NOT_NULL_HPP
+#define CPP_BITWIZESHIFT_OPTIONAL_NOT_NULL_HPP
+
+#include "not_null.hpp"
+
+#include <cstddef>     // std::nullptr_t
+#include <type_traits> // std::enable_if, std::is_constructible, std::decay
+#include <utility>     // std::move, std::declval
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+  template <typename T>
+  class optional_not_null;
+
+  namespace detail {
+
+    struct optional_not_null_factory
+    {
+      template <typename T>
+      static constexpr auto make(T&& p) -> optional_not_null<typename std::decay<T>::type>;
+    };
+
+    template <typename F, typename Arg>
+    using optional_not_null_invoke_result = typename std::decay<
+      decltype(std::declval<F>()(std::declval<Arg>()))
+    >::type;
+
+    template <typename T>
+    struct is_optional_not_null : std::false_type{};
+    template <typename T>
+    struct is_optional_not_null<optional_not_null<T>> : std::true_type{};
+
+    /// \brief Determines the result of `optional_not_null::transform` for a
+    ///        function that returns \p T
+    template <typename T>
+    struct optional_not_null_transform_result
+    {
+      static_assert(
+        is_not_null<T>::value,
+        "transform requires a function that returns a not_null; use and_then "
+        "with a function that returns an optional_not_null instead"
+      );
+    };
+
+    template <typename T>
+    struct optional_not_null_transform_result<not_null<T>>
+    {
+      using type = optional_not_null<T>;
+    };
+
+  } // namespace detail
+
+  //===========================================================================
+  // class : optional_not_null
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief An optional `not_null<T>` that is the same size as `T`
+  ///
+  /// Since a `not_null<T>` can never contain a null pointer, the null state
+  /// of `T` is free to be used to represent the empty state of an optional.
+  /// This makes `optional_not_null<T>` exactly `sizeof(T)`, whereas
+  /// `std::optional<not_null<T>>` requires an additional flag (and padding).
+  ///
+  /// `optional_not_null<T>` is trivially copyable if `T` is.
+  ///
+  /// Unlike a plain nullable `T`, the only way to observe the pointer is
+  /// through a `not_null<T>`, and so the null check happens exactly once --
+  /// when asking `has_value()`.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// auto entries = std::vector<optional_not_null<Widget*>>(n);
+  ///
+  /// ...
+  ///
+  /// for (const auto& e : entries) {
+  ///   if (e.has_value()) {
+  ///     draw(*e); // 'draw' accepts a 'not_null<Widget*>'
+  ///   }
+  /// }
+  /// ```
+  ///
+  /// Validating input without exceptions:
+  ///
+  /// ```cpp
+  /// auto parse(std::unique_ptr<Record> r) -> optional_not_null<Widget*>
+  /// {
+  ///   return try_not_null(std::move(r))
+  ///     .and_then([](not_null<std::unique_ptr<Record>> r) {
+  ///       return try_not_null(find_widget(r->id));
+  ///     });
+  /// }
+  /// ```
+  ///
+  /// \tparam T the underlying pointer type
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  class optional_not_null
+  {
+    //-------------------------------------------------------------------------
+    // Public Member Types
+    //-------------------------------------------------------------------------
+  public:
+
+    using value_type = not_null<T>;
+    using pointer    = typename value_type::pointer;
+
+    //-------------------------------------------------------------------------
+    // Constructors / Assignment
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Constructs an empty optional_not_null
+    constexpr optional_not_null() noexcept;
+
+    /// \brief Constructs an empty optional_not_null
+    constexpr optional_not_null(std::nullptr_t) noexcept;
+
+    /// \brief Constructs an optional_not_null that contains a copy of \p p
+    ///
+    /// \param p the value to copy
+    constexpr optional_not_null(const value_type& p)
+      noexcept(std::is_nothrow_copy_constructible<T>::value);
+
+    /// \brief Constructs an optional_not_null that contains \p p
+    ///
+    /// \param p the value to move
+    NOT_NULL_CPP14_CONSTEXPR optional_not_null(value_type&& p)
+      noexcept(std::is_nothrow_move_constructible<T>::value);
+
+    /// \brief Constructs an optional_not_null by converting the contents of
+    ///        an optional_not_null with a different underlying pointer
+    ///
+    /// \note This constructor only participates in overload resolution if
+    ///       `std::is_constructible<T,U&&>::value` is `true`
+    ///
+    /// \param other the other optional_not_null to convert
+    template <typename U,
+              typename = typename std::enable_if<std::is_constructible<T,U&&>::value>::type>
+    NOT_NULL_CPP14_CONSTEXPR optional_not_null(optional_not_null<U>&& other)
+      noexcept(std::is_nothrow_constructible<T,U&&>::value);
+
+    optional_not_null(const optional_not_null& other) = default;
+    optional_not_null(optional_not_null&& other) = default;
+
+    //-------------------------------------------------------------------------
+
+    /// \brief Empties this optional_not_null
+    ///
+    /// \return reference to `(*this)`
+    NOT_NULL_CPP14_CONSTEXPR auto operator=(std::nullptr_t)
+      noexcept -> optional_not_null&;
+
+    auto operator=(const optional_not_null& other) -> optional_not_null& = default;
+    auto operator=(optional_not_null&& other) -> optional_not_null& = default;
+
+    //-------------------------------------------------------------------------
+    // Observers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Queries whether this optional_not_null contains a value
+    ///
+    /// \return `true` if this contains a value
+    constexpr auto has_value() const noexcept -> bool;
+
+    /// \brief Contextually convertible to bool if this contains a value
+    constexpr explicit operator bool() const noexcept;
+
+    //-------------------------------------------------------------------------
+
+    /// \{
+    /// \brief Gets the contained `not_null`, checking that it exists first
+    ///
+    /// \throw not_null_contract_violation if `!has_value()`
+    /// \return reference to the contained `not_null`
+    auto value() & -> value_type&;
+    auto value() && -> value_type&&;
+    auto value() const & -> const value_type&;
+    auto value() const && -> const value_type&&;
+    /// \}
+
+    /// \{
+    /// \brief Gets the contained `not_null`, without checking that it exists
+    ///
+    /// \pre `has_value()`
+    /// \return reference to the contained `not_null`
+    auto operator*() & noexcept -> value_type&;
+    auto operator*() && noexcept -> value_type&&;
+    auto operator*() const & noexcept -> const value_type&;
+    auto operator*() const && noexcept -> const value_type&&;
+    /// \}
+
+    /// \{
+    /// \brief Gets the contained `not_null` if it exists, or \p default_value
+    ///        otherwise
+    ///
+    /// \param default_value the not_null to return if this is empty
+    /// \return the contained value, or \p default_value
+    template <typename U>
+    auto value_or(U&& default_value) const & -> value_type;
+    template <typename U>
+    auto value_or(U&& default_value) && -> value_type;
+    /// \}
+
+    //-------------------------------------------------------------------------
+
+    /// \{
+    /// \brief Extracts the underlying nullable pointer
+    ///
+    /// \return the underlying nullable pointer, which is null if empty
+    constexpr auto as_nullable() const & noexcept -> const T&;
+    NOT_NULL_CPP14_CONSTEXPR auto as_nullable() && noexcept -> T&&;
+    /// \}
+
+    //-------------------------------------------------------------------------
+    // Monadic Operations
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \{
+    /// \brief Invokes \p f with the contained `not_null` if it exists, and
+    ///        returns its result
+    ///
+    /// This chains operations that may each produce an empty result, such as
+    /// following a nullable link with `try_not_null`. The r-value overload
+    /// moves the contained `not_null` into \p f, so that move-only pointers
+    /// are never copied.
+    ///
+    /// ### Examples
+    ///
+    /// Basic Usage:
+    ///
+    /// ```cpp
+    /// auto grandparent = try_not_null(node)
+    ///   .and_then([](not_null<Node*> n){ return try_not_null(n->parent); })
+    ///   .and_then([](not_null<Node*> n){ return try_not_null(n->parent); });
+    /// ```
+    ///
+    /// \param f a function that accepts the contained `not_null`, and returns
+    ///          an `optional_not_null`
+    /// \return the result of \p f if this contains a value, otherwise an
+    ///         empty `optional_not_null` of the same type
+    template <typename F>
+    auto and_then(F&& f) &
+      -> detail::optional_not_null_invoke_result<F,value_type&>;
+    template <typename F>
+    auto and_then(F&& f) const &
+      -> detail::optional_not_null_invoke_result<F,const value_type&>;
+    template <typename F>
+    auto and_then(F&& f) &&
+      -> detail::optional_not_null_invoke_result<F,value_type&&>;
+    /// \}
+
+    /// \{
+    /// \brief Invokes \p f with the contained `not_null` if it exists, and
+    ///        returns its result as an `optional_not_null`
+    ///
+    /// Since the result must remain the size of a pointer, \p f must return
+    /// a `not_null`; functions that may produce null should be used with
+    /// `and_then` instead.
+    ///
+    /// ### Examples
+    ///
+    /// Basic Usage:
+    ///
+    /// ```cpp
+    /// auto shared = try_not_null(std::move(unique))
+    ///   .transform([](not_null<std::unique_ptr<Widget>> p){
+    ///     return not_null<std::shared_ptr<Widget>>{std::move(p)};
+    ///   });
+    /// ```
+    ///
+    /// \param f a function that accepts the contained `not_null`, and returns
+    ///          a `not_null`
+    /// \return the result of \p f if this contains a value, otherwise an
+    ///         empty `optional_not_null`
+    template <typename F>
+    auto transform(F&& f) &
+      -> typename detail::optional_not_null_transform_result<
+           detail::optional_not_null_invoke_result<F,value_type&>
+         >::type;
+    template <typename F>
+    auto transform(F&& f) const &
+      -> typename detail::optional_not_null_transform_result<
+           detail::optional_not_null_invoke_result<F,const value_type&>
+         >::type;
+    template <typename F>
+    auto transform(F&& f) &&
+      -> typename detail::optional_not_null_transform_result<
+           detail::optional_not_null_invoke_result<F,value_type&&>
+         >::type;
+    /// \}
+
+    /// \{
+    /// \brief Returns this if it contains a value, otherwise the result of
+    ///        invoking \p f
+    ///
+    /// ### Examples
+    ///
+    /// Basic Usage:
+    ///
+    /// ```cpp
+    /// auto w = try_not_null(find_widget(name))
+    ///   .or_else([&]{ return try_not_null(find_widget(fallback)); });
+    /// ```
+    ///
+    /// \param f a function that accepts no arguments, and returns a value
+    ///          that is convertible to this `optional_not_null`
+    /// \return a copy of this if it contains a value, otherwise the result
+    ///         of \p f
+    template <typename F>
+    auto or_else(F&& f) const & -> optional_not_null;
+    template <typename F>
+    auto or_else(F&& f) && -> optional_not_null;
+    /// \}
+
+    //-------------------------------------------------------------------------
+    // Modifiers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Empties this optional_not_null
+    NOT_NULL_CPP14_CONSTEXPR auto reset() noexcept -> void;
+
+    //-------------------------------------------------------------------------
+    // Private Members
+    //-------------------------------------------------------------------------
+  private:
+
+    T m_pointer;
+
+    //-------------------------------------------------------------------------
+    // Private Constructors
+    //-------------------------------------------------------------------------
+  private:
+
+    struct ctor_tag{};
+
+    template <typename P>
+    constexpr optional_not_null(ctor_tag, P&& ptr)
+      noexcept(std::is_nothrow_constructible<T,P>::value);
+
+    friend detail::optional_not_null_factory;
+
+    template <typename U>
+    friend class optional_not_null;
+  };
+
+  //===========================================================================
+  // non-member functions : class : optional_not_null
+  //===========================================================================
+
+  //---------------------------------------------------------------------------
+  // Utilities
+  //---------------------------------------------------------------------------
+
+  /// \brief Creates an `optional_not_null` from \p ptr, which is empty if
+  ///        \p ptr is null
+  ///
+  /// This is the non-throwing counterpart of `check_not_null`, for code
+  /// where a null pointer is an expected input rather than a violated
+  /// contract. The pointer is checked exactly once, and is moved into the
+  /// result without first being wrapped in a `not_null`, so the result is
+  /// the size of \p ptr and move-only pointers are never copied.
+  ///
+  /// The result may be tested in the condition of an `if` statement, which
+  /// scopes the `optional_not_null` to the branch that may use it.
+  ///
+  /// ### Examples
+  ///
+  /// Basic use:
+  ///
+  /// ```cpp
+  /// auto consume(std::unique_ptr<Record> p) -> bool
+  /// {
+  ///   if (auto r = try_not_null(std::move(p))) {
+  ///     store(*std::move(r)); // 'store' accepts a 'not_null<std::unique_ptr<Record>>'
+  ///     return true;
+  ///   }
+  ///   return false; // rejected without throwing
+  /// }
+  /// ```
+  ///
+  /// \param ptr the pointer to check for nullability
+  /// \return an `optional_not_null` that contains `ptr`, or that is empty
+  ///         if `ptr == nullptr`
+  template <typename T>
+  constexpr auto try_not_null(T&& ptr)
+    noexcept(std::is_nothrow_constructible<typename std::decay<T>::type,T>::value)
+    -> optional_not_null<typename std::decay<T>::type>;
+
+  //---------------------------------------------------------------------------
+  // Comparisons
+  //---------------------------------------------------------------------------
+
+  template <typename T, typename U>
+  constexpr auto operator==(const optional_not_null<T>& lhs,
+                            const optional_not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U>
+  constexpr auto operator!=(const optional_not_null<T>& lhs,
+                            const optional_not_null<U>& rhs) noexcept -> bool;
+
+  template <typename T>
+  constexpr auto operator==(const optional_not_null<T>& lhs, std::nullptr_t) noexcept -> bool;
+  template <typename T>
+  constexpr auto operator==(std::nullptr_t, const optional_not_null<T>& rhs) noexcept -> bool;
+  template <typename T>
+  constexpr auto operator!=(const optional_not_null<T>& lhs, std::nullptr_t) noexcept -> bool;
+  template <typename T>
+  constexpr auto operator!=(std::nullptr_t, const optional_not_null<T>& rhs) noexcept -> bool;
+
+  template <typename T, typename U>
+  constexpr auto operator==(const optional_not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U>
+  constexpr auto operator==(const not_null<T>& lhs, const optional_not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U>
+  constexpr auto operator!=(const optional_not_null<T>& lhs, const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U>
+  constexpr auto operator!=(const not_null<T>& lhs, const optional_not_null<U>& rhs) noexcept -> bool;
+
+} // inline namespace bitwizeshift
+} // namespace cpp
+
+//=============================================================================
+// class : optional_not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::optional_not_null<T>::optional_not_null()
+  noexcept
+  : m_pointer(nullptr)
+{
+
+}
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::optional_not_null<T>::optional_not_null(std::nullptr_t)
+  noexcept
+  : m_pointer(nullptr)
+{
+
+}
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::optional_not_null<T>::optional_not_null(const value_type& p)
+  noexcept(std::is_nothrow_copy_constructible<T>::value)
+  : m_pointer(p.as_nullable())
+{
+
+}
+
+template <typename T>
+inline NOT_NULL_CPP14_CONSTEXPR NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::optional_not_null<T>::optional_not_null(value_type&& p)
+  noexcept(std::is_nothrow_move_constructible<T>::value)
+  : m_pointer(static_cast<value_type&&>(p).as_nullable())
+{
+
+}
+
+template <typename T>
+template <typename U, typename>
+inline NOT_NULL_CPP14_CONSTEXPR NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::optional_not_null<T>::optional_not_null(optional_not_null<U>&& other)
+  noexcept(std::is_nothrow_constructible<T,U&&>::value)
+  : m_pointer(static_cast<U&&>(other.m_pointer))
+{
+
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline NOT_NULL_CPP14_CONSTEXPR NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::operator=(std::nullptr_t)
+  noexcept -> optional_not_null&
+{
+  m_pointer = nullptr;
+  return (*this);
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::has_value()
+  const noexcept -> bool
+{
+  return m_pointer != nullptr;
+}
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::optional_not_null<T>::operator bool()
+  const noexcept
+{
+  return has_value();
+}
+
+//-----------------------------------------------------------------------------
+
+// The implementation of the `value()` overloads below trigger
+// `-Wunused-value` warnings due to the intentional use of the comma-operator,
+// in the same way as `check_not_null`.
+#if defined(__clang__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunused-value"
+# if (__clang_major__ >= 4) || ((__clang_major__ == 3) && (__clang_minor__ >= 9))
+#   pragma clang diagnostic ignored "-Wcomma"
+# endif
+#elif defined(__GNUC__)
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wunused-value"
+#endif // defined(__GNUC__)
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::value()
+  & -> value_type&
+{
+  return (NOT_NULL_LIKELY(has_value()) || (detail::throw_null_pointer_error(), true)),
+    **this;
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::value()
+  && -> value_type&&
+{
+  return (NOT_NULL_LIKELY(has_value()) || (detail::throw_null_pointer_error(), true)),
+    static_cast<value_type&&>(**this);
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::value()
+  const & -> const value_type&
+{
+  return (NOT_NULL_LIKELY(has_value()) || (detail::throw_null_pointer_error(), true)),
+    **this;
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::value()
+  const && -> const value_type&&
+{
+  return (NOT_NULL_LIKELY(has_value()) || (detail::throw_null_pointer_error(), true)),
+    static_cast<const value_type&&>(**this);
+}
+
+#if defined(__clang__)
+# pragma clang diagnostic pop
+#elif defined(__GNUC__)
+# pragma GCC diagnostic pop
+#endif // defined(__GNUC__)
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::operator*()
+  & noexcept -> value_type&
+{
+  // An engaged optional_not_null holds a non-null 'T', which has the same
+  // layout as 'not_null<T>' (see 'assume_not_null_range')
+  return *assume_not_null_range(&m_pointer, 1u);
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::operator*()
+  && noexcept -> value_type&&
+{
+  return static_cast<value_type&&>(*assume_not_null_range(&m_pointer, 1u));
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::operator*()
+  const & noexcept -> const value_type&
+{
+  return *assume_not_null_range(&m_pointer, 1u);
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::operator*()
+  const && noexcept -> const value_type&&
+{
+  return static_cast<const value_type&&>(*assume_not_null_range(&m_pointer, 1u));
+}
+
+template <typename T>
+template <typename U>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::value_or(U&& default_value)
+  const & -> value_type
+{
+  return has_value()
+    ? **this
+    : static_cast<value_type>(detail::not_null_forward<U>(default_value));
+}
+
+template <typename T>
+template <typename U>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::value_or(U&& default_value)
+  && -> value_type
+{
+  return has_value()
+    ? static_cast<value_type&&>(**this)
+    : static_cast<value_type>(detail::not_null_forward<U>(default_value));
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::as_nullable()
+  const & noexcept -> const T&
+{
+  return m_pointer;
+}
+
+template <typename T>
+inline NOT_NULL_CPP14_CONSTEXPR NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::as_nullable()
+  && noexcept -> T&&
+{
+  return static_cast<T&&>(m_pointer);
+}
+
+//-----------------------------------------------------------------------------
+// Monadic Operations
+//-----------------------------------------------------------------------------
+
+template <typename T>
+template <typename F>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::and_then(F&& f)
+  & -> detail::optional_not_null_invoke_result<F,value_type&>
+{
+  using result_type = detail::optional_not_null_invoke_result<F,value_type&>;
+
+  static_assert(
+    detail::is_optional_not_null<result_type>::value,
+    "and_then requires a function that returns an optional_not_null"
+  );
+
+  if (has_value()) {
+    return detail::not_null_forward<F>(f)(**this);
+  }
+  return result_type{};
+}
+
+template <typename T>
+template <typename F>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::and_then(F&& f)
+  const & -> detail::optional_not_null_invoke_result<F,const value_type&>
+{
+  using result_type = detail::optional_not_null_invoke_result<F,const value_type&>;
+
+  static_assert(
+    detail::is_optional_not_null<result_type>::value,
+    "and_then requires a function that returns an optional_not_null"
+  );
+
+  if (has_value()) {
+    return detail::not_null_forward<F>(f)(**this);
+  }
+  return result_type{};
+}
+
+template <typename T>
+template <typename F>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::and_then(F&& f)
+  && -> detail::optional_not_null_invoke_result<F,value_type&&>
+{
+  using result_type = detail::optional_not_null_invoke_result<F,value_type&&>;
+
+  static_assert(
+    detail::is_optional_not_null<result_type>::value,
+    "and_then requires a function that returns an optional_not_null"
+  );
+
+  if (has_value()) {
+    return detail::not_null_forward<F>(f)(static_cast<value_type&&>(**this));
+  }
+  return result_type{};
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T>
+template <typename F>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::transform(F&& f)
+  & -> typename detail::optional_not_null_transform_result<
+    detail::optional_not_null_invoke_result<F,value_type&>
+  >::type
+{
+  using result_type = typename detail::optional_not_null_transform_result<
+    detail::optional_not_null_invoke_result<F,value_type&>
+  >::type;
+
+  if (has_value()) {
+    return result_type{detail::not_null_forward<F>(f)(**this)};
+  }
+  return result_type{};
+}
+
+template <typename T>
+template <typename F>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::transform(F&& f)
+  const & -> typename detail::optional_not_null_transform_result<
+    detail::optional_not_null_invoke_result<F,const value_type&>
+  >::type
+{
+  using result_type = typename detail::optional_not_null_transform_result<
+    detail::optional_not_null_invoke_result<F,const value_type&>
+  >::type;
+
+  if (has_value()) {
+    return result_type{detail::not_null_forward<F>(f)(**this)};
+  }
+  return result_type{};
+}
+
+template <typename T>
+template <typename F>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::transform(F&& f)
+  && -> typename detail::optional_not_null_transform_result<
+    detail::optional_not_null_invoke_result<F,value_type&&>
+  >::type
+{
+  using result_type = typename detail::optional_not_null_transform_result<
+    detail::optional_not_null_invoke_result<F,value_type&&>
+  >::type;
+
+  if (has_value()) {
+    return result_type{detail::not_null_forward<F>(f)(static_cast<value_type&&>(**this))};
+  }
+  return result_type{};
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T>
+template <typename F>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::or_else(F&& f)
+  const & -> optional_not_null
+{
+  if (has_value()) {
+    return (*this);
+  }
+  return detail::not_null_forward<F>(f)();
+}
+
+template <typename T>
+template <typename F>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::or_else(F&& f)
+  && -> optional_not_null
+{
+  if (has_value()) {
+    return static_cast<optional_not_null&&>(*this);
+  }
+  return detail::not_null_forward<F>(f)();
+}
+
+//-----------------------------------------------------------------------------
+// Modifiers
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline NOT_NULL_CPP14_CONSTEXPR NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::optional_not_null<T>::reset()
+  noexcept -> void
+{
+  m_pointer = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Private Constructors
+//-----------------------------------------------------------------------------
+
+template <typename T>
+template <typename P>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::optional_not_null<T>::optional_not_null(ctor_tag, P&& ptr)
+  noexcept(std::is_nothrow_constructible<T,P>::value)
+  : m_pointer(detail::not_null_forward<P>(ptr))
+{
+
+}
+
+//=============================================================================
+// struct : detail::optional_not_null_factory
+//=============================================================================
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::detail::optional_not_null_factory::make(T&& p)
+  -> optional_not_null<typename std::decay<T>::type>
+{
+  using value_type = typename std::decay<T>::type;
+
+  return optional_not_null<value_type>{
+    typename optional_not_null<value_type>::ctor_tag{},
+    not_null_forward<T>(p)
+  };
+}
+
+//=============================================================================
+// non-member functions : class : optional_not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Utilities
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::try_not_null(T&& ptr)
+  noexcept(std::is_nothrow_constructible<typename std::decay<T>::type,T>::value)
+  -> optional_not_null<typename std::decay<T>::type>
+{
+  // An empty optional_not_null is represented by a null pointer, so the
+  // pointer is stored as-is; the check happens once, when it is observed
+  return detail::optional_not_null_factory::make(detail::not_null_forward<T>(ptr));
+}
+
+//-----------------------------------------------------------------------------
+// Comparisons
+//-----------------------------------------------------------------------------
+
+template <typename T, typename U>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator==(const optional_not_null<T>& lhs,
+                                  const optional_not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() == rhs.as_nullable();
+}
+
+template <typename T, typename U>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator!=(const optional_not_null<T>& lhs,
+                                  const optional_not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() != rhs.as_nullable();
+}
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator==(const optional_not_null<T>& lhs, std::nullptr_t)
+  noexcept -> bool
+{
+  return !lhs.has_value();
+}
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator==(std::nullptr_t, const optional_not_null<T>& rhs)
+  noexcept -> bool
+{
+  return !rhs.has_value();
+}
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator!=(const optional_not_null<T>& lhs, std::nullptr_t)
+  noexcept -> bool
+{
+  return lhs.has_value();
+}
+
+template <typename T>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator!=(std::nullptr_t, const optional_not_null<T>& rhs)
+  noexcept -> bool
+{
+  return rhs.has_value();
+}
+
+template <typename T, typename U>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator==(const optional_not_null<T>& lhs,
+                                  const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() == rhs.as_nullable();
+}
+
+template <typename T, typename U>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator==(const not_null<T>& lhs,
+                                  const optional_not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() == rhs.as_nullable();
+}
+
+template <typename T, typename U>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator!=(const optional_not_null<T>& lhs,
+                                  const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() != rhs.as_nullable();
+}
+
+template <typename T, typename U>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator!=(const not_null<T>& lhs,
+                                  const optional_not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.as_nullable() != rhs.as_nullable();
+}
+
+#endif /* CPP_BITWIZESHIFT_OPTIONAL_NOT_NULL_HPP */
@@ -0,0 +1,596 @@
+/*****************************************************************************
+ * \file rcu_cell.hpp
+ *
+ * \brief This header defines a read-mostly publisher of non-null objects,
+ *        with epoch-based reclamation of old versions
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2019 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CPP_BITWIZESHIFT_RCU_CELL_HPP
+#define CPP_BITWIZESHIFT_RCU_CELL_HPP
+
+#include "not_null.hpp"
+#include "atomic_not_null.hpp"
+
+#include <algorithm> // std::find, std::remove_if
+#include <atomic>    // std::atomic
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uint64_t
+#include <limits>    // std::numeric_limits
+#include <memory>    // std::unique_ptr
+#include <mutex>     // std::mutex, std::lock_guard
+#include <vector>    // std::vector
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+  template <typename T>
+  class rcu_cell;
+
+  namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief The epoch of a single reader thread
+    ///
+    /// Each reader is written only by its own thread, and is aligned to a
+    /// cache line so that readers on different threads never contend.
+    ///////////////////////////////////////////////////////////////////////////
+    struct alignas(64) rcu_reader
+    {
+      /// The global epoch at which the outermost active read began, or 0 if
+      /// the thread is not reading
+      std::atomic<std::uint64_t> epoch;
+
+      /// The number of active reads on this thread; only accessed by the
+      /// owning thread
+      unsigned nesting;
+    };
+
+    /// \brief The global epoch, and the readers of all live threads
+    struct rcu_registry
+    {
+      std::atomic<std::uint64_t> epoch;
+      std::mutex mutex;
+      std::vector<const rcu_reader*> live;
+
+      static auto instance() -> rcu_registry&;
+
+      /// \brief Gets the oldest epoch that is still being read, or the
+      ///        largest epoch if no thread is reading
+      auto oldest_active_epoch() -> std::uint64_t;
+    };
+
+    /// \brief Registers a thread's reader for the lifetime of the thread
+    class thread_rcu_reader
+    {
+    public:
+
+      thread_rcu_reader();
+      ~thread_rcu_reader();
+
+      thread_rcu_reader(const thread_rcu_reader&) = delete;
+      auto operator=(const thread_rcu_reader&) -> thread_rcu_reader& = delete;
+
+      rcu_reader reader;
+    };
+
+    /// \brief Gets the reader of the current thread, registering it on the
+    ///        first call
+    auto this_rcu_reader() -> rcu_reader&;
+
+  } // namespace detail
+
+  //===========================================================================
+  // class : rcu_cell
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief A read-mostly publisher of a non-null object, using read-copy-
+  ///        update with epoch-based reclamation
+  ///
+  /// Readers obtain a `read_guard`, which provides a `not_null<const T*>`
+  /// snapshot of the current version. Entering a read only writes to a
+  /// per-thread epoch on its own cache line, so readers never write to
+  /// memory shared with other readers, unlike copying a `std::shared_ptr`.
+  ///
+  /// Writers replace the current version with `update`. The old version is
+  /// retired, and is destroyed once every reader that could have observed it
+  /// has finished; this is checked by each `update`, or by `reclaim`.
+  ///
+  /// Epochs are shared between all `rcu_cell` objects, so a thread may read
+  /// from several cells at once, and reads may be nested.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// cpp::rcu_cell<routing_table> routes{
+  ///   cpp::check_not_null(load_routes())
+  /// };
+  ///
+  /// // readers
+  /// {
+  ///   const auto guard = routes.read();
+  ///   return guard->lookup(request);
+  /// }
+  ///
+  /// // writer
+  /// routes.update(cpp::check_not_null(load_routes()));
+  /// ```
+  ///
+  /// \tparam T the type of the published object
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  class rcu_cell
+  {
+    //-------------------------------------------------------------------------
+    // Public Member Types
+    //-------------------------------------------------------------------------
+  public:
+
+    using element_type = T;
+
+    class read_guard;
+
+    //-------------------------------------------------------------------------
+    // Constructors / Assignment
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Constructs an rcu_cell that publishes \p p
+    ///
+    /// \param p the initial version
+    explicit rcu_cell(not_null<std::unique_ptr<T>> p) noexcept;
+
+    rcu_cell(const rcu_cell&) = delete;
+
+    /// \brief Destroys the current version, and all retired versions
+    ///
+    /// \pre No thread is reading from this cell
+    ~rcu_cell();
+
+    //-------------------------------------------------------------------------
+
+    auto operator=(const rcu_cell&) -> rcu_cell& = delete;
+
+    //-------------------------------------------------------------------------
+    // Readers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Begins a read of the current version
+    ///
+    /// The version remains valid until the returned guard is destroyed, even
+    /// if it is replaced by a concurrent `update`. The guard must be
+    /// destroyed on the thread that created it.
+    ///
+    /// The first read on each thread registers that thread, which
+    /// allocates; subsequent reads do not.
+    ///
+    /// \return a guard providing the current version
+    auto read() const -> read_guard;
+
+    //-------------------------------------------------------------------------
+    // Writers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Publishes \p p as the current version, retiring the previous
+    ///        version
+    ///
+    /// Retired versions that can no longer be observed by any reader are
+    /// destroyed before returning. This must not be called while the
+    /// current thread is reading, or the previous version cannot be
+    /// destroyed until a later call.
+    ///
+    /// \param p the new version
+    auto update(not_null<std::unique_ptr<T>> p) -> void;
+
+    /// \brief Destroys the retired versions that can no longer be observed
+    ///        by any reader
+    auto reclaim() -> void;
+
+    /// \brief Gets the number of retired versions that have not yet been
+    ///        destroyed
+    ///
+    /// \return the number of retired versions
+    auto retired() const -> std::size_t;
+
+    //-------------------------------------------------------------------------
+    // Private Member Types
+    //-------------------------------------------------------------------------
+  private:
+
+    struct retired_version
+    {
+      T* pointer;
+      std::uint64_t epoch; ///< The last epoch in which it could be observed
+    };
+
+    //-------------------------------------------------------------------------
+    // Private Members
+    //-------------------------------------------------------------------------
+  private:
+
+    atomic_not_null<T*> m_current;
+    mutable std::mutex m_mutex;
+    std::vector<retired_version> m_retired;
+
+    //-------------------------------------------------------------------------
+    // Private Modifiers
+    //-------------------------------------------------------------------------
+  private:
+
+    /// \brief Destroys the unobservable retired versions
+    ///
+    /// \pre m_mutex is held
+    auto reclaim_locked() -> void;
+  };
+
+  //===========================================================================
+  // class : rcu_cell<T>::read_guard
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief A snapshot of the version of an rcu_cell that was current when
+  ///        the read began
+  ///
+  /// The snapshot remains valid for the lifetime of the guard.
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  class rcu_cell<T>::read_guard
+  {
+    //-------------------------------------------------------------------------
+    // Constructors / Assignment
+    //-------------------------------------------------------------------------
+  public:
+
+    read_guard() = delete;
+
+    /// \brief Moves the read from \p other, which no longer holds a read
+    ///
+    /// \param other the guard to move
+    read_guard(read_guard&& other) noexcept;
+    read_guard(const read_guard&) = delete;
+
+    /// \brief Ends the read
+    ~read_guard();
+
+    //-------------------------------------------------------------------------
+
+    auto operator=(read_guard&&) -> read_guard& = delete;
+    auto operator=(const read_guard&) -> read_guard& = delete;
+
+    //-------------------------------------------------------------------------
+    // Observers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Gets the snapshot
+    ///
+    /// \return the snapshot
+    auto get() const noexcept -> not_null<const T*>;
+
+    /// \brief Dereferences the snapshot
+    ///
+    /// \return the snapshot
+    auto operator->() const noexcept -> const T*;
+
+    /// \brief Dereferences the snapshot
+    ///
+    /// \return reference to the snapshot
+    auto operator*() const noexcept -> const T&;
+
+    //-------------------------------------------------------------------------
+    // Private Constructors
+    //-------------------------------------------------------------------------
+  private:
+
+    read_guard(detail::rcu_reader& reader, not_null<const T*> p) noexcept;
+
+    //-------------------------------------------------------------------------
+    // Private Members
+    //-------------------------------------------------------------------------
+  private:
+
+    detail::rcu_reader* m_reader; ///< null if moved-from
+    not_null<const T*> m_pointer;
+
+    friend rcu_cell;
+  };
+
+} // inline namespace bitwizeshift
+} // namespace cpp
+
+//=============================================================================
+// class : rcu_registry
+//=============================================================================
+
+inline
+auto NOT_NULL_NS_IMPL::detail::rcu_registry::instance()
+  -> rcu_registry&
+{
+  static rcu_registry s_registry{{1u}, {}, {}};
+
+  return s_registry;
+}
+
+inline
+auto NOT_NULL_NS_IMPL::detail::rcu_registry::oldest_active_epoch()
+  -> std::uint64_t
+{
+  auto oldest = (std::numeric_limits<std::uint64_t>::max)();
+
+  const std::lock_guard<std::mutex> lock{mutex};
+  for (const auto* r : live) {
+    // Sequentially consistent with the epoch store and version load in
+    // 'rcu_cell::read': either this observes the reader's epoch, or the
+    // reader observes the version published before this call
+    const auto e = r->epoch.load(std::memory_order_seq_cst);
+    if (e != 0u && e < oldest) {
+      oldest = e;
+    }
+  }
+  return oldest;
+}
+
+//=============================================================================
+// class : thread_rcu_reader
+//=============================================================================
+
+inline
+NOT_NULL_NS_IMPL::detail::thread_rcu_reader::thread_rcu_reader()
+{
+  reader.epoch.store(0u, std::memory_order_relaxed);
+  reader.nesting = 0u;
+
+  auto& registry = rcu_registry::instance();
+  const std::lock_guard<std::mutex> lock{registry.mutex};
+
+  registry.live.push_back(&reader);
+}
+
+inline
+NOT_NULL_NS_IMPL::detail::thread_rcu_reader::~thread_rcu_reader()
+{
+  auto& registry = rcu_registry::instance();
+  const std::lock_guard<std::mutex> lock{registry.mutex};
+
+  registry.live.erase(
+    std::find(registry.live.begin(), registry.live.end(), &reader)
+  );
+}
+
+//-----------------------------------------------------------------------------
+
+inline
+auto NOT_NULL_NS_IMPL::detail::this_rcu_reader()
+  -> rcu_reader&
+{
+  static thread_local thread_rcu_reader s_reader{};
+
+  return s_reader.reader;
+}
+
+//=============================================================================
+// class : rcu_cell
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::rcu_cell<T>::rcu_cell(not_null<std::unique_ptr<T>> p)
+  noexcept
+  : m_current(detail::not_null_factory::make(std::move(p).as_nullable().release())),
+    m_mutex{},
+    m_retired{}
+{
+
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::rcu_cell<T>::~rcu_cell()
+{
+  for (const auto& r : m_retired) {
+    delete r.pointer;
+  }
+  delete m_current.load(std::memory_order_relaxed).get();
+}
+
+//-----------------------------------------------------------------------------
+// Readers
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::rcu_cell<T>::read()
+  const -> read_guard
+{
+  auto& reader = detail::this_rcu_reader();
+
+  if (reader.nesting++ == 0u) {
+    const auto epoch = detail::rcu_registry::instance().epoch.load(
+      std::memory_order_acquire
+    );
+    // The epoch must be visible to writers before the version is loaded;
+    // see 'rcu_registry::oldest_active_epoch'
+    reader.epoch.store(epoch, std::memory_order_seq_cst);
+  }
+
+  return read_guard{reader, m_current.load(std::memory_order_seq_cst)};
+}
+
+//-----------------------------------------------------------------------------
+// Writers
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::rcu_cell<T>::update(not_null<std::unique_ptr<T>> p)
+  -> void
+{
+  const std::lock_guard<std::mutex> lock{m_mutex};
+
+  // Reserve first, so that nothing can throw once 'p' has been published
+  m_retired.reserve(m_retired.size() + 1u);
+
+  const auto previous = m_current.exchange(
+    detail::not_null_factory::make(std::move(p).as_nullable().release())
+  );
+
+  // Readers that began before this increment may have loaded 'previous';
+  // readers that begin after it load the new version
+  const auto epoch = detail::rcu_registry::instance().epoch.fetch_add(
+    1u,
+    std::memory_order_seq_cst
+  );
+  m_retired.push_back(retired_version{previous.get(), epoch});
+
+  reclaim_locked();
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::rcu_cell<T>::reclaim()
+  -> void
+{
+  const std::lock_guard<std::mutex> lock{m_mutex};
+
+  reclaim_locked();
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::rcu_cell<T>::retired()
+  const -> std::size_t
+{
+  const std::lock_guard<std::mutex> lock{m_mutex};
+
+  return m_retired.size();
+}
+
+//-----------------------------------------------------------------------------
+// Private Modifiers
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::rcu_cell<T>::reclaim_locked()
+  -> void
+{
+  if (m_retired.empty()) {
+    return;
+  }
+
+  const auto oldest = detail::rcu_registry::instance().oldest_active_epoch();
+  const auto it = std::remove_if(m_retired.begin(), m_retired.end(),
+    [oldest](const retired_version& r) {
+      if (r.epoch < oldest) {
+        delete r.pointer;
+        return true;
+      }
+      return false;
+    }
+  );
+  m_retired.erase(it, m_retired.end());
+}
+
+//=============================================================================
+// class : rcu_cell<T>::read_guard
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::rcu_cell<T>::read_guard::read_guard(read_guard&& other)
+  noexcept
+  : m_reader(other.m_reader),
+    m_pointer(other.m_pointer)
+{
+  other.m_reader = nullptr;
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::rcu_cell<T>::read_guard::~read_guard()
+{
+  if (m_reader != nullptr && --m_reader->nesting == 0u) {
+    // Orders this thread's reads of the snapshot before its reclamation
+    m_reader->epoch.store(0u, std::memory_order_release);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::rcu_cell<T>::read_guard::get()
+  const noexcept -> not_null<const T*>
+{
+  return m_pointer;
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::rcu_cell<T>::read_guard::operator->()
+  const noexcept -> const T*
+{
+  return m_pointer.get();
+}
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::rcu_cell<T>::read_guard::operator*()
+  const noexcept -> const T&
+{
+  return *m_pointer;
+}
+
+//-----------------------------------------------------------------------------
+// Private Constructors
+//-----------------------------------------------------------------------------
+
+template <typename T>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::rcu_cell<T>::read_guard::read_guard(detail::rcu_reader& reader,
+                                                      not_null<const T*> p)
+  noexcept
+  : m_reader(&reader),
+    m_pointer(p)
+{
+
+}
+
+#endif /* CPP_BITWIZESHIFT_RCU_CELL_HPP */
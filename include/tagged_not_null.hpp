@@ -0,0 +1,447 @@
+/*****************************************************************************
+ * \file tagged_not_null.hpp
+ *
+ * \brief This header defines a non-nullable pointer that packs a small tag
+ *        into the unused low bits of the pointer
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2019 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#ifndef CPP_BITWIZESHIFT_TAGGED_NOT_NULL_HPP
+#define CPP_BITWIZESHIFT_TAGGED_NOT_NULL_HPP
+
+#include "not_null.hpp"
+
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uintptr_t
+#include <type_traits> // std::integral_constant
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+  template <typename T, unsigned TagBits, typename Tag = std::uintptr_t>
+  class tagged_not_null;
+
+  namespace detail {
+
+    /// \brief Computes `floor(log2(N))` for the alignment \p N
+    template <std::size_t N>
+    struct tagged_log2
+      : std::integral_constant<unsigned,(1u + tagged_log2<N / 2u>::value)>{};
+
+    template <>
+    struct tagged_log2<1u> : std::integral_constant<unsigned,0u>{};
+
+  } // namespace detail
+
+  //===========================================================================
+  // class : tagged_not_null
+  //===========================================================================
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// \brief A non-nullable raw pointer that stores a `TagBits`-bit tag in the
+  ///        low bits that are always zero due to the alignment of `T`
+  ///
+  /// A `T*` to a properly aligned `T` always has its low `log2(alignof(T))`
+  /// bits clear. `tagged_not_null` stores a tag in those bits, so that a
+  /// pointer and a handful of flags fit in a single word.
+  ///
+  /// Only the alignment bits are used; the unused high bits of an address are
+  /// platform-specific and are not portable to hardware that uses them (e.g.
+  /// 5-level paging, pointer authentication, or memory tagging).
+  ///
+  /// `get()` and `operator->` strip the tag and hint to the compiler that the
+  /// result is non-null, exactly like `not_null<T*>`. `tagged_not_null` is
+  /// trivially copyable, so it may be used with `std::atomic`.
+  ///
+  /// ### Examples
+  ///
+  /// Basic Usage:
+  ///
+  /// ```cpp
+  /// enum class color : unsigned { red, black };
+  ///
+  /// struct node {
+  ///   ...
+  ///   cpp::tagged_not_null<node*, 1, color> parent;
+  /// };
+  ///
+  /// if (n.parent.tag() == color::red) {
+  ///   n.parent.set_tag(color::black);
+  /// }
+  /// ```
+  ///
+  /// \note The primary template is only defined for raw pointers.
+  ///
+  /// \tparam T the pointer type
+  /// \tparam TagBits the number of low bits to use for the tag
+  /// \tparam Tag the type used to observe the tag; must be convertible to and
+  ///         from `std::uintptr_t` via `static_cast`
+  /////////////////////////////////////////////////////////////////////////////
+  template <typename T, unsigned TagBits, typename Tag>
+  class tagged_not_null<T*, TagBits, Tag>
+  {
+    // The alignment of T is checked by the members that store a pointer,
+    // rather than here, since T is commonly the incomplete class that
+    // contains this tagged_not_null
+
+    //-------------------------------------------------------------------------
+    // Public Member Types
+    //-------------------------------------------------------------------------
+  public:
+
+    using element_type = T;
+    using pointer      = T*;
+    using tag_type     = Tag;
+
+    //-------------------------------------------------------------------------
+    // Public Static Members
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief The number of bits available to the tag
+    static constexpr unsigned tag_bits = TagBits;
+
+    /// \brief The mask of the bits used by the tag
+    static constexpr std::uintptr_t tag_mask = (std::uintptr_t{1u} << TagBits) - 1u;
+
+    //-------------------------------------------------------------------------
+    // Constructors / Assignment
+    //-------------------------------------------------------------------------
+  public:
+
+    // tagged_not_null is not default-constructible, since it must point
+    // somewhere
+    tagged_not_null() = delete;
+
+    /// \brief Constructs a tagged_not_null from the pointer \p p, and the
+    ///        tag \p tag
+    ///
+    /// Bits of \p tag that do not fit in `TagBits` are discarded.
+    ///
+    /// \param p the pointer
+    /// \param tag the tag to store
+    explicit tagged_not_null(not_null<T*> p, Tag tag = Tag{}) noexcept;
+
+    tagged_not_null(const tagged_not_null& other) = default;
+
+    //-------------------------------------------------------------------------
+
+    auto operator=(const tagged_not_null& other) -> tagged_not_null& = default;
+
+    //-------------------------------------------------------------------------
+    // Modifiers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Changes the pointer, leaving the tag unchanged
+    ///
+    /// \param p the new pointer
+    auto set_pointer(not_null<T*> p) noexcept -> void;
+
+    /// \brief Changes the tag, leaving the pointer unchanged
+    ///
+    /// Bits of \p tag that do not fit in `TagBits` are discarded.
+    ///
+    /// \param tag the new tag
+    auto set_tag(Tag tag) noexcept -> void;
+
+    //-------------------------------------------------------------------------
+    // Observers
+    //-------------------------------------------------------------------------
+  public:
+
+    /// \brief Gets the underlying pointer, without the tag
+    ///
+    /// \return the underlying pointer
+    auto get() const noexcept -> pointer;
+
+    /// \brief Gets the underlying pointer as a not_null, without the tag
+    ///
+    /// \return the underlying pointer
+    auto as_not_null() const noexcept -> not_null<pointer>;
+
+    /// \brief Gets the tag
+    ///
+    /// \return the tag
+    constexpr auto tag() const noexcept -> Tag;
+
+    /// \brief Gets the combined bits of the pointer and the tag
+    ///
+    /// \return the combined bits
+    constexpr auto bits() const noexcept -> std::uintptr_t;
+
+    //-------------------------------------------------------------------------
+
+    /// \brief Dereferences the underlying pointer
+    ///
+    /// \return the underlying pointer
+    auto operator->() const noexcept -> pointer;
+
+    /// \brief Dereferences the underlying pointer
+    ///
+    /// \return reference to the underlying object
+    auto operator*() const noexcept -> T&;
+
+    //-------------------------------------------------------------------------
+    // Private Members
+    //-------------------------------------------------------------------------
+  private:
+
+    std::uintptr_t m_bits;
+  };
+
+  //===========================================================================
+  // non-member functions : class : tagged_not_null
+  //===========================================================================
+
+  //---------------------------------------------------------------------------
+  // Comparisons
+  //---------------------------------------------------------------------------
+
+  /// \{
+  /// \brief Compares both the pointer and the tag of \p lhs and \p rhs
+  template <typename T, unsigned TagBits, typename Tag>
+  constexpr auto operator==(const tagged_not_null<T,TagBits,Tag>& lhs,
+                            const tagged_not_null<T,TagBits,Tag>& rhs) noexcept -> bool;
+  template <typename T, unsigned TagBits, typename Tag>
+  constexpr auto operator!=(const tagged_not_null<T,TagBits,Tag>& lhs,
+                            const tagged_not_null<T,TagBits,Tag>& rhs) noexcept -> bool;
+  /// \}
+
+  /// \brief Compares only the pointers of \p lhs and \p rhs, ignoring their
+  ///        tags
+  ///
+  /// \param lhs the left tagged_not_null
+  /// \param rhs the right tagged_not_null
+  /// \return `true` if both point to the same object
+  template <typename T, unsigned TagBits, typename Tag>
+  auto equal_ignoring_tag(const tagged_not_null<T,TagBits,Tag>& lhs,
+                          const tagged_not_null<T,TagBits,Tag>& rhs) noexcept -> bool;
+
+  /// \{
+  /// \brief Compares the pointer of a tagged_not_null against a not_null,
+  ///        ignoring the tag
+  template <typename T, unsigned TagBits, typename Tag, typename U>
+  auto operator==(const tagged_not_null<T,TagBits,Tag>& lhs,
+                  const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U, unsigned TagBits, typename Tag>
+  auto operator==(const not_null<T>& lhs,
+                  const tagged_not_null<U,TagBits,Tag>& rhs) noexcept -> bool;
+  template <typename T, unsigned TagBits, typename Tag, typename U>
+  auto operator!=(const tagged_not_null<T,TagBits,Tag>& lhs,
+                  const not_null<U>& rhs) noexcept -> bool;
+  template <typename T, typename U, unsigned TagBits, typename Tag>
+  auto operator!=(const not_null<T>& lhs,
+                  const tagged_not_null<U,TagBits,Tag>& rhs) noexcept -> bool;
+  /// \}
+
+} // inline namespace bitwizeshift
+} // namespace cpp
+
+//=============================================================================
+// class : tagged_not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Public Static Members
+//-----------------------------------------------------------------------------
+
+template <typename T, unsigned TagBits, typename Tag>
+constexpr unsigned NOT_NULL_NS_IMPL::tagged_not_null<T*,TagBits,Tag>::tag_bits;
+
+template <typename T, unsigned TagBits, typename Tag>
+constexpr std::uintptr_t NOT_NULL_NS_IMPL::tagged_not_null<T*,TagBits,Tag>::tag_mask;
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+template <typename T, unsigned TagBits, typename Tag>
+inline NOT_NULL_INLINE_VISIBILITY
+NOT_NULL_NS_IMPL::tagged_not_null<T*,TagBits,Tag>::tagged_not_null(not_null<T*> p,
+                                                                  Tag tag)
+  noexcept
+  : m_bits(
+      reinterpret_cast<std::uintptr_t>(p.get()) |
+      (static_cast<std::uintptr_t>(tag) & tag_mask)
+    )
+{
+  static_assert(
+    TagBits <= detail::tagged_log2<alignof(T)>::value,
+    "The alignment of T does not leave enough free bits for the tag"
+  );
+}
+
+//-----------------------------------------------------------------------------
+// Modifiers
+//-----------------------------------------------------------------------------
+
+template <typename T, unsigned TagBits, typename Tag>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::tagged_not_null<T*,TagBits,Tag>::set_pointer(not_null<T*> p)
+  noexcept -> void
+{
+  static_assert(
+    TagBits <= detail::tagged_log2<alignof(T)>::value,
+    "The alignment of T does not leave enough free bits for the tag"
+  );
+
+  m_bits = reinterpret_cast<std::uintptr_t>(p.get()) | (m_bits & tag_mask);
+}
+
+template <typename T, unsigned TagBits, typename Tag>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::tagged_not_null<T*,TagBits,Tag>::set_tag(Tag tag)
+  noexcept -> void
+{
+  m_bits = (m_bits & ~tag_mask) | (static_cast<std::uintptr_t>(tag) & tag_mask);
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+template <typename T, unsigned TagBits, typename Tag>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::tagged_not_null<T*,TagBits,Tag>::get()
+  const noexcept -> pointer
+{
+  return detail::mark_nonnull(reinterpret_cast<T*>(m_bits & ~tag_mask));
+}
+
+template <typename T, unsigned TagBits, typename Tag>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::tagged_not_null<T*,TagBits,Tag>::as_not_null()
+  const noexcept -> not_null<pointer>
+{
+  return detail::not_null_factory::make(get());
+}
+
+template <typename T, unsigned TagBits, typename Tag>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::tagged_not_null<T*,TagBits,Tag>::tag()
+  const noexcept -> Tag
+{
+  return static_cast<Tag>(m_bits & tag_mask);
+}
+
+template <typename T, unsigned TagBits, typename Tag>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::tagged_not_null<T*,TagBits,Tag>::bits()
+  const noexcept -> std::uintptr_t
+{
+  return m_bits;
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T, unsigned TagBits, typename Tag>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::tagged_not_null<T*,TagBits,Tag>::operator->()
+  const noexcept -> pointer
+{
+  return get();
+}
+
+template <typename T, unsigned TagBits, typename Tag>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::tagged_not_null<T*,TagBits,Tag>::operator*()
+  const noexcept -> T&
+{
+  return *get();
+}
+
+//=============================================================================
+// non-member functions : class : tagged_not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Comparisons
+//-----------------------------------------------------------------------------
+
+template <typename T, unsigned TagBits, typename Tag>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator==(const tagged_not_null<T,TagBits,Tag>& lhs,
+                                  const tagged_not_null<T,TagBits,Tag>& rhs)
+  noexcept -> bool
+{
+  return lhs.bits() == rhs.bits();
+}
+
+template <typename T, unsigned TagBits, typename Tag>
+inline constexpr NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator!=(const tagged_not_null<T,TagBits,Tag>& lhs,
+                                  const tagged_not_null<T,TagBits,Tag>& rhs)
+  noexcept -> bool
+{
+  return lhs.bits() != rhs.bits();
+}
+
+template <typename T, unsigned TagBits, typename Tag>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::equal_ignoring_tag(const tagged_not_null<T,TagBits,Tag>& lhs,
+                                          const tagged_not_null<T,TagBits,Tag>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() == rhs.get();
+}
+
+template <typename T, unsigned TagBits, typename Tag, typename U>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator==(const tagged_not_null<T,TagBits,Tag>& lhs,
+                                  const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() == rhs.get();
+}
+
+template <typename T, typename U, unsigned TagBits, typename Tag>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator==(const not_null<T>& lhs,
+                                  const tagged_not_null<U,TagBits,Tag>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() == rhs.get();
+}
+
+template <typename T, unsigned TagBits, typename Tag, typename U>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator!=(const tagged_not_null<T,TagBits,Tag>& lhs,
+                                  const not_null<U>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() != rhs.get();
+}
+
+template <typename T, typename U, unsigned TagBits, typename Tag>
+inline NOT_NULL_INLINE_VISIBILITY
+auto NOT_NULL_NS_IMPL::operator!=(const not_null<T>& lhs,
+                                  const tagged_not_null<U,TagBits,Tag>& rhs)
+  noexcept -> bool
+{
+  return lhs.get() != rhs.get();
+}
+
+#endif /* CPP_BITWIZESHIFT_TAGGED_NOT_NULL_HPP */
@@ -0,0 +1,98 @@
+/*****************************************************************************
+ * \file not_null.cppm
+ *
+ * \brief This module interface exports the not_null utilities as the C++20
+ *        module 'cpp.not_null'
+ *****************************************************************************/
+
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2019 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+// The C++20 module interface of not_null.
+//
+// The standard headers that 'not_null.hpp' and 'not_null_hash.hpp' depend on
+// are included in the global module fragment, and the headers themselves are
+// included in the module purview with 'NOT_NULL_EXPORT' defined as 'export',
+// so that their public namespace is exported.
+//
+// Macros are not exported from modules, so configuration macros such as
+// 'NOT_NULL_NAMESPACE' and 'NOT_NULL_DISABLE_EXCEPTIONS' must be defined when
+// this module is compiled, and 'NOT_NULL_CALL_SITE' is unavailable to
+// importers; use 'not_null_call_site{__FILE__, __LINE__, __func__}' instead.
+
+module;
+
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <compare>
+#if !defined(NOT_NULL_DISABLE_EXCEPTIONS)
+# include <exception>
+#else
+# include <cstdio>
+# include <cstdlib>
+#endif
+#if defined(NOT_NULL_AUDIT_SAMPLING)
+# include <cstdio>
+# include <cstdlib>
+#endif
+#if defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+# include <algorithm>
+# include <cstdint>
+# include <cstdio>
+# include <cstring>
+# include <mutex>
+# include <vector>
+#endif
+
+export module cpp.not_null;
+
+#define NOT_NULL_EXPORT export
+#include "not_null.hpp"
+#include "not_null_hash.hpp"
+
+// GCC only emits the function-local statics of inline functions that are
+// attached to a module when the module unit itself uses those functions;
+// these references ensure that importers can be linked.
+namespace {
+
+  [[maybe_unused]] constexpr auto s_violation_handler_storage =
+    &::NOT_NULL_NS_IMPL::detail::violation_handler_storage;
+
+#if defined(NOT_NULL_AUDIT_SAMPLING)
+  [[maybe_unused]] constexpr auto s_audit_sample_due =
+    &::NOT_NULL_NS_IMPL::detail::audit_sample_due;
+#endif
+
+#if defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+  [[maybe_unused]] constexpr auto s_check_counter_registry =
+    &::NOT_NULL_NS_IMPL::detail::check_counter_registry::instance;
+  [[maybe_unused]] constexpr auto s_record_check =
+    &::NOT_NULL_NS_IMPL::detail::record_check;
+#endif
+
+} // namespace
@@ -0,0 +1,67 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+// This file is not executed; it is compiled and disassembled, and the
+// 'CHECK-*' directives below are verified against the generated code.
+// See 'cmake/CheckCodegen.cmake' for the meaning of each directive.
+//
+// Each probe passes a pointer loaded from an `atomic_not_null` to code that
+// checks it for null. Since only non-null pointers can be stored, the
+// optimizer should remove these checks entirely.
+
+#include "atomic_not_null.hpp"
+
+namespace {
+
+  struct widget
+  {
+    int value;
+  };
+
+  // Represents a legacy API that defensively checks its input for null
+  inline auto legacy_value(const widget* w) -> int
+  {
+    return (w == nullptr) ? -1 : w->value;
+  }
+
+} // namespace
+
+//=============================================================================
+// Operations
+//=============================================================================
+
+// CHECK-BRANCHES: probe_atomic_load 0
+// CHECK-NOT: probe_atomic_load ^(test|cmp)
+extern "C" auto probe_atomic_load(const cpp::atomic_not_null<widget*>& p) -> int
+{
+  return legacy_value(p.load(std::memory_order_acquire).get());
+}
+
+// CHECK-BRANCHES: probe_atomic_exchange 0
+// CHECK-NOT: probe_atomic_exchange ^(test|cmp)
+extern "C" auto probe_atomic_exchange(cpp::atomic_not_null<widget*>& p,
+                                      cpp::not_null<widget*> q) -> int
+{
+  return legacy_value(p.exchange(q).get());
+}
@@ -0,0 +1,95 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+// This file is not executed; it is compiled and disassembled, and the
+// 'CHECK-*' directives below are verified against the generated code.
+// See 'cmake/CheckCodegen.cmake' for the meaning of each directive.
+//
+// Each probe modifies or walks an `intrusive_list`. Since every link is a
+// `not_null`, and the ends of the list are a sentinel rather than null,
+// linking and unlinking never branch, and iterating only branches to test
+// for the end of the list.
+
+#include "intrusive_list.hpp"
+
+namespace {
+
+  struct task
+  {
+    int priority;
+    cpp::intrusive_list_hook hook;
+  };
+
+  using task_list = cpp::intrusive_list<task, &task::hook>;
+
+} // namespace
+
+// CHECK-BRANCHES: probe_list_push_back 0
+// CHECK-NOT: probe_list_push_back ^(test|cmp)
+extern "C" auto probe_list_push_back(task_list& list, task& t) -> void
+{
+  list.push_back(t);
+}
+
+// CHECK-BRANCHES: probe_list_unlink 0
+// CHECK-NOT: probe_list_unlink ^(test|cmp)
+extern "C" auto probe_list_unlink(task& t) -> void
+{
+  t.hook.unlink();
+}
+
+// CHECK-BRANCHES: probe_list_pop_front 0
+// CHECK-NOT: probe_list_pop_front ^(test|cmp)
+extern "C" auto probe_list_pop_front(task_list& list) -> void
+{
+  list.pop_front();
+}
+
+// Moving an element to the back of its list, as in an LRU cache
+// CHECK-BRANCHES: probe_list_touch 0
+// CHECK-NOT: probe_list_touch ^(test|cmp)
+extern "C" auto probe_list_touch(task_list& list, task& t) -> void
+{
+  t.hook.unlink();
+  list.push_back(t);
+}
+
+// CHECK-BRANCHES: probe_list_swap 0
+// CHECK-NOT: probe_list_swap ^(test|cmp)
+extern "C" auto probe_list_swap(task_list& lhs, task_list& rhs) -> void
+{
+  lhs.swap(rhs);
+}
+
+// The only branch is the test for the end of the list, which is also the
+// test for an empty list; advancing is a single load
+// CHECK-BRANCHES: probe_list_sum 1
+extern "C" auto probe_list_sum(const task_list& list) -> int
+{
+  auto total = 0;
+  for (const auto& t : list) {
+    total += t.priority;
+  }
+  return total;
+}
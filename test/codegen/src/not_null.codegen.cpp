@@ -0,0 +1,155 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+// This file is not executed; it is compiled and disassembled, and the
+// 'CHECK-*' directives below are verified against the generated code.
+// See 'cmake/CheckCodegen.cmake' for the meaning of each directive.
+//
+// Each probe passes the pointer retrieved from `not_null` to code that
+// checks it for null. If the non-null hint from `not_null` is working, the
+// optimizer removes these checks entirely.
+
+#include "not_null.hpp"
+
+#include <memory> // std::unique_ptr, std::shared_ptr
+#include <new>    // ::new
+
+namespace {
+
+  struct widget
+  {
+    int value;
+  };
+
+  // Represents a legacy API that defensively checks its input for null
+  inline auto legacy_value(const widget* w) -> int
+  {
+    return (w == nullptr) ? -1 : w->value;
+  }
+
+} // namespace
+
+//=============================================================================
+// Observers
+//=============================================================================
+
+// CHECK-BRANCHES: probe_get_pointer 0
+// CHECK-NOT: probe_get_pointer ^(test|cmp)
+// CHECK-MAX-INSTRUCTIONS: probe_get_pointer 3
+extern "C" auto probe_get_pointer(cpp::not_null<widget*> p) -> int
+{
+  return legacy_value(p.get());
+}
+
+// CHECK-BRANCHES: probe_get_unique_ptr 0
+// CHECK-NOT: probe_get_unique_ptr ^(test|cmp)
+// CHECK-MAX-INSTRUCTIONS: probe_get_unique_ptr 4
+extern "C" auto probe_get_unique_ptr(const cpp::not_null<std::unique_ptr<widget>>& p) -> int
+{
+  return legacy_value(p.get());
+}
+
+// CHECK-BRANCHES: probe_arrow_pointer 0
+// CHECK-NOT: probe_arrow_pointer ^(test|cmp)
+// CHECK-MAX-INSTRUCTIONS: probe_arrow_pointer 3
+extern "C" auto probe_arrow_pointer(cpp::not_null<widget*> p) -> int
+{
+  return legacy_value(p.operator->());
+}
+
+// CHECK-BRANCHES: probe_arrow_unique_ptr 0
+// CHECK-NOT: probe_arrow_unique_ptr ^(test|cmp)
+// CHECK-MAX-INSTRUCTIONS: probe_arrow_unique_ptr 4
+extern "C" auto probe_arrow_unique_ptr(const cpp::not_null<std::unique_ptr<widget>>& p) -> int
+{
+  return legacy_value(p.operator->());
+}
+
+// CHECK-BRANCHES: probe_as_nullable_pointer 0
+// CHECK-NOT: probe_as_nullable_pointer ^(test|cmp)
+// CHECK-MAX-INSTRUCTIONS: probe_as_nullable_pointer 3
+extern "C" auto probe_as_nullable_pointer(cpp::not_null<widget*> p) -> int
+{
+  return legacy_value(p.as_nullable());
+}
+
+//=============================================================================
+// Utilities
+//=============================================================================
+
+// The failure path must be a call to an out-of-line function, rather than an
+// inlined exception-throwing sequence
+// CHECK-BRANCHES: probe_check_not_null 1
+// CHECK-MAX-INSTRUCTIONS: probe_check_not_null 6
+extern "C" auto probe_check_not_null(widget* p) -> int
+{
+  return cpp::check_not_null(p)->value;
+}
+
+// A checked pointer should only ever be checked once, no matter how many
+// times it is subsequently null-checked by other code
+// CHECK-BRANCHES: probe_check_not_null_then_get 1
+extern "C" auto probe_check_not_null_then_get(widget* p) -> int
+{
+  const auto nn = cpp::check_not_null(p);
+
+  return legacy_value(nn.get()) + legacy_value(nn.operator->());
+}
+
+// CHECK-BRANCHES: probe_assume_not_null 0
+// CHECK-NOT: probe_assume_not_null ^(test|cmp)
+extern "C" auto probe_assume_not_null(widget* p) -> int
+{
+  return legacy_value(cpp::assume_not_null(p).get());
+}
+
+// CHECK-BRANCHES: probe_check_not_null_call_site 1
+// CHECK-MAX-INSTRUCTIONS: probe_check_not_null_call_site 9
+extern "C" auto probe_check_not_null_call_site(widget* p) -> int
+{
+  return cpp::check_not_null(p, NOT_NULL_CALL_SITE)->value;
+}
+
+//=============================================================================
+// Smart Pointer Factories
+//=============================================================================
+
+// The factories never check the pointer they create, regardless of whether
+// the optimizer can prove that the allocation is non-null
+// CHECK-BRANCHES: probe_make_not_null_unique 0
+// CHECK-NOT: probe_make_not_null_unique null_pointer_error
+extern "C" auto probe_make_not_null_unique(int value) -> widget*
+{
+  return cpp::make_not_null_unique<widget>(widget{value}).as_nullable().release();
+}
+
+// CHECK-BRANCHES: probe_make_not_null_shared 0
+// CHECK-NOT: probe_make_not_null_shared null_pointer_error
+extern "C" auto probe_make_not_null_shared(cpp::not_null<std::shared_ptr<widget>>* out,
+                                           int value) -> void
+{
+  ::new (static_cast<void*>(out)) cpp::not_null<std::shared_ptr<widget>>(
+    cpp::make_not_null_shared<widget>(widget{value})
+  );
+}
@@ -0,0 +1,58 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+// This file is not executed; it is compiled and disassembled, and the
+// 'CHECK-*' directives below are verified against the generated code.
+// See 'cmake/CheckCodegen.cmake' for the meaning of each directive.
+//
+// Each probe invokes a callable that can never be empty. Calls should be a
+// single indirect call, with no check for emptiness and no path to
+// 'std::bad_function_call'.
+
+#include "not_null_function_ref.hpp"
+
+#include <functional> // std::function
+
+//=============================================================================
+// class : not_null_function_ref
+//=============================================================================
+
+// CHECK-BRANCHES: probe_function_ref_call 0
+// CHECK-NOT: probe_function_ref_call ^(test|cmp)
+extern "C" auto probe_function_ref_call(cpp::not_null_function_ref<int(int)> f) -> int
+{
+  return f(42);
+}
+
+//=============================================================================
+// class : not_null<std::function>
+//=============================================================================
+
+// CHECK-BRANCHES: probe_function_call 0
+// CHECK-NOT: probe_function_call ^(test|cmp)
+// CHECK-NOT: probe_function_call bad_function_call
+extern "C" auto probe_function_call(const cpp::not_null<std::function<int(int)>>& f) -> int
+{
+  return f(42);
+}
@@ -0,0 +1,64 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+// This file is not executed; it is compiled and disassembled, and the
+// 'CHECK-*' directives below are verified against the generated code.
+// See 'cmake/CheckCodegen.cmake' for the meaning of each directive.
+//
+// Each probe prefetches through a `not_null`. Since the pointer is known to
+// not be null, the prefetch is issued without first testing the pointer.
+
+#include "not_null_prefetch.hpp"
+
+namespace {
+
+  struct node
+  {
+    int value;
+    cpp::not_null<const node*> next;
+  };
+
+} // namespace
+
+// CHECK-BRANCHES: probe_prefetch 0
+// CHECK-NOT: probe_prefetch ^(test|cmp)
+extern "C" auto probe_prefetch(cpp::not_null<const int*> p) -> void
+{
+  cpp::prefetch(p);
+}
+
+// CHECK-BRANCHES: probe_prefetch_locality 0
+// CHECK-NOT: probe_prefetch_locality ^(test|cmp)
+extern "C" auto probe_prefetch_locality(cpp::not_null<const int*> p) -> void
+{
+  cpp::prefetch(p, cpp::prefetch_locality::none);
+}
+
+// CHECK-BRANCHES: probe_prefetch_next 0
+// CHECK-NOT: probe_prefetch_next ^(test|cmp)
+extern "C" auto probe_prefetch_next(cpp::not_null<const node*> n) -> int
+{
+  cpp::prefetch(n->next);
+  return n->value;
+}
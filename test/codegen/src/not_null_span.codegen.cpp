@@ -0,0 +1,67 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+// This file is not executed; it is compiled and disassembled, and the
+// 'CHECK-*' directives below are verified against the generated code.
+// See 'cmake/CheckCodegen.cmake' for the meaning of each directive.
+//
+// Each probe passes the data of a `not_null_span` to code that checks it
+// for null. Since the data of a span, and of every subview of it, is known
+// to not be null, the optimizer removes these checks entirely.
+
+#include "not_null_span.hpp"
+
+#include <cstddef> // std::size_t
+
+namespace {
+
+  // Represents a legacy API that defensively checks its input for null
+  inline auto legacy_first(const int* p) -> int
+  {
+    return (p == nullptr) ? -1 : p[0];
+  }
+
+} // namespace
+
+// CHECK-BRANCHES: probe_span_data 0
+// CHECK-NOT: probe_span_data ^(test|cmp)
+extern "C" auto probe_span_data(cpp::not_null_span<const int,4> s) -> int
+{
+  return legacy_first(s.data().get());
+}
+
+// CHECK-BRANCHES: probe_span_subspan 0
+// CHECK-NOT: probe_span_subspan ^(test|cmp)
+extern "C" auto probe_span_subspan(cpp::not_null_span<const int> s,
+                                   std::size_t offset) -> int
+{
+  return legacy_first(s.subspan(offset, 1u).data().get());
+}
+
+// CHECK-BRANCHES: probe_span_last 0
+// CHECK-NOT: probe_span_last ^(test|cmp)
+extern "C" auto probe_span_last(cpp::not_null_span<const int> s) -> int
+{
+  return legacy_first(s.last(1u).data().get());
+}
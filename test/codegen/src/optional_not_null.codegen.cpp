@@ -0,0 +1,76 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+// This file is not executed; it is compiled and disassembled, and the
+// 'CHECK-*' directives below are verified against the generated code.
+// See 'cmake/CheckCodegen.cmake' for the meaning of each directive.
+//
+// Each probe converts a nullable pointer with 'try_not_null'. The conversion
+// should compile to a single test for null, with no path to the
+// 'null_pointer_error' that a checked conversion would throw, and with no
+// further checks on the result once it is known to contain a value.
+
+#include "optional_not_null.hpp"
+
+namespace {
+
+  struct widget
+  {
+    int value;
+  };
+
+  // Represents a legacy API that defensively checks its input for null
+  inline auto legacy_value(const widget* p) -> int
+  {
+    return (p == nullptr) ? -1 : p->value;
+  }
+
+} // namespace
+
+//=============================================================================
+// non-member functions : class : optional_not_null
+//=============================================================================
+
+// CHECK-BRANCHES: probe_try_not_null 1
+// CHECK-NOT: probe_try_not_null null_pointer_error
+extern "C" auto probe_try_not_null(widget* p) -> int
+{
+  if (auto w = cpp::try_not_null(p)) {
+    return legacy_value((*w).get());
+  }
+  return 0;
+}
+
+// CHECK-BRANCHES: probe_try_not_null_transform 1
+// CHECK-NOT: probe_try_not_null_transform null_pointer_error
+extern "C" auto probe_try_not_null_transform(widget* p) -> int
+{
+  const auto value = cpp::try_not_null(p).transform([](cpp::not_null<widget*> w){
+    return cpp::assume_not_null(&w->value);
+  });
+  if (value) {
+    return **value;
+  }
+  return 0;
+}
@@ -0,0 +1,72 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+// This file is not executed; it is compiled and disassembled, and the
+// 'CHECK-*' directives below are verified against the generated code.
+// See 'cmake/CheckCodegen.cmake' for the meaning of each directive.
+//
+// Each probe passes the pointer retrieved from `tagged_not_null` to code
+// that checks it for null. Stripping the tag must not lose the non-null
+// hint, so the optimizer should still remove these checks entirely.
+
+#include "tagged_not_null.hpp"
+
+namespace {
+
+  struct widget
+  {
+    int value;
+  };
+
+  // Represents a legacy API that defensively checks its input for null
+  inline auto legacy_value(const widget* w) -> int
+  {
+    return (w == nullptr) ? -1 : w->value;
+  }
+
+} // namespace
+
+//=============================================================================
+// Observers
+//=============================================================================
+
+// CHECK-BRANCHES: probe_tagged_get 0
+// CHECK-NOT: probe_tagged_get ^(test|cmp)
+extern "C" auto probe_tagged_get(cpp::tagged_not_null<widget*,2> p) -> int
+{
+  return legacy_value(p.get());
+}
+
+// CHECK-BRANCHES: probe_tagged_arrow 0
+// CHECK-NOT: probe_tagged_arrow ^(test|cmp)
+extern "C" auto probe_tagged_arrow(cpp::tagged_not_null<widget*,2> p) -> int
+{
+  return legacy_value(p.operator->());
+}
+
+// CHECK-BRANCHES: probe_tagged_tag 0
+extern "C" auto probe_tagged_tag(cpp::tagged_not_null<widget*,2> p) -> unsigned
+{
+  return static_cast<unsigned>(p.tag());
+}
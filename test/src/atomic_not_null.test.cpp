@@ -0,0 +1,215 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "atomic_not_null.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>      // std::memory_order
+#include <thread>      // std::thread
+#include <type_traits> // std::is_copy_constructible
+#include <vector>      // std::vector
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+namespace {
+
+  struct table
+  {
+    int version;
+  };
+
+  table g_table{0};
+
+  // Constant-initialized, so it may be loaded during dynamic initialization
+  atomic_not_null<table*> g_current{assume_not_null(&g_table)};
+
+} // namespace
+
+//=============================================================================
+// class : atomic_not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Layout
+//-----------------------------------------------------------------------------
+
+TEST_CASE("atomic_not_null<T*>", "[layout]") {
+  SECTION("Is the same size as std::atomic<T*>") {
+    STATIC_REQUIRE(sizeof(atomic_not_null<table*>) == sizeof(std::atomic<table*>));
+  }
+  SECTION("Is always lock-free") {
+    STATIC_REQUIRE(atomic_not_null<table*>::is_always_lock_free);
+  }
+  SECTION("Is not default constructible") {
+    STATIC_REQUIRE_FALSE(std::is_default_constructible<atomic_not_null<table*>>::value);
+  }
+  SECTION("Is not copyable") {
+    STATIC_REQUIRE_FALSE(std::is_copy_constructible<atomic_not_null<table*>>::value);
+    STATIC_REQUIRE_FALSE(std::is_copy_assignable<atomic_not_null<table*>>::value);
+  }
+  SECTION("Is not constructible from T*") {
+    STATIC_REQUIRE_FALSE(std::is_constructible<atomic_not_null<table*>,table*>::value);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+TEST_CASE("atomic_not_null<T*>::atomic_not_null(not_null<T*>)", "[ctor]") {
+  SECTION("Holds the input") {
+    auto t = table{1};
+    const atomic_not_null<table*> sut{assume_not_null(&t)};
+
+    REQUIRE(sut.load() == &t);
+  }
+  SECTION("Can be constant-initialized") {
+    REQUIRE(g_current.load() == &g_table);
+  }
+}
+
+TEST_CASE("atomic_not_null<T*>::operator=(not_null<T*>)", "[ctor]") {
+  auto a = table{1};
+  auto b = table{2};
+  atomic_not_null<table*> sut{assume_not_null(&a)};
+
+  const auto result = (sut = assume_not_null(&b));
+
+  SECTION("Stores the input") {
+    REQUIRE(sut.load() == &b);
+  }
+  SECTION("Returns the input") {
+    REQUIRE(result == &b);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Operations
+//-----------------------------------------------------------------------------
+
+TEST_CASE("atomic_not_null<T*>::is_lock_free()", "[operations]") {
+  auto t = table{1};
+  const atomic_not_null<table*> sut{assume_not_null(&t)};
+
+  REQUIRE(sut.is_lock_free());
+}
+
+TEST_CASE("atomic_not_null<T*>::store(not_null<T*>, std::memory_order)", "[operations]") {
+  auto a = table{1};
+  auto b = table{2};
+  atomic_not_null<table*> sut{assume_not_null(&a)};
+
+  sut.store(assume_not_null(&b), std::memory_order_release);
+
+  REQUIRE(sut.load(std::memory_order_acquire) == &b);
+}
+
+TEST_CASE("atomic_not_null<T*>::operator not_null<T*>()", "[operations]") {
+  auto t = table{1};
+  const atomic_not_null<table*> sut{assume_not_null(&t)};
+
+  const not_null<table*> result = sut;
+
+  REQUIRE(result == &t);
+}
+
+TEST_CASE("atomic_not_null<T*>::exchange(not_null<T*>, std::memory_order)", "[operations]") {
+  auto a = table{1};
+  auto b = table{2};
+  atomic_not_null<table*> sut{assume_not_null(&a)};
+
+  const auto result = sut.exchange(assume_not_null(&b));
+
+  SECTION("Returns the previous pointer") {
+    REQUIRE(result == &a);
+  }
+  SECTION("Stores the input") {
+    REQUIRE(sut.load() == &b);
+  }
+}
+
+TEST_CASE("atomic_not_null<T*>::compare_exchange_strong(not_null<T*>&, not_null<T*>, std::memory_order)", "[operations]") {
+  auto a = table{1};
+  auto b = table{2};
+  auto c = table{3};
+  atomic_not_null<table*> sut{assume_not_null(&a)};
+
+  SECTION("Expected pointer is held") {
+    auto expected = assume_not_null(&a);
+
+    const auto result = sut.compare_exchange_strong(expected, assume_not_null(&b));
+
+    SECTION("Returns true") {
+      REQUIRE(result);
+    }
+    SECTION("Stores the desired pointer") {
+      REQUIRE(sut.load() == &b);
+    }
+    SECTION("Leaves expected unchanged") {
+      REQUIRE(expected == &a);
+    }
+  }
+  SECTION("Expected pointer is not held") {
+    auto expected = assume_not_null(&c);
+
+    const auto result = sut.compare_exchange_strong(
+      expected, assume_not_null(&b),
+      std::memory_order_acq_rel, std::memory_order_acquire
+    );
+
+    SECTION("Returns false") {
+      REQUIRE_FALSE(result);
+    }
+    SECTION("Does not store the desired pointer") {
+      REQUIRE(sut.load() == &a);
+    }
+    SECTION("Loads the held pointer into expected") {
+      REQUIRE(expected == &a);
+    }
+  }
+}
+
+TEST_CASE("atomic_not_null<T*>::compare_exchange_weak(not_null<T*>&, not_null<T*>, std::memory_order)", "[operations]") {
+  auto tables = std::vector<table>(4u);
+  atomic_not_null<table*> sut{assume_not_null(&tables[0])};
+
+  // Each thread advances the pointer by one element, so after all threads
+  // have finished, the pointer has advanced once per thread
+  auto threads = std::vector<std::thread>{};
+  for (auto i = 0u; i < 3u; ++i) {
+    threads.emplace_back([&sut]{
+      auto expected = sut.load();
+      while (!sut.compare_exchange_weak(expected, assume_not_null(expected.get() + 1))) {}
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(sut.load() == &tables[3]);
+}
+
+} // inline namespace bitwizeshift
+} // namespace NOT_NULL_NAMESPACE_INTERNAL
@@ -0,0 +1,674 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "intrusive_list.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <iterator>    // std::next
+#include <memory>      // std::unique_ptr
+#include <type_traits> // std::is_copy_constructible
+#include <utility>     // std::move
+#include <vector>      // std::vector
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+namespace {
+
+  struct node
+  {
+    explicit node(int v) : value{v}{}
+
+    int value;
+    intrusive_list_hook hook;
+  };
+
+  using list_type = intrusive_list<node, &node::hook>;
+
+  // Collects the values of 'list' from front to back
+  auto values_of(const list_type& list) -> std::vector<int>
+  {
+    auto result = std::vector<int>{};
+    for (const auto& n : list) {
+      result.push_back(n.value);
+    }
+    return result;
+  }
+
+  // Collects the values of 'list' from back to front
+  auto reverse_values_of(const list_type& list) -> std::vector<int>
+  {
+    auto result = std::vector<int>{};
+    for (auto it = list.rbegin(); it != list.rend(); ++it) {
+      result.push_back(it->value);
+    }
+    return result;
+  }
+
+} // namespace
+
+//=============================================================================
+// class : intrusive_list_hook
+//=============================================================================
+
+TEST_CASE("intrusive_list_hook", "[layout]") {
+  SECTION("Is the size of two pointers") {
+    STATIC_REQUIRE(sizeof(intrusive_list_hook) == 2u * sizeof(void*));
+  }
+}
+
+TEST_CASE("intrusive_list_hook::intrusive_list_hook()", "[ctor]") {
+  const auto sut = intrusive_list_hook{};
+
+  SECTION("Is not linked") {
+    REQUIRE_FALSE(sut.is_linked());
+  }
+}
+
+TEST_CASE("intrusive_list_hook::intrusive_list_hook(const intrusive_list_hook&)", "[ctor]") {
+  auto list = list_type{};
+  auto original = node{1};
+  list.push_back(original);
+
+  const auto sut = original;
+
+  SECTION("Copy is not linked") {
+    REQUIRE_FALSE(sut.hook.is_linked());
+  }
+  SECTION("Original remains linked") {
+    REQUIRE(original.hook.is_linked());
+    REQUIRE(values_of(list) == std::vector<int>{1});
+  }
+}
+
+TEST_CASE("intrusive_list_hook::operator=(const intrusive_list_hook&)", "[assignment]") {
+  auto list = list_type{};
+  auto a = node{1};
+  auto b = node{2};
+  list.push_back(a);
+
+  b = a;
+
+  SECTION("Destination remains unlinked") {
+    REQUIRE_FALSE(b.hook.is_linked());
+  }
+  SECTION("Source remains linked") {
+    REQUIRE(a.hook.is_linked());
+    REQUIRE(values_of(list) == std::vector<int>{1});
+  }
+}
+
+TEST_CASE("intrusive_list_hook::~intrusive_list_hook()", "[dtor]") {
+  auto list = list_type{};
+  auto a = node{1};
+  auto c = node{3};
+  list.push_back(a);
+  {
+    auto b = node{2};
+    list.push_back(b);
+    list.push_back(c);
+
+    REQUIRE(values_of(list) == (std::vector<int>{1, 2, 3}));
+  }
+
+  SECTION("Unlinks the destroyed element") {
+    REQUIRE(values_of(list) == (std::vector<int>{1, 3}));
+    REQUIRE(reverse_values_of(list) == (std::vector<int>{3, 1}));
+  }
+}
+
+TEST_CASE("intrusive_list_hook::unlink()", "[modifiers]") {
+  auto list = list_type{};
+  auto a = node{1};
+  auto b = node{2};
+  auto c = node{3};
+  list.push_back(a);
+  list.push_back(b);
+  list.push_back(c);
+
+  SECTION("Hook is in the middle of a list") {
+    b.hook.unlink();
+
+    SECTION("Removes the element from the list") {
+      REQUIRE(values_of(list) == (std::vector<int>{1, 3}));
+      REQUIRE(reverse_values_of(list) == (std::vector<int>{3, 1}));
+    }
+    SECTION("Hook is no longer linked") {
+      REQUIRE_FALSE(b.hook.is_linked());
+    }
+  }
+  SECTION("Hook is the only element of a list") {
+    a.hook.unlink();
+    c.hook.unlink();
+    b.hook.unlink();
+
+    SECTION("List is empty") {
+      REQUIRE(list.empty());
+    }
+  }
+  SECTION("Hook is not linked") {
+    auto d = node{4};
+    d.hook.unlink();
+
+    SECTION("Has no effect") {
+      REQUIRE_FALSE(d.hook.is_linked());
+      REQUIRE(values_of(list) == (std::vector<int>{1, 2, 3}));
+    }
+  }
+}
+
+//=============================================================================
+// class : intrusive_list
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment / Destructor
+//-----------------------------------------------------------------------------
+
+TEST_CASE("intrusive_list<T,Hook>", "[layout]") {
+  SECTION("Is the size of a hook") {
+    STATIC_REQUIRE(sizeof(list_type) == sizeof(intrusive_list_hook));
+  }
+  SECTION("Is not copyable") {
+    STATIC_REQUIRE_FALSE(std::is_copy_constructible<list_type>::value);
+    STATIC_REQUIRE_FALSE(std::is_copy_assignable<list_type>::value);
+  }
+}
+
+TEST_CASE("intrusive_list<T,Hook>::intrusive_list()", "[ctor]") {
+  const auto sut = list_type{};
+
+  SECTION("Is empty") {
+    REQUIRE(sut.empty());
+    REQUIRE(sut.size() == 0u);
+    REQUIRE(sut.begin() == sut.end());
+  }
+}
+
+TEST_CASE("intrusive_list<T,Hook>::intrusive_list(intrusive_list&&)", "[ctor]") {
+  auto a = node{1};
+  auto b = node{2};
+
+  SECTION("Other list is empty") {
+    auto other = list_type{};
+    const auto sut = std::move(other);
+
+    SECTION("List is empty") {
+      REQUIRE(sut.empty());
+    }
+    SECTION("Other list is empty") {
+      REQUIRE(other.empty());
+    }
+  }
+  SECTION("Other list has elements") {
+    auto other = list_type{};
+    other.push_back(a);
+    other.push_back(b);
+
+    const auto sut = std::move(other);
+
+    SECTION("List takes the elements") {
+      REQUIRE(values_of(sut) == (std::vector<int>{1, 2}));
+      REQUIRE(reverse_values_of(sut) == (std::vector<int>{2, 1}));
+    }
+    SECTION("Other list is empty") {
+      REQUIRE(other.empty());
+    }
+  }
+}
+
+TEST_CASE("intrusive_list<T,Hook>::operator=(intrusive_list&&)", "[assignment]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto c = node{3};
+
+  auto sut = list_type{};
+  sut.push_back(a);
+
+  auto other = list_type{};
+  other.push_back(b);
+  other.push_back(c);
+
+  sut = std::move(other);
+
+  SECTION("Previous elements are unlinked") {
+    REQUIRE_FALSE(a.hook.is_linked());
+  }
+  SECTION("List takes the elements") {
+    REQUIRE(values_of(sut) == (std::vector<int>{2, 3}));
+  }
+  SECTION("Other list is empty") {
+    REQUIRE(other.empty());
+  }
+}
+
+TEST_CASE("intrusive_list<T,Hook>::~intrusive_list()", "[dtor]") {
+  auto a = node{1};
+  auto b = node{2};
+  {
+    auto sut = list_type{};
+    sut.push_back(a);
+    sut.push_back(b);
+  }
+
+  SECTION("Elements are unlinked") {
+    REQUIRE_FALSE(a.hook.is_linked());
+    REQUIRE_FALSE(b.hook.is_linked());
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Iterators
+//-----------------------------------------------------------------------------
+
+TEST_CASE("intrusive_list<T,Hook>::iterator_to(T&)", "[iterators]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto sut = list_type{};
+  sut.push_back(a);
+  sut.push_back(b);
+
+  const auto it = list_type::iterator_to(b);
+
+  SECTION("Refers to the element") {
+    REQUIRE(&*it == &b);
+  }
+  SECTION("Iterates from the element") {
+    REQUIRE(std::next(it) == sut.end());
+    REQUIRE(&*std::prev(it) == &a);
+  }
+}
+
+TEST_CASE("intrusive_list<T,Hook>::iterator", "[iterators]") {
+  SECTION("Converts to const_iterator") {
+    STATIC_REQUIRE(std::is_convertible<list_type::iterator,list_type::const_iterator>::value);
+    STATIC_REQUIRE_FALSE(std::is_convertible<list_type::const_iterator,list_type::iterator>::value);
+  }
+  SECTION("Is a bidirectional iterator") {
+    using category = std::iterator_traits<list_type::iterator>::iterator_category;
+
+    STATIC_REQUIRE(std::is_same<category,std::bidirectional_iterator_tag>::value);
+  }
+  SECTION("Elements are larger than the stack") {
+    // The hook is after a payload larger than a typical 8 MiB stack, so
+    // finding the element must not need a T-sized temporary
+    struct large_node
+    {
+      unsigned char payload[16u * 1024u * 1024u];
+      int value;
+      intrusive_list_hook hook;
+    };
+
+    auto element = std::unique_ptr<large_node>{new large_node};
+    element->value = 42;
+    auto list = intrusive_list<large_node, &large_node::hook>{};
+    list.push_back(*element);
+
+    REQUIRE(&list.front() == element.get());
+    REQUIRE(list.begin()->value == 42);
+
+    list.clear();
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Modifiers
+//-----------------------------------------------------------------------------
+
+TEST_CASE("intrusive_list<T,Hook>::push_front(T&)", "[modifiers]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto sut = list_type{};
+
+  sut.push_front(a);
+  sut.push_front(b);
+
+  SECTION("Links elements at the front") {
+    REQUIRE(values_of(sut) == (std::vector<int>{2, 1}));
+    REQUIRE(reverse_values_of(sut) == (std::vector<int>{1, 2}));
+    REQUIRE(&sut.front() == &b);
+    REQUIRE(&sut.back() == &a);
+  }
+}
+
+TEST_CASE("intrusive_list<T,Hook>::push_back(T&)", "[modifiers]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto sut = list_type{};
+
+  sut.push_back(a);
+  sut.push_back(b);
+
+  SECTION("Links elements at the back") {
+    REQUIRE(values_of(sut) == (std::vector<int>{1, 2}));
+    REQUIRE(reverse_values_of(sut) == (std::vector<int>{2, 1}));
+    REQUIRE(sut.size() == 2u);
+    REQUIRE(&sut.front() == &a);
+    REQUIRE(&sut.back() == &b);
+  }
+}
+
+TEST_CASE("intrusive_list<T,Hook>::pop_front()", "[modifiers]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto sut = list_type{};
+  sut.push_back(a);
+  sut.push_back(b);
+
+  sut.pop_front();
+
+  SECTION("Unlinks the first element") {
+    REQUIRE_FALSE(a.hook.is_linked());
+    REQUIRE(values_of(sut) == std::vector<int>{2});
+  }
+}
+
+TEST_CASE("intrusive_list<T,Hook>::pop_back()", "[modifiers]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto sut = list_type{};
+  sut.push_back(a);
+  sut.push_back(b);
+
+  sut.pop_back();
+
+  SECTION("Unlinks the last element") {
+    REQUIRE_FALSE(b.hook.is_linked());
+    REQUIRE(values_of(sut) == std::vector<int>{1});
+  }
+}
+
+TEST_CASE("intrusive_list<T,Hook>::insert(const_iterator, T&)", "[modifiers]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto c = node{3};
+  auto sut = list_type{};
+  sut.push_back(a);
+  sut.push_back(c);
+
+  const auto result = sut.insert(list_type::iterator_to(c), b);
+
+  SECTION("Links the element before the position") {
+    REQUIRE(values_of(sut) == (std::vector<int>{1, 2, 3}));
+    REQUIRE(reverse_values_of(sut) == (std::vector<int>{3, 2, 1}));
+  }
+  SECTION("Returns an iterator to the element") {
+    REQUIRE(&*result == &b);
+  }
+}
+
+TEST_CASE("intrusive_list<T,Hook>::erase(const_iterator)", "[modifiers]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto c = node{3};
+  auto sut = list_type{};
+  sut.push_back(a);
+  sut.push_back(b);
+  sut.push_back(c);
+
+  const auto result = sut.erase(list_type::iterator_to(b));
+
+  SECTION("Unlinks the element") {
+    REQUIRE_FALSE(b.hook.is_linked());
+    REQUIRE(values_of(sut) == (std::vector<int>{1, 3}));
+  }
+  SECTION("Returns an iterator to the following element") {
+    REQUIRE(&*result == &c);
+  }
+}
+
+TEST_CASE("intrusive_list<T,Hook>::erase(const_iterator, const_iterator)", "[modifiers]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto c = node{3};
+  auto sut = list_type{};
+  sut.push_back(a);
+  sut.push_back(b);
+  sut.push_back(c);
+
+  const auto result = sut.erase(sut.begin(), list_type::iterator_to(c));
+
+  SECTION("Unlinks the elements in the range") {
+    REQUIRE_FALSE(a.hook.is_linked());
+    REQUIRE_FALSE(b.hook.is_linked());
+    REQUIRE(values_of(sut) == std::vector<int>{3});
+  }
+  SECTION("Returns the end of the range") {
+    REQUIRE(&*result == &c);
+  }
+}
+
+TEST_CASE("intrusive_list<T,Hook>::clear()", "[modifiers]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto sut = list_type{};
+  sut.push_back(a);
+  sut.push_back(b);
+
+  sut.clear();
+
+  SECTION("List is empty") {
+    REQUIRE(sut.empty());
+  }
+  SECTION("Elements are unlinked") {
+    REQUIRE_FALSE(a.hook.is_linked());
+    REQUIRE_FALSE(b.hook.is_linked());
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("intrusive_list<T,Hook>::splice(const_iterator, intrusive_list&)", "[modifiers]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto c = node{3};
+  auto d = node{4};
+  auto sut = list_type{};
+  sut.push_back(a);
+  sut.push_back(d);
+
+  auto other = list_type{};
+
+  SECTION("Other list is empty") {
+    sut.splice(list_type::iterator_to(d), other);
+
+    SECTION("List is unchanged") {
+      REQUIRE(values_of(sut) == (std::vector<int>{1, 4}));
+      REQUIRE(reverse_values_of(sut) == (std::vector<int>{4, 1}));
+    }
+  }
+  SECTION("Other list has elements") {
+    other.push_back(b);
+    other.push_back(c);
+
+    sut.splice(list_type::iterator_to(d), other);
+
+    SECTION("Elements are moved before the position") {
+      REQUIRE(values_of(sut) == (std::vector<int>{1, 2, 3, 4}));
+      REQUIRE(reverse_values_of(sut) == (std::vector<int>{4, 3, 2, 1}));
+    }
+    SECTION("Other list is empty") {
+      REQUIRE(other.empty());
+    }
+  }
+  SECTION("Position is the end") {
+    other.push_back(b);
+    other.push_back(c);
+
+    sut.splice(sut.end(), other);
+
+    SECTION("Elements are moved to the back") {
+      REQUIRE(values_of(sut) == (std::vector<int>{1, 4, 2, 3}));
+      REQUIRE(reverse_values_of(sut) == (std::vector<int>{3, 2, 4, 1}));
+    }
+  }
+}
+
+TEST_CASE("intrusive_list<T,Hook>::splice(const_iterator, intrusive_list&, const_iterator)", "[modifiers]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto c = node{3};
+  auto sut = list_type{};
+  sut.push_back(a);
+  sut.push_back(b);
+  sut.push_back(c);
+
+  SECTION("Element is moved from another list") {
+    auto d = node{4};
+    auto other = list_type{};
+    other.push_back(d);
+
+    sut.splice(sut.begin(), other, other.begin());
+
+    SECTION("Element is moved before the position") {
+      REQUIRE(values_of(sut) == (std::vector<int>{4, 1, 2, 3}));
+    }
+    SECTION("Other list is empty") {
+      REQUIRE(other.empty());
+    }
+  }
+  SECTION("Element is moved within the list") {
+    sut.splice(sut.end(), sut, sut.begin());
+
+    SECTION("Element is moved before the position") {
+      REQUIRE(values_of(sut) == (std::vector<int>{2, 3, 1}));
+      REQUIRE(reverse_values_of(sut) == (std::vector<int>{1, 3, 2}));
+    }
+  }
+  SECTION("Position is the element") {
+    sut.splice(list_type::iterator_to(b), sut, list_type::iterator_to(b));
+
+    SECTION("List is unchanged") {
+      REQUIRE(values_of(sut) == (std::vector<int>{1, 2, 3}));
+      REQUIRE(reverse_values_of(sut) == (std::vector<int>{3, 2, 1}));
+    }
+  }
+  SECTION("Position follows the element") {
+    sut.splice(list_type::iterator_to(c), sut, list_type::iterator_to(b));
+
+    SECTION("List is unchanged") {
+      REQUIRE(values_of(sut) == (std::vector<int>{1, 2, 3}));
+      REQUIRE(reverse_values_of(sut) == (std::vector<int>{3, 2, 1}));
+    }
+  }
+}
+
+TEST_CASE("intrusive_list<T,Hook>::splice(const_iterator, intrusive_list&, const_iterator, const_iterator)", "[modifiers]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto c = node{3};
+  auto d = node{4};
+  auto sut = list_type{};
+  sut.push_back(a);
+  sut.push_back(b);
+  sut.push_back(c);
+  sut.push_back(d);
+
+  SECTION("Range is empty") {
+    sut.splice(sut.begin(), sut, list_type::iterator_to(c), list_type::iterator_to(c));
+
+    SECTION("List is unchanged") {
+      REQUIRE(values_of(sut) == (std::vector<int>{1, 2, 3, 4}));
+    }
+  }
+  SECTION("Range is moved to the front") {
+    sut.splice(sut.begin(), sut, list_type::iterator_to(c), sut.end());
+
+    SECTION("Elements are moved before the position") {
+      REQUIRE(values_of(sut) == (std::vector<int>{3, 4, 1, 2}));
+      REQUIRE(reverse_values_of(sut) == (std::vector<int>{2, 1, 4, 3}));
+    }
+  }
+  SECTION("Position is the end of the range") {
+    sut.splice(list_type::iterator_to(d), sut, list_type::iterator_to(b), list_type::iterator_to(d));
+
+    SECTION("List is unchanged") {
+      REQUIRE(values_of(sut) == (std::vector<int>{1, 2, 3, 4}));
+      REQUIRE(reverse_values_of(sut) == (std::vector<int>{4, 3, 2, 1}));
+    }
+  }
+  SECTION("Range is moved from another list") {
+    auto other = list_type{};
+    other.splice(other.end(), sut, sut.begin(), list_type::iterator_to(d));
+
+    SECTION("Range is removed from the source") {
+      REQUIRE(values_of(sut) == std::vector<int>{4});
+    }
+    SECTION("Elements are moved before the position") {
+      REQUIRE(values_of(other) == (std::vector<int>{1, 2, 3}));
+      REQUIRE(reverse_values_of(other) == (std::vector<int>{3, 2, 1}));
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_CASE("intrusive_list<T,Hook>::swap(intrusive_list&)", "[modifiers]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto c = node{3};
+
+  SECTION("Both lists have elements") {
+    auto sut = list_type{};
+    sut.push_back(a);
+    auto other = list_type{};
+    other.push_back(b);
+    other.push_back(c);
+
+    sut.swap(other);
+
+    SECTION("Elements are exchanged") {
+      REQUIRE(values_of(sut) == (std::vector<int>{2, 3}));
+      REQUIRE(reverse_values_of(sut) == (std::vector<int>{3, 2}));
+      REQUIRE(values_of(other) == std::vector<int>{1});
+    }
+  }
+  SECTION("One list is empty") {
+    auto sut = list_type{};
+    auto other = list_type{};
+    other.push_back(b);
+    other.push_back(c);
+
+    swap(sut, other);
+
+    SECTION("Elements are exchanged") {
+      REQUIRE(values_of(sut) == (std::vector<int>{2, 3}));
+      REQUIRE(other.empty());
+    }
+  }
+  SECTION("Both lists are empty") {
+    auto sut = list_type{};
+    auto other = list_type{};
+
+    sut.swap(other);
+
+    SECTION("Both lists remain empty") {
+      REQUIRE(sut.empty());
+      REQUIRE(other.empty());
+    }
+  }
+}
+
+} // inline namespace bitwizeshift
+} // namespace NOT_NULL_NAMESPACE_INTERNAL
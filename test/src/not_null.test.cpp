@@ -26,6 +26,11 @@
 
 #include <catch2/catch.hpp>
 
+#include <cstddef> // std::nullptr_t
+#include <cstring> // std::memset
+#include <string>  // std::string
+#include <vector>  // std::vector
+
 namespace NOT_NULL_NAMESPACE_INTERNAL {
 inline namespace bitwizeshift {
 
@@ -332,6 +337,13 @@ TEST_CASE("not_null<T>::as_nullable() &&", "[observers]") {
   SECTION("Returns underlying type") {
     STATIC_REQUIRE(std::is_same<decltype(input)&&,decltype(std::move(sut).as_nullable())>::value);
   }
+  SECTION("not_null is moved from") {
+    const auto owner = std::move(sut).as_nullable();
+
+    SECTION("Gets the moved-from pointer") {
+      REQUIRE(std::move(sut).as_nullable() == nullptr);
+    }
+  }
 }
 
 TEST_CASE("not_null<T>::operator->()", "[observers]") {
@@ -396,6 +408,400 @@ TEST_CASE("check_not_null(U&&)", "[utilities]") {
   }
 }
 
+TEST_CASE("not_null_contract_violation::what()", "[utilities]") {
+  const auto sut = not_null_contract_violation{};
+
+  SECTION("Describes the violation") {
+    REQUIRE(std::string{sut.what()}.find("null") != std::string::npos);
+  }
+  SECTION("Has no call site") {
+    REQUIRE(sut.call_site().file == nullptr);
+    REQUIRE(sut.call_site().line == 0u);
+    REQUIRE(sut.call_site().function == nullptr);
+  }
+}
+
+TEST_CASE("check_not_null(U&&, const not_null_call_site&)", "[utilities]") {
+  SECTION("Input is null") {
+    const auto* input = static_cast<int*>(nullptr);
+    const auto expected_line = static_cast<unsigned>(__LINE__ + 3);
+
+    try {
+      check_not_null(input, NOT_NULL_CALL_SITE);
+      FAIL("check_not_null did not throw");
+    } catch (const not_null_contract_violation& e) {
+      SECTION("Reports the file of the call site") {
+        REQUIRE(std::string{e.call_site().file} == __FILE__);
+      }
+      SECTION("Reports the line of the call site") {
+        REQUIRE(e.call_site().line == expected_line);
+      }
+      SECTION("Reports the function of the call site") {
+        REQUIRE(e.call_site().function != nullptr);
+      }
+    }
+  }
+  SECTION("Input is not null") {
+    int value = 42;
+    const auto sut = check_not_null(&value, NOT_NULL_CALL_SITE);
+
+    SECTION("Produces a not_null to the input") {
+      REQUIRE(sut.get() == &value);
+    }
+  }
+}
+
+namespace {
+
+  not_null_call_site g_handled_site = {nullptr, 0u, nullptr};
+  int g_handled_count = 0;
+
+  auto recording_handler(const not_null_call_site& site) -> void
+  {
+    g_handled_site = site;
+    ++g_handled_count;
+  }
+
+  struct custom_error{};
+
+  auto throwing_handler(const not_null_call_site&) -> void
+  {
+    throw custom_error{};
+  }
+
+} // namespace
+
+TEST_CASE("set_not_null_violation_handler(not_null_violation_handler)", "[utilities]") {
+  g_handled_count = 0;
+  const auto previous = set_not_null_violation_handler(&recording_handler);
+
+  SECTION("Returns the previous handler") {
+    REQUIRE(previous == nullptr);
+  }
+  SECTION("Installs the handler") {
+    REQUIRE(get_not_null_violation_handler() == &recording_handler);
+  }
+  SECTION("Contract is violated") {
+    const auto* input = static_cast<int*>(nullptr);
+    const auto expected_line = static_cast<unsigned>(__LINE__ + 3);
+
+    try {
+      check_not_null(input, NOT_NULL_CALL_SITE);
+    } catch (const not_null_contract_violation&) {}
+
+    SECTION("Calls the handler once") {
+      REQUIRE(g_handled_count == 1);
+    }
+    SECTION("Passes the call site to the handler") {
+      REQUIRE(g_handled_site.line == expected_line);
+    }
+  }
+  SECTION("Handler returns") {
+    const auto* input = static_cast<int*>(nullptr);
+
+    SECTION("Throws null contract violation") {
+      REQUIRE_THROWS_AS(check_not_null(input), not_null_contract_violation);
+    }
+  }
+  SECTION("Handler throws") {
+    const auto* input = static_cast<int*>(nullptr);
+    set_not_null_violation_handler(&throwing_handler);
+
+    SECTION("Propagates the handler's exception") {
+      REQUIRE_THROWS_AS(check_not_null(input), custom_error);
+    }
+  }
+
+  set_not_null_violation_handler(nullptr);
+}
+
+//-----------------------------------------------------------------------------
+// Bulk Utilities
+//-----------------------------------------------------------------------------
+
+TEST_CASE("find_null(T* const*, std::size_t)", "[utilities]") {
+  int value = 42;
+  auto input = std::vector<int*>(100u, &value);
+
+  SECTION("Range is empty") {
+    SECTION("Returns 0") {
+      REQUIRE(find_null(input.data(), 0u) == 0u);
+    }
+  }
+  SECTION("Range contains no null pointers") {
+    SECTION("Returns size of range") {
+      REQUIRE(find_null(input.data(), input.size()) == input.size());
+    }
+  }
+  SECTION("Range contains null pointers") {
+    SECTION("Returns index of first null pointer") {
+      // Covers nulls within a full block, as well as in the trailing elements
+      for (auto i = std::size_t{0u}; i < input.size(); ++i) {
+        auto copy = input;
+        copy[i] = nullptr;
+        copy.back() = nullptr;
+
+        REQUIRE(find_null(copy.data(), copy.size()) == i);
+      }
+    }
+  }
+}
+
+TEST_CASE("check_all_not_null(T* const*, std::size_t)", "[utilities]") {
+  int value = 42;
+  auto input = std::vector<const int*>(100u, &value);
+
+  SECTION("Range contains null pointers") {
+    input[57] = nullptr;
+
+    SECTION("Throws null contract violation") {
+      REQUIRE_THROWS_AS(
+        check_all_not_null(input.data(), input.size()),
+        not_null_contract_violation
+      );
+    }
+  }
+  SECTION("Range contains no null pointers") {
+    SECTION("Does not throw contract violation") {
+      REQUIRE_NOTHROW(check_all_not_null(input.data(), input.size()));
+    }
+  }
+}
+
+TEST_CASE("check_not_null_range(T*, std::size_t)", "[utilities]") {
+  SECTION("Range contains null pointers") {
+    auto input = std::vector<std::unique_ptr<int>>{};
+    input.emplace_back(new int{1});
+    input.emplace_back(nullptr);
+
+    SECTION("Throws null contract violation") {
+      REQUIRE_THROWS_AS(
+        check_not_null_range(input.data(), input.size()),
+        not_null_contract_violation
+      );
+    }
+  }
+  SECTION("Range contains no null pointers") {
+    auto input = std::vector<std::unique_ptr<int>>{};
+    input.emplace_back(new int{1});
+    input.emplace_back(new int{2});
+    auto* const expected = input[1].get();
+
+    auto* sut = check_not_null_range(input.data(), input.size());
+
+    SECTION("Views the input range in-place") {
+      REQUIRE(static_cast<void*>(sut) == static_cast<void*>(input.data()));
+    }
+    SECTION("Elements refer to the same pointers") {
+      REQUIRE(sut[1].get() == expected);
+    }
+    SECTION("Elements can be moved out of") {
+      auto p = std::move(sut[1]).as_nullable();
+
+      REQUIRE(p.get() == expected);
+      REQUIRE(input[1] == nullptr);
+    }
+  }
+  SECTION("Range contains raw pointers") {
+    int value = 42;
+    auto input = std::vector<int*>(100u, &value);
+
+    SECTION("Range contains null pointers") {
+      input[99] = nullptr;
+
+      SECTION("Throws null contract violation") {
+        REQUIRE_THROWS_AS(
+          check_not_null_range(input.data(), input.size()),
+          not_null_contract_violation
+        );
+      }
+    }
+    SECTION("Range contains no null pointers") {
+      SECTION("Elements refer to the same pointers") {
+        const auto* sut = check_not_null_range(
+          static_cast<const std::vector<int*>&>(input).data(),
+          input.size()
+        );
+
+        REQUIRE(sut[99] == &value);
+      }
+    }
+  }
+  SECTION("not_null has the same layout as the underlying pointer") {
+    STATIC_REQUIRE(sizeof(not_null<int*>) == sizeof(int*));
+    STATIC_REQUIRE(alignof(not_null<int*>) == alignof(int*));
+    STATIC_REQUIRE(std::is_standard_layout<not_null<int*>>::value);
+    STATIC_REQUIRE(sizeof(not_null<std::unique_ptr<int>>) == sizeof(std::unique_ptr<int>));
+  }
+}
+
+TEST_CASE("assume_not_null_range(T*, std::size_t)", "[utilities]") {
+  auto input = std::vector<std::shared_ptr<int>>{
+    std::make_shared<int>(1),
+    std::make_shared<int>(2),
+  };
+
+  const auto* sut = assume_not_null_range(
+    static_cast<const std::vector<std::shared_ptr<int>>&>(input).data(),
+    input.size()
+  );
+
+  SECTION("Views the input range in-place") {
+    REQUIRE(static_cast<const void*>(sut) == static_cast<const void*>(input.data()));
+  }
+  SECTION("Elements refer to the same pointers") {
+    REQUIRE(sut[0] == input[0]);
+    REQUIRE(sut[1] == input[1]);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Smart Pointer Factories
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  // An allocator that counts its allocations, and fills new storage with a
+  // pattern so that uninitialized objects can be told apart
+  template <typename T>
+  struct pattern_allocator
+  {
+    using value_type = T;
+
+    explicit pattern_allocator(int* allocations) noexcept
+      : allocations{allocations}
+    {
+
+    }
+
+    template <typename U>
+    pattern_allocator(const pattern_allocator<U>& other) noexcept
+      : allocations{other.allocations}
+    {
+
+    }
+
+    auto allocate(std::size_t n) -> T*
+    {
+      *allocations += 1;
+      auto* p = std::allocator<T>{}.allocate(n);
+      std::memset(static_cast<void*>(p), 0xab, n * sizeof(T));
+      return p;
+    }
+
+    auto deallocate(T* p, std::size_t n) -> void
+    {
+      std::allocator<T>{}.deallocate(p, n);
+    }
+
+    int* allocations;
+  };
+
+  template <typename T, typename U>
+  auto operator==(const pattern_allocator<T>& lhs, const pattern_allocator<U>& rhs)
+    noexcept -> bool
+  {
+    return lhs.allocations == rhs.allocations;
+  }
+
+  template <typename T, typename U>
+  auto operator!=(const pattern_allocator<T>& lhs, const pattern_allocator<U>& rhs)
+    noexcept -> bool
+  {
+    return !(lhs == rhs);
+  }
+
+  struct buffer
+  {
+    unsigned char data[64];
+  };
+
+} // namespace
+
+TEST_CASE("make_not_null_unique<T>(Args&&...)", "[factories]") {
+  SECTION("Constructs the object from the arguments") {
+    const auto sut = make_not_null_unique<std::string>(3u, 'x');
+
+    REQUIRE(*sut == "xxx");
+  }
+  SECTION("Value-initializes the object without arguments") {
+    const auto sut = make_not_null_unique<buffer>();
+
+    REQUIRE(sut->data[0] == 0u);
+  }
+}
+
+TEST_CASE("make_not_null_unique_for_overwrite<T>()", "[factories]") {
+  auto sut = make_not_null_unique_for_overwrite<buffer>();
+  sut->data[0] = 42u;
+
+  REQUIRE(sut->data[0] == 42u);
+}
+
+TEST_CASE("make_not_null_shared<T>(Args&&...)", "[factories]") {
+  const auto sut = make_not_null_shared<std::string>(3u, 'x');
+
+  SECTION("Constructs the object from the arguments") {
+    REQUIRE(*sut == "xxx");
+  }
+  SECTION("Is the only owner") {
+    REQUIRE(sut.as_nullable().use_count() == 1);
+  }
+}
+
+TEST_CASE("make_not_null_shared_for_overwrite<T>()", "[factories]") {
+  SECTION("Type is trivial") {
+    auto sut = make_not_null_shared_for_overwrite<buffer>();
+    sut->data[0] = 42u;
+
+    REQUIRE(sut->data[0] == 42u);
+  }
+  SECTION("Type has a default constructor") {
+    const auto sut = make_not_null_shared_for_overwrite<std::string>();
+
+    REQUIRE(sut->empty());
+  }
+}
+
+TEST_CASE("allocate_not_null_shared<T>(const Allocator&, Args&&...)", "[factories]") {
+  auto allocations = 0;
+  const auto alloc = pattern_allocator<buffer>{&allocations};
+
+  SECTION("Allocates the object and control block together") {
+    const auto sut = allocate_not_null_shared<std::string>(alloc, 3u, 'x');
+
+    REQUIRE(*sut == "xxx");
+    REQUIRE(allocations == 1);
+  }
+  SECTION("Value-initializes the object without arguments") {
+    const auto sut = allocate_not_null_shared<buffer>(alloc);
+
+    REQUIRE(sut->data[0] == 0u);
+  }
+}
+
+TEST_CASE("allocate_not_null_shared_for_overwrite<T>(const Allocator&)", "[factories]") {
+  auto allocations = 0;
+  const auto alloc = pattern_allocator<buffer>{&allocations};
+
+  SECTION("Type is trivial") {
+    const auto sut = allocate_not_null_shared_for_overwrite<buffer>(alloc);
+
+    SECTION("Allocates the object and control block together") {
+      REQUIRE(allocations == 1);
+    }
+    SECTION("Leaves the object uninitialized") {
+      REQUIRE(sut->data[0] == 0xabu);
+    }
+  }
+  SECTION("Type has a default constructor") {
+    const auto sut = allocate_not_null_shared_for_overwrite<std::string>(alloc);
+
+    REQUIRE(sut->empty());
+    REQUIRE(allocations == 1);
+  }
+}
+
 //-----------------------------------------------------------------------------
 // Comparison
 //-----------------------------------------------------------------------------
@@ -456,6 +862,16 @@ TEST_CASE("operator==(const not_null<T>&, const U&)", "[comparison]") {
       REQUIRE_FALSE(lhs == rhs);
     }
   }
+
+  SECTION("lhs is moved from") {
+    auto lhs = assume_not_null(std::unique_ptr<int>{new int{42}});
+    const auto owner = std::move(lhs).as_nullable();
+    const auto rhs = std::unique_ptr<int>{};
+
+    SECTION("Compares equal to null") {
+      REQUIRE(lhs == rhs);
+    }
+  }
 }
 
 TEST_CASE("operator==(const T&, const not_null<U>&)", "[comparison]") {
@@ -820,5 +1236,147 @@ TEST_CASE("operator>=(const T& lhs, const not_null<U>& rhs)", "[comparison]") {
   }
 }
 
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  // A fancy pointer that is ordered with only 'operator<', as is common of
+  // those written before C++20
+  struct less_only_pointer
+  {
+    using element_type = int;
+
+    less_only_pointer(std::nullptr_t) : p{nullptr}{}
+    explicit less_only_pointer(int* p) : p{p}{}
+
+    auto operator*() const -> int& { return *p; }
+    auto operator->() const -> int* { return p; }
+
+    int* p;
+
+    friend auto operator==(less_only_pointer lhs, less_only_pointer rhs) -> bool
+    {
+      return lhs.p == rhs.p;
+    }
+    friend auto operator!=(less_only_pointer lhs, less_only_pointer rhs) -> bool
+    {
+      return lhs.p != rhs.p;
+    }
+    friend auto operator<(less_only_pointer lhs, less_only_pointer rhs) -> bool
+    {
+      return lhs.p < rhs.p;
+    }
+    friend auto operator==(less_only_pointer lhs, std::nullptr_t) -> bool
+    {
+      return lhs.p == nullptr;
+    }
+    friend auto operator!=(less_only_pointer lhs, std::nullptr_t) -> bool
+    {
+      return lhs.p != nullptr;
+    }
+  };
+
+} // namespace
+
+TEST_CASE("operator<(const not_null<T>&, const not_null<U>&) (T is only less-than comparable)", "[comparison]") {
+  int a[2] {};
+
+  SECTION("lhs is less than rhs") {
+    const auto lhs = check_not_null(less_only_pointer{&a[0]});
+    const auto rhs = check_not_null(less_only_pointer{&a[1]});
+
+    SECTION("Returns true") {
+      REQUIRE(lhs < rhs);
+    }
+  }
+  SECTION("lhs is not less than rhs") {
+    const auto lhs = check_not_null(less_only_pointer{&a[1]});
+    const auto rhs = check_not_null(less_only_pointer{&a[0]});
+
+    SECTION("Returns false") {
+      REQUIRE_FALSE(lhs < rhs);
+    }
+  }
+  SECTION("Compares with the underlying pointer") {
+    const auto lhs = check_not_null(less_only_pointer{&a[0]});
+    const auto rhs = less_only_pointer{&a[1]};
+
+    REQUIRE(lhs < rhs);
+    REQUIRE_FALSE(rhs < lhs);
+  }
+}
+
+//=============================================================================
+// Constant Expressions
+//=============================================================================
+
+namespace {
+
+  struct handler
+  {
+    int id;
+  };
+
+  struct derived_handler : handler
+  {
+    constexpr derived_handler(int i) : handler{i}{}
+  };
+
+  constexpr derived_handler g_first_handler{1};
+  constexpr derived_handler g_second_handler{2};
+
+  // Requires constant-initialization, using conversions from
+  // not_null<const derived_handler*> to not_null<const handler*>
+  constexpr not_null<const handler*> g_handler_table[] = {
+    assume_not_null(&g_first_handler),
+    check_not_null(&g_second_handler),
+    not_null<const handler*>{assume_not_null(&g_first_handler)},
+  };
+
+#if defined(__cpp_constinit)
+  constinit not_null<const handler*> g_mutable_handler = assume_not_null(&g_second_handler);
+#endif
+
+} // namespace
+
+TEST_CASE("not_null<T> (constexpr)", "[constexpr]") {
+  SECTION("Tables of not_null are constant-initialized") {
+    STATIC_REQUIRE(g_handler_table[0]->id == 1);
+    STATIC_REQUIRE(g_handler_table[1].get() == &g_second_handler);
+    STATIC_REQUIRE((*g_handler_table[2]).id == 1);
+  }
+  SECTION("Comparisons are constant expressions") {
+    STATIC_REQUIRE(g_handler_table[0] == g_handler_table[2]);
+    STATIC_REQUIRE(g_handler_table[0] != g_handler_table[1]);
+  }
+  SECTION("Copies are constant expressions") {
+    constexpr auto copy = g_handler_table[1];
+
+    STATIC_REQUIRE(copy.as_nullable() == &g_second_handler);
+  }
+  SECTION("Converting moves are constant expressions") {
+    constexpr auto converted = not_null<const handler*>{
+      not_null<const derived_handler*>{assume_not_null(&g_second_handler)}
+    };
+
+    STATIC_REQUIRE(converted->id == 2);
+  }
+  SECTION("Checks with a call site are constant expressions") {
+    constexpr auto checked = check_not_null(
+      &g_first_handler,
+      not_null_call_site{__FILE__, __LINE__, "test"}
+    );
+
+    STATIC_REQUIRE(checked->id == 1);
+  }
+#if defined(__cpp_constinit)
+  SECTION("constinit not_null can be reassigned") {
+    g_mutable_handler = g_handler_table[0];
+
+    REQUIRE(g_mutable_handler->id == 1);
+  }
+#endif
+}
+
 } // inline namespace bitwizeshift
 } // namespace NOT_NULL_NAMESPACE_INTERNAL
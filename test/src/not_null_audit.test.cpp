@@ -0,0 +1,101 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#if !defined(NOT_NULL_AUDIT_SAMPLING) || (NOT_NULL_AUDIT_SAMPLING != 4)
+# error "This test must be compiled with NOT_NULL_AUDIT_SAMPLING=4"
+#endif
+
+#include "not_null.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <memory> // std::unique_ptr
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+//=============================================================================
+// utilities : audit sampling
+//=============================================================================
+
+TEST_CASE("detail::audit_sample_due()", "[utilities]") {
+  // Synchronize with the start of the next interval
+  while (!detail::audit_sample_due()) {}
+
+  SECTION("Samples one in every NOT_NULL_AUDIT_SAMPLING calls") {
+    auto samples = 0;
+    for (auto i = 0; i < 40; ++i) {
+      samples += detail::audit_sample_due() ? 1 : 0;
+    }
+
+    REQUIRE(samples == 10);
+  }
+  SECTION("Samples the last call of each interval") {
+    REQUIRE_FALSE(detail::audit_sample_due());
+    REQUIRE_FALSE(detail::audit_sample_due());
+    REQUIRE_FALSE(detail::audit_sample_due());
+    REQUIRE(detail::audit_sample_due());
+  }
+}
+
+TEST_CASE("assume_not_null(U&&) (audited)", "[utilities]") {
+  SECTION("Input is not null") {
+    int value = 42;
+
+    SECTION("Produces a not_null to the input on every call") {
+      for (auto i = 0; i < 8; ++i) {
+        REQUIRE(assume_not_null(&value).get() == &value);
+      }
+    }
+  }
+  SECTION("Input is a smart pointer") {
+    SECTION("Transfers ownership on every call") {
+      for (auto i = 0; i < 8; ++i) {
+        auto* const p = new int{i};
+        const auto sut = assume_not_null(std::unique_ptr<int>{p});
+
+        REQUIRE(sut.get() == p);
+      }
+    }
+  }
+}
+
+TEST_CASE("check_not_null(U&&) (audited)", "[utilities]") {
+  while (!detail::audit_sample_due()) {}
+
+  int value = 42;
+  for (auto i = 0; i < 3; ++i) {
+    check_not_null(&value);
+  }
+
+  SECTION("Does not consume audit samples") {
+    REQUIRE_FALSE(detail::audit_sample_due());
+    REQUIRE_FALSE(detail::audit_sample_due());
+    REQUIRE_FALSE(detail::audit_sample_due());
+    REQUIRE(detail::audit_sample_due());
+  }
+}
+
+} // inline namespace bitwizeshift
+} // namespace NOT_NULL_NAMESPACE_INTERNAL
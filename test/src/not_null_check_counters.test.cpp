@@ -0,0 +1,228 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#if !defined(NOT_NULL_ENABLE_CHECK_COUNTERS)
+# error "This test must be compiled with NOT_NULL_ENABLE_CHECK_COUNTERS"
+#endif
+
+#include "not_null.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdio>  // std::tmpfile, std::fread
+#include <cstring> // std::strcmp
+#include <thread>  // std::thread
+#include <vector>  // std::vector
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+namespace {
+
+  auto find_counts(unsigned line) -> not_null_check_counts
+  {
+    for (const auto& c : collect_not_null_check_counts()) {
+      if (c.site.file != nullptr && std::strcmp(c.site.file, __FILE__) == 0 &&
+          c.site.line == line) {
+        return c;
+      }
+    }
+    return not_null_check_counts{not_null_call_site{nullptr, 0u, nullptr}, 0u, 0u};
+  }
+
+  auto checked_value(int* p, unsigned& line) -> int
+  {
+    line = static_cast<unsigned>(__LINE__ + 1);
+    return *check_not_null(p, NOT_NULL_CALL_SITE);
+  }
+
+  auto plain_checked_value(int* p, unsigned& line) -> int
+  {
+    line = static_cast<unsigned>(__LINE__ + 1);
+    return *check_not_null(p);
+  }
+
+  auto find_unknown_counts() -> not_null_check_counts
+  {
+    for (const auto& c : collect_not_null_check_counts()) {
+      if (c.site.file == nullptr) {
+        return c;
+      }
+    }
+    return not_null_check_counts{not_null_call_site{nullptr, 0u, nullptr}, 0u, 0u};
+  }
+
+} // namespace
+
+//=============================================================================
+// utilities : check counters
+//=============================================================================
+
+TEST_CASE("collect_not_null_check_counts()", "[utilities]") {
+  int value = 42;
+  auto line = 0u;
+  checked_value(&value, line);
+  const auto before = find_counts(line);
+
+  SECTION("Checks succeed") {
+    for (auto i = 0; i < 10; ++i) {
+      checked_value(&value, line);
+    }
+    const auto after = find_counts(line);
+
+    SECTION("Counts each execution") {
+      REQUIRE(after.checks - before.checks == 10u);
+    }
+    SECTION("Does not count failures") {
+      REQUIRE(after.failures == before.failures);
+    }
+  }
+  SECTION("Checks fail") {
+    for (auto i = 0; i < 3; ++i) {
+      try {
+        checked_value(nullptr, line);
+      } catch (const not_null_contract_violation&) {}
+    }
+    const auto after = find_counts(line);
+
+    SECTION("Counts each execution") {
+      REQUIRE(after.checks - before.checks == 3u);
+    }
+    SECTION("Counts each failure") {
+      REQUIRE(after.failures - before.failures == 3u);
+    }
+  }
+  SECTION("Checks run on other threads") {
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0; t < 4; ++t) {
+      threads.emplace_back([&value]{
+        auto l = 0u;
+        for (auto i = 0; i < 100; ++i) {
+          checked_value(&value, l);
+        }
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    const auto after = find_counts(line);
+
+    SECTION("Aggregates the counts of all threads") {
+      REQUIRE(after.checks - before.checks == 400u);
+    }
+  }
+}
+
+TEST_CASE("collect_not_null_check_counts() without a call site", "[utilities]") {
+  int value = 42;
+  auto line = 0u;
+  plain_checked_value(&value, line);
+#if defined(NOT_NULL_HAS_BUILTIN_CALL_SITE)
+  const auto before = find_counts(line);
+#else
+  const auto before = find_unknown_counts();
+#endif
+
+  for (auto i = 0; i < 5; ++i) {
+    try {
+      plain_checked_value((i % 2 == 0) ? &value : nullptr, line);
+    } catch (const not_null_contract_violation&) {}
+  }
+#if defined(NOT_NULL_HAS_BUILTIN_CALL_SITE)
+  const auto after = find_counts(line);
+#else
+  const auto after = find_unknown_counts();
+#endif
+
+  SECTION("Counts each execution") {
+    REQUIRE(after.checks - before.checks == 5u);
+  }
+  SECTION("Counts each failure") {
+    REQUIRE(after.failures - before.failures == 2u);
+  }
+}
+
+TEST_CASE("collect_not_null_check_counts() with unknown and known call sites", "[utilities]") {
+  static const char file[] = "slot_zero.cpp";
+
+  // Finds a line for which the call site hashes to the first slot of a
+  // thread's table, where checks without a call site would also hash
+  auto line = 1u;
+  while (((reinterpret_cast<std::size_t>(file) >> 3u) ^
+          (static_cast<std::size_t>(line) * 2654435761u)) & 255u) {
+    ++line;
+  }
+  const auto unknown_before = find_unknown_counts();
+
+  // A new thread starts with an empty table
+  std::thread{[line]{
+    int value = 42;
+    for (auto i = 0; i < 3; ++i) {
+      check_not_null(&value, not_null_call_site{nullptr, 0u, nullptr});
+    }
+    for (auto i = 0; i < 5; ++i) {
+      check_not_null(&value, not_null_call_site{file, line, "slot_zero"});
+    }
+  }}.join();
+
+  auto known = not_null_check_counts{not_null_call_site{nullptr, 0u, nullptr}, 0u, 0u};
+  for (const auto& c : collect_not_null_check_counts()) {
+    if (c.site.file != nullptr && std::strcmp(c.site.file, file) == 0 &&
+        c.site.line == line) {
+      known = c;
+    }
+  }
+  const auto unknown_after = find_unknown_counts();
+
+  SECTION("Counts the call site separately from unknown call sites") {
+    REQUIRE(known.checks == 5u);
+  }
+  SECTION("Counts checks without a call site under an unknown call site") {
+    REQUIRE(unknown_after.checks - unknown_before.checks == 3u);
+  }
+}
+
+TEST_CASE("dump_not_null_check_counts(std::FILE*)", "[utilities]") {
+  int value = 42;
+  auto line = 0u;
+  checked_value(&value, line);
+
+  auto* const file = std::tmpfile();
+  REQUIRE(file != nullptr);
+
+  dump_not_null_check_counts(file);
+
+  SECTION("Writes the counted call sites") {
+    std::rewind(file);
+    char buffer[4096] = {};
+    const auto size = std::fread(buffer, 1u, sizeof(buffer) - 1u, file);
+
+    REQUIRE(size > 0u);
+  }
+  std::fclose(file);
+}
+
+} // inline namespace bitwizeshift
+} // namespace NOT_NULL_NAMESPACE_INTERNAL
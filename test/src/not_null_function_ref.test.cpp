@@ -0,0 +1,205 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "not_null_function_ref.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <functional>  // std::function
+#include <memory>      // std::unique_ptr
+#include <string>      // std::string
+#include <type_traits> // std::is_trivially_copyable
+#include <utility>     // std::move
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+namespace {
+
+  auto twice(int x) -> int
+  {
+    return x * 2;
+  }
+
+  auto thrice(long x) -> long
+  {
+    return x * 3;
+  }
+
+  struct counter
+  {
+    auto operator()(int x) -> int
+    {
+      calls += 1;
+      return x + calls;
+    }
+
+    int calls;
+  };
+
+} // namespace
+
+//=============================================================================
+// class : not_null_function_ref
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Layout
+//-----------------------------------------------------------------------------
+
+TEST_CASE("not_null_function_ref<R(Args...)>", "[layout]") {
+  using sut_type = not_null_function_ref<int(int)>;
+
+  SECTION("Is two pointers in size") {
+    STATIC_REQUIRE(sizeof(sut_type) == 2u * sizeof(void*));
+  }
+  SECTION("Is trivially copyable") {
+    STATIC_REQUIRE(std::is_trivially_copyable<sut_type>::value);
+  }
+  SECTION("Is not default constructible") {
+    STATIC_REQUIRE_FALSE(std::is_default_constructible<sut_type>::value);
+  }
+  SECTION("Is not constructible from a nullable function pointer") {
+    STATIC_REQUIRE_FALSE(std::is_constructible<sut_type,int(*)(int)>::value);
+  }
+  SECTION("Is not constructible from an incompatible callable") {
+    STATIC_REQUIRE_FALSE(std::is_constructible<sut_type,counter*>::value);
+    STATIC_REQUIRE_FALSE(std::is_constructible<sut_type,std::string>::value);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+TEST_CASE("not_null_function_ref<R(Args...)>::not_null_function_ref(F&&)", "[ctor]") {
+  SECTION("Refers to the callable, rather than copying it") {
+    auto c = counter{0};
+    const not_null_function_ref<int(int)> sut = c;
+
+    sut(0);
+    sut(0);
+
+    REQUIRE(c.calls == 2);
+  }
+  SECTION("Calls a lambda") {
+    const auto offset = 5;
+    const auto lambda = [&](int x) { return x + offset; };
+    const not_null_function_ref<int(int)> sut = lambda;
+
+    REQUIRE(sut(1) == 6);
+  }
+  SECTION("Discards the result for void signatures") {
+    auto c = counter{0};
+    const not_null_function_ref<void(int)> sut = c;
+
+    sut(0);
+
+    REQUIRE(c.calls == 1);
+  }
+  SECTION("Forwards move-only arguments") {
+    const auto lambda = [](std::unique_ptr<int> p) { return *p; };
+    const not_null_function_ref<int(std::unique_ptr<int>)> sut = lambda;
+
+    REQUIRE(sut(std::unique_ptr<int>{new int{42}}) == 42);
+  }
+}
+
+TEST_CASE("not_null_function_ref<R(Args...)>::not_null_function_ref(FR(&)(FArgs...))", "[ctor]") {
+  SECTION("Function has the same signature") {
+    const not_null_function_ref<int(int)> sut = twice;
+
+    REQUIRE(sut(21) == 42);
+  }
+  SECTION("Function has a compatible signature") {
+    const not_null_function_ref<int(int)> sut = thrice;
+
+    REQUIRE(sut(14) == 42);
+  }
+}
+
+TEST_CASE("not_null_function_ref<R(Args...)>::not_null_function_ref(not_null<FR(*)(FArgs...)>)", "[ctor]") {
+  const auto p = assume_not_null(&twice);
+  const not_null_function_ref<int(int)> sut = p;
+
+  REQUIRE(sut(21) == 42);
+}
+
+TEST_CASE("not_null_function_ref<R(Args...)>::operator=(const not_null_function_ref&)", "[ctor]") {
+  auto c = counter{0};
+  not_null_function_ref<int(int)> sut = twice;
+
+  sut = not_null_function_ref<int(int)>{c};
+  sut(0);
+
+  REQUIRE(c.calls == 1);
+}
+
+//=============================================================================
+// class : not_null<std::function>
+//=============================================================================
+
+TEST_CASE("check_not_null(std::function<R(Args...)>)", "[factories]") {
+  SECTION("Function is empty") {
+    auto f = std::function<int(int)>{};
+
+#if !defined(NOT_NULL_DISABLE_EXCEPTIONS)
+    REQUIRE_THROWS_AS(check_not_null(f), not_null_contract_violation);
+#endif
+  }
+  SECTION("Function is not empty") {
+    const auto sut = check_not_null(std::function<int(int)>{twice});
+
+    SECTION("Is contextually true") {
+      REQUIRE(static_cast<bool>(sut));
+    }
+    SECTION("Calls the function") {
+      REQUIRE(sut(21) == 42);
+    }
+  }
+}
+
+TEST_CASE("not_null<std::function<R(Args...)>>::as_nullable()", "[observers]") {
+  auto sut = check_not_null(std::function<int(int)>{twice});
+
+  SECTION("Value is lvalue") {
+    const auto& f = sut.as_nullable();
+
+    REQUIRE(f(21) == 42);
+  }
+  SECTION("Value is rvalue") {
+    const auto f = std::move(sut).as_nullable();
+
+    REQUIRE(f(21) == 42);
+  }
+}
+
+TEST_CASE("not_null_function_ref<R(Args...)>::not_null_function_ref(not_null<std::function<R(Args...)>>&)", "[ctor]") {
+  const auto f = check_not_null(std::function<int(int)>{twice});
+  const not_null_function_ref<int(int)> sut = f;
+
+  REQUIRE(sut(21) == 42);
+}
+
+} // inline namespace bitwizeshift
+} // namespace NOT_NULL_NAMESPACE_INTERNAL
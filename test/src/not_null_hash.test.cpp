@@ -0,0 +1,158 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "not_null_hash.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <memory>        // std::unique_ptr, std::shared_ptr
+#include <set>           // std::set
+#include <type_traits>   // std::is_same
+#include <unordered_set> // std::unordered_set
+#include <utility>       // std::move
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+//=============================================================================
+// functors : not_null keys
+//=============================================================================
+
+TEST_CASE("std::hash<not_null<T>>::operator()(const not_null<T>&)", "[hash]") {
+  auto input = std::unique_ptr<int>{new int{42}};
+  const auto expected = std::hash<std::unique_ptr<int>>{}(input);
+  const auto sut = assume_not_null(std::move(input));
+
+  SECTION("Hashes the same as the underlying pointer") {
+    REQUIRE(std::hash<not_null<std::unique_ptr<int>>>{}(sut) == expected);
+  }
+  SECTION("Can be used as an unordered key") {
+    auto set = std::unordered_set<not_null<std::shared_ptr<int>>>{};
+    const auto key = assume_not_null(std::make_shared<int>(42));
+    set.insert(key);
+
+    REQUIRE(set.count(key) == 1u);
+  }
+  SECTION("Hashes a moved-from not_null the same as null") {
+    auto moved = assume_not_null(std::unique_ptr<int>{new int{42}});
+    const auto owner = std::move(moved).as_nullable();
+    const auto null_hash = std::hash<std::unique_ptr<int>>{}(std::unique_ptr<int>{});
+
+    REQUIRE(std::hash<not_null<std::unique_ptr<int>>>{}(moved) == null_hash);
+  }
+}
+
+TEST_CASE("not_null_hash<T>::operator()(const U&)", "[hash]") {
+  using key_type = not_null<std::unique_ptr<int>>;
+
+  const auto sut = not_null_hash<key_type>{};
+  const auto key = assume_not_null(std::unique_ptr<int>{new int{42}});
+  auto* const pointer = key.get();
+
+  SECTION("Is transparent") {
+    STATIC_REQUIRE(std::is_same<not_null_hash<key_type>::is_transparent,void>::value);
+  }
+  SECTION("Hashes not_null the same as std::hash") {
+    REQUIRE(sut(key) == std::hash<key_type>{}(key));
+  }
+  SECTION("Hashes raw pointer the same as not_null") {
+    REQUIRE(sut(pointer) == sut(key));
+  }
+  SECTION("Hashes underlying pointer the same as not_null") {
+    REQUIRE(sut(key.as_nullable()) == sut(key));
+  }
+#if __cplusplus >= 202002L
+  SECTION("Allows heterogeneous lookup in unordered containers") {
+    auto set = std::unordered_set<
+      key_type, not_null_hash<key_type>, not_null_equal_to<key_type>
+    >{};
+    set.insert(assume_not_null(std::unique_ptr<int>{new int{42}}));
+    auto* const p = set.begin()->get();
+
+    REQUIRE(set.find(p) != set.end());
+  }
+#endif
+}
+
+TEST_CASE("not_null_equal_to<T>::operator()(const U&, const V&)", "[hash]") {
+  using key_type = not_null<std::shared_ptr<int>>;
+
+  const auto sut = not_null_equal_to<key_type>{};
+  const auto key = assume_not_null(std::make_shared<int>(42));
+  const auto other = assume_not_null(std::make_shared<int>(42));
+  auto* const pointer = key.get();
+
+  SECTION("Is transparent") {
+    STATIC_REQUIRE(std::is_same<not_null_equal_to<key_type>::is_transparent,void>::value);
+  }
+  SECTION("lhs and rhs point to the same object") {
+    SECTION("Returns true") {
+      REQUIRE(sut(key, key));
+      REQUIRE(sut(key, pointer));
+      REQUIRE(sut(pointer, key));
+      REQUIRE(sut(key.as_nullable(), pointer));
+    }
+  }
+  SECTION("lhs and rhs point to different objects") {
+    SECTION("Returns false") {
+      REQUIRE_FALSE(sut(key, other));
+      REQUIRE_FALSE(sut(other, pointer));
+      REQUIRE_FALSE(sut(other.as_nullable(), key));
+    }
+  }
+}
+
+TEST_CASE("not_null_less<T>::operator()(const U&, const V&)", "[hash]") {
+  int a[2] {};
+
+  const auto sut = not_null_less<int*>{};
+  const auto lhs = assume_not_null(&a[0]);
+  const auto rhs = assume_not_null(&a[1]);
+
+  SECTION("Is transparent") {
+    STATIC_REQUIRE(std::is_same<not_null_less<int*>::is_transparent,void>::value);
+  }
+  SECTION("lhs is less than rhs") {
+    SECTION("Returns true") {
+      REQUIRE(sut(lhs, rhs));
+      REQUIRE(sut(lhs, &a[1]));
+      REQUIRE(sut(&a[0], rhs));
+    }
+  }
+  SECTION("lhs is not less than rhs") {
+    SECTION("Returns false") {
+      REQUIRE_FALSE(sut(rhs, lhs));
+      REQUIRE_FALSE(sut(lhs, &a[0]));
+    }
+  }
+#if __cplusplus >= 201402L
+  SECTION("Allows heterogeneous lookup in ordered containers") {
+    auto set = std::set<not_null<int*>, not_null_less<int*>>{lhs, rhs};
+
+    REQUIRE(set.find(&a[1]) != set.end());
+  }
+#endif
+}
+
+} // inline namespace bitwizeshift
+} // namespace NOT_NULL_NAMESPACE_INTERNAL
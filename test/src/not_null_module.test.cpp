@@ -0,0 +1,100 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+// Headers are included before the module is imported, since not every
+// implementation merges declarations from a module's global module fragment
+// with later textual inclusions
+#include <catch2/catch.hpp>
+
+#include <functional>    // std::less
+#include <memory>        // std::unique_ptr
+#include <unordered_set> // std::unordered_set
+#include <utility>       // std::move
+
+import cpp.not_null;
+
+// Comparisons between 'not_null' objects are parenthesized so that Catch does
+// not attempt to stringify the operands
+
+namespace {
+
+struct base { int value; };
+struct derived : base {};
+
+} // namespace
+
+//=============================================================================
+// module : cpp.not_null
+//=============================================================================
+
+TEST_CASE("import cpp.not_null", "[module]") {
+  auto value = derived{};
+
+  SECTION("Exports the factory functions") {
+    const auto checked = cpp::check_not_null(&value);
+    const auto assumed = cpp::assume_not_null(&value);
+
+    REQUIRE(checked.get() == &value);
+    REQUIRE(assumed.get() == &value);
+  }
+
+  SECTION("Exports converting constructors") {
+    const cpp::not_null<base*> sut = cpp::assume_not_null(&value);
+
+    REQUIRE(sut.get() == &value);
+  }
+
+  SECTION("Exports the comparison operators") {
+    const auto sut = cpp::assume_not_null(&value);
+    const auto other = cpp::assume_not_null(&value + 1);
+
+    REQUIRE((sut == sut));
+    REQUIRE((sut != other));
+    REQUIRE((sut < other));
+    REQUIRE((sut != nullptr));
+    REQUIRE((sut == &value));
+  }
+
+  SECTION("Exports the std::hash specialization") {
+    auto set = std::unordered_set<cpp::not_null<derived*>>{};
+    set.insert(cpp::assume_not_null(&value));
+
+    REQUIRE(set.count(cpp::assume_not_null(&value)) == 1u);
+  }
+
+  SECTION("Works with move-only pointers") {
+    auto sut = cpp::check_not_null(std::make_unique<int>(42));
+    const auto p = std::move(sut).as_nullable();
+
+    REQUIRE(*p == 42);
+  }
+
+#if !defined(NOT_NULL_DISABLE_EXCEPTIONS)
+  SECTION("Exports not_null_contract_violation") {
+    derived* p = nullptr;
+
+    REQUIRE_THROWS_AS(cpp::check_not_null(p), cpp::not_null_contract_violation);
+  }
+#endif
+}
@@ -0,0 +1,343 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "not_null_pool.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>      // std::atomic
+#include <cstdint>     // std::uintptr_t
+#include <memory>      // std::unique_ptr
+#include <set>         // std::set
+#include <stdexcept>   // std::runtime_error
+#include <string>      // std::string
+#include <thread>      // std::thread
+#include <type_traits> // std::is_empty
+#include <utility>     // std::move
+#include <vector>      // std::vector
+#if defined(NOT_NULL_HAS_MEMORY_RESOURCE)
+# include <list>       // std::pmr::list
+#endif
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+namespace {
+
+  // Counts the live objects, so that tests can observe destruction
+  struct counted
+  {
+    explicit counted(int value, std::atomic<int>& live)
+      : value{value},
+        live{&live}
+    {
+      ++live;
+    }
+
+    counted(const counted&) = delete;
+
+    ~counted()
+    {
+      --(*live);
+    }
+
+    auto operator=(const counted&) -> counted& = delete;
+
+    int value;
+    std::atomic<int>* live;
+  };
+
+  struct throwing
+  {
+    explicit throwing(bool should_throw)
+    {
+      if (should_throw) {
+        throw std::runtime_error{"throwing"};
+      }
+    }
+  };
+
+  struct alignas(64) overaligned
+  {
+    int value;
+  };
+
+  // Large enough to hold the node of a 'std::pmr::list<int>'
+  struct node_storage
+  {
+    void* words[4];
+  };
+
+} // namespace
+
+//=============================================================================
+// class : not_null_pool
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Layout
+//-----------------------------------------------------------------------------
+
+TEST_CASE("not_null_pool<T>::pointer", "[layout]") {
+  using sut_type = not_null_pool<std::string>::pointer;
+
+  SECTION("Deleter is stateless") {
+    STATIC_REQUIRE(std::is_empty<pool_deleter<std::string>>::value);
+  }
+  SECTION("Is the size of a pointer") {
+    STATIC_REQUIRE(sizeof(sut_type) == sizeof(std::string*));
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+TEST_CASE("not_null_pool<T>::not_null_pool()", "[ctor]") {
+  const not_null_pool<std::string> sut{};
+
+  REQUIRE(sut.objects_per_slab() >= 1u);
+}
+
+TEST_CASE("not_null_pool<T>::not_null_pool(std::size_t)", "[ctor]") {
+  const not_null_pool<std::string> sut{4u};
+
+  REQUIRE(sut.objects_per_slab() == 4u);
+}
+
+//-----------------------------------------------------------------------------
+// Modifiers
+//-----------------------------------------------------------------------------
+
+TEST_CASE("not_null_pool<T>::acquire(Args&&...)", "[modifiers]") {
+  SECTION("Constructs the object from the arguments") {
+    not_null_pool<std::string> sut{};
+
+    const auto p = sut.acquire(3u, 'x');
+
+    REQUIRE(*p == "xxx");
+  }
+  SECTION("Releasing the object destroys it") {
+    std::atomic<int> live{0};
+    not_null_pool<counted> sut{};
+
+    auto p = sut.acquire(1, live);
+    std::move(p).as_nullable().reset();
+
+    REQUIRE(live == 0);
+  }
+  SECTION("Released storage is reused") {
+    not_null_pool<std::string> sut{};
+
+    auto p = sut.acquire();
+    const auto* const address = p.get();
+    std::move(p).as_nullable().reset();
+
+    const auto q = sut.acquire();
+
+    REQUIRE(q.get() == address);
+  }
+  SECTION("Objects are distinct across multiple slabs") {
+    not_null_pool<std::string> sut{4u};
+    auto objects = std::vector<not_null_pool<std::string>::pointer>{};
+    auto addresses = std::set<const std::string*>{};
+
+    for (auto i = 0; i < 100; ++i) {
+      objects.push_back(sut.acquire(std::to_string(i)));
+      addresses.insert(objects.back().get());
+    }
+
+    REQUIRE(addresses.size() == 100u);
+    for (auto i = 0; i < 100; ++i) {
+      REQUIRE(*objects[i] == std::to_string(i));
+    }
+  }
+  SECTION("Objects are aligned") {
+    not_null_pool<overaligned> sut{};
+
+    for (auto i = 0; i < 10; ++i) {
+      const auto p = sut.acquire();
+      const auto address = reinterpret_cast<std::uintptr_t>(p.get());
+
+      REQUIRE(address % alignof(overaligned) == 0u);
+    }
+  }
+#if !defined(NOT_NULL_DISABLE_EXCEPTIONS)
+  SECTION("Constructor throws") {
+    not_null_pool<throwing> sut{};
+
+    const auto* const address = sut.acquire(false).get();
+
+    REQUIRE_THROWS_AS(sut.acquire(true), std::runtime_error);
+
+    SECTION("Storage is returned to the pool") {
+      const auto p = sut.acquire(false);
+
+      REQUIRE(p.get() == address);
+    }
+  }
+#endif
+  SECTION("More pools are used than a thread can cache") {
+    std::atomic<int> live{0};
+    auto pools = std::vector<std::unique_ptr<not_null_pool<counted>>>{};
+    auto objects = std::vector<not_null_pool<counted>::pointer>{};
+
+    for (auto i = 0; i < 20; ++i) {
+      pools.emplace_back(new not_null_pool<counted>{});
+      objects.push_back(pools.back()->acquire(i, live));
+    }
+    for (auto i = 0; i < 20; ++i) {
+      REQUIRE(objects[i]->value == i);
+    }
+    objects.clear();
+
+    REQUIRE(live == 0);
+  }
+  SECTION("Pools are evicted from the thread cache") {
+    auto pools = std::vector<std::unique_ptr<not_null_pool<int>>>{};
+    for (auto i = 0; i < 20; ++i) {
+      pools.emplace_back(new not_null_pool<int>{});
+    }
+    const auto* address = static_cast<const int*>(nullptr);
+    {
+      const auto p = pools.front()->acquire(0);
+      address = p.get();
+    }
+    for (const auto& pool : pools) {
+      const auto p = pool->acquire(1);
+
+      REQUIRE(*p == 1);
+    }
+    for (auto i = pools.size(); i > 0u; --i) {
+      const auto p = pools[i - 1u]->acquire(2);
+
+      REQUIRE(*p == 2);
+    }
+
+    SECTION("Released storage is reused") {
+      const auto p = pools.front()->acquire(3);
+
+      REQUIRE(p.get() == address);
+    }
+  }
+  SECTION("Pools are destroyed and recreated") {
+    for (auto i = 0; i < 20; ++i) {
+      not_null_pool<std::string> pool{};
+      const auto p = pool.acquire(std::to_string(i));
+
+      REQUIRE(*p == std::to_string(i));
+    }
+  }
+}
+
+TEST_CASE("not_null_pool<T>::acquire(Args&&...) (concurrent)", "[modifiers]") {
+  static constexpr auto threads = 4;
+  static constexpr auto iterations = 10000;
+
+  std::atomic<int> live{0};
+  not_null_pool<counted> sut{16u};
+
+  SECTION("Objects are released on the thread that acquired them") {
+    auto workers = std::vector<std::thread>{};
+    for (auto t = 0; t < threads; ++t) {
+      workers.emplace_back([&sut, &live, t]{
+        auto objects = std::vector<not_null_pool<counted>::pointer>{};
+        for (auto i = 0; i < iterations; ++i) {
+          objects.push_back(sut.acquire(t, live));
+          if (objects.size() > 100u) {
+            objects.clear();
+          }
+        }
+      });
+    }
+    for (auto& w : workers) {
+      w.join();
+    }
+
+    REQUIRE(live == 0);
+  }
+  SECTION("Objects are released on a different thread") {
+    auto objects = std::vector<not_null_pool<counted>::pointer>{};
+    for (auto i = 0; i < iterations; ++i) {
+      objects.push_back(sut.acquire(i, live));
+    }
+
+    std::thread consumer{[&objects]{
+      objects.clear();
+    }};
+    consumer.join();
+
+    // Storage released by the consumer is reused here
+    for (auto i = 0; i < iterations; ++i) {
+      objects.push_back(sut.acquire(i, live));
+    }
+    objects.clear();
+
+    REQUIRE(live == 0);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+#if defined(NOT_NULL_HAS_MEMORY_RESOURCE)
+
+TEST_CASE("not_null_pool<T>::resource()", "[observers]") {
+  not_null_pool<node_storage> sut{};
+  const auto resource = sut.resource();
+
+  SECTION("Small allocations are taken from the pool") {
+    auto* const p = resource->allocate(sizeof(int), alignof(int));
+    resource->deallocate(p, sizeof(int), alignof(int));
+
+    const auto q = sut.acquire();
+
+    REQUIRE(static_cast<const void*>(q.get()) == p);
+  }
+  SECTION("Large allocations are forwarded upstream") {
+    auto* const p = resource->allocate(1024u, alignof(int));
+    *static_cast<unsigned char*>(p) = 42u;
+    resource->deallocate(p, 1024u, alignof(int));
+  }
+  SECTION("Is only equal to itself") {
+    not_null_pool<int> other{};
+
+    REQUIRE(resource->is_equal(*resource));
+    REQUIRE_FALSE(resource->is_equal(*other.resource()));
+  }
+  SECTION("Allocates the nodes of a pmr container") {
+    auto list = std::pmr::list<int>{resource.get()};
+    for (auto i = 0; i < 100; ++i) {
+      list.push_back(i);
+    }
+
+    REQUIRE(list.size() == 100u);
+    REQUIRE(list.back() == 99);
+  }
+}
+
+#endif // defined(NOT_NULL_HAS_MEMORY_RESOURCE)
+
+} // inline namespace bitwizeshift
+} // namespace NOT_NULL_NAMESPACE_INTERNAL
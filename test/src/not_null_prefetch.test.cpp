@@ -0,0 +1,196 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "not_null_prefetch.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <forward_list> // std::forward_list
+#include <memory>       // std::unique_ptr, std::shared_ptr
+#include <vector>       // std::vector
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+namespace {
+
+  int s_values[5] = {1, 2, 3, 4, 5};
+
+  auto make_range() -> std::vector<not_null<int*>>
+  {
+    auto result = std::vector<not_null<int*>>{};
+    for (auto& v : s_values) {
+      result.push_back(assume_not_null(&v));
+    }
+    return result;
+  }
+
+  // Records every element that is visited, in order
+  struct recorder
+  {
+    std::vector<int*> visited;
+
+    auto operator()(const not_null<int*>& p) -> void
+    {
+      visited.push_back(p.get());
+    }
+  };
+
+} // namespace
+
+//=============================================================================
+// non-member functions : class : not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Prefetching
+//-----------------------------------------------------------------------------
+
+TEST_CASE("prefetch(const not_null<T>&, prefetch_locality)", "[prefetching]") {
+  SECTION("Is noexcept") {
+    const auto p = assume_not_null(&s_values[0]);
+
+    STATIC_REQUIRE(noexcept(prefetch(p)));
+    STATIC_REQUIRE(noexcept(prefetch(p, prefetch_locality::none)));
+  }
+  SECTION("Does not modify the pointed-to object") {
+    const auto p = assume_not_null(&s_values[0]);
+
+    prefetch(p, prefetch_locality::none);
+    prefetch(p, prefetch_locality::low);
+    prefetch(p, prefetch_locality::moderate);
+    prefetch(p, prefetch_locality::high);
+
+    REQUIRE(*p == 1);
+  }
+  SECTION("Accepts smart pointers") {
+    const auto unique = make_not_null_unique<int>(42);
+    const auto shared = make_not_null_shared<int>(42);
+
+    prefetch(unique);
+    prefetch(shared);
+
+    REQUIRE(*unique == 42);
+    REQUIRE(*shared == 42);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Algorithms
+//-----------------------------------------------------------------------------
+
+TEST_CASE("prefetching_for_each(ForwardIt, ForwardIt, std::size_t, UnaryFunction, prefetch_locality)", "[algorithms]") {
+  const auto range = make_range();
+
+  SECTION("Distance is 0") {
+    const auto sut = prefetching_for_each(range.begin(), range.end(), 0u, recorder{});
+
+    SECTION("Visits every element in order") {
+      REQUIRE(sut.visited.size() == 5u);
+      for (auto i = 0u; i < 5u; ++i) {
+        REQUIRE(sut.visited[i] == &s_values[i]);
+      }
+    }
+  }
+  SECTION("Distance is less than the size of the range") {
+    const auto sut = prefetching_for_each(range.begin(), range.end(), 2u, recorder{});
+
+    SECTION("Visits every element in order") {
+      REQUIRE(sut.visited.size() == 5u);
+      for (auto i = 0u; i < 5u; ++i) {
+        REQUIRE(sut.visited[i] == &s_values[i]);
+      }
+    }
+  }
+  SECTION("Distance is greater than the size of the range") {
+    const auto sut = prefetching_for_each(range.begin(), range.end(), 16u, recorder{});
+
+    SECTION("Visits every element in order") {
+      REQUIRE(sut.visited.size() == 5u);
+      for (auto i = 0u; i < 5u; ++i) {
+        REQUIRE(sut.visited[i] == &s_values[i]);
+      }
+    }
+  }
+  SECTION("Range is empty") {
+    const auto sut = prefetching_for_each(range.end(), range.end(), 2u, recorder{});
+
+    SECTION("Visits nothing") {
+      REQUIRE(sut.visited.empty());
+    }
+  }
+  SECTION("Iterators are forward iterators") {
+    const auto list = std::forward_list<not_null<int*>>(range.begin(), range.end());
+    const auto sut = prefetching_for_each(list.begin(), list.end(), 2u, recorder{});
+
+    SECTION("Visits every element in order") {
+      REQUIRE(sut.visited.size() == 5u);
+      for (auto i = 0u; i < 5u; ++i) {
+        REQUIRE(sut.visited[i] == &s_values[i]);
+      }
+    }
+  }
+}
+
+TEST_CASE("prefetching_for_each(ForwardRange&&, std::size_t, UnaryFunction, prefetch_locality)", "[algorithms]") {
+  SECTION("Range is a container") {
+    const auto range = make_range();
+    const auto sut = prefetching_for_each(range, 2u, recorder{}, prefetch_locality::low);
+
+    SECTION("Visits every element in order") {
+      REQUIRE(sut.visited.size() == 5u);
+      for (auto i = 0u; i < 5u; ++i) {
+        REQUIRE(sut.visited[i] == &s_values[i]);
+      }
+    }
+  }
+  SECTION("Range is an array") {
+    not_null<int*> range[] = {
+      assume_not_null(&s_values[0]),
+      assume_not_null(&s_values[1]),
+    };
+    const auto sut = prefetching_for_each(range, 1u, recorder{});
+
+    SECTION("Visits every element in order") {
+      REQUIRE(sut.visited.size() == 2u);
+      REQUIRE(sut.visited[0] == &s_values[0]);
+      REQUIRE(sut.visited[1] == &s_values[1]);
+    }
+  }
+  SECTION("Elements are smart pointers") {
+    auto range = std::vector<not_null<std::unique_ptr<int>>>{};
+    range.push_back(make_not_null_unique<int>(1));
+    range.push_back(make_not_null_unique<int>(2));
+    range.push_back(make_not_null_unique<int>(3));
+
+    auto total = 0;
+    prefetching_for_each(range, 1u, [&](not_null<std::unique_ptr<int>>& p){
+      total += *p;
+    });
+
+    REQUIRE(total == 6);
+  }
+}
+
+} // inline namespace bitwizeshift
+} // namespace NOT_NULL_NAMESPACE_INTERNAL
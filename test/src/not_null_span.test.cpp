@@ -0,0 +1,441 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "not_null_span.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <array>       // std::array
+#include <cstdint>     // std::uintptr_t
+#include <type_traits> // std::is_constructible, std::is_convertible
+#include <vector>      // std::vector
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+namespace {
+
+  constexpr int s_values[4] = {1, 2, 3, 4};
+
+} // namespace
+
+//=============================================================================
+// class : not_null_span
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Layout
+//-----------------------------------------------------------------------------
+
+TEST_CASE("not_null_span<T,Extent>", "[layout]") {
+  SECTION("Static extent is the size of a pointer") {
+    STATIC_REQUIRE(sizeof(not_null_span<int,4>) == sizeof(int*));
+  }
+  SECTION("Dynamic extent is the size of a pointer and a size") {
+    STATIC_REQUIRE(sizeof(not_null_span<int>) == sizeof(int*) + sizeof(std::size_t));
+  }
+  SECTION("Is not default constructible") {
+    STATIC_REQUIRE_FALSE(std::is_default_constructible<not_null_span<int>>::value);
+    STATIC_REQUIRE_FALSE(std::is_default_constructible<not_null_span<int,4>>::value);
+  }
+  SECTION("Is trivially copyable") {
+    STATIC_REQUIRE(std::is_trivially_copyable<not_null_span<int>>::value);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+TEST_CASE("not_null_span<T,Extent>::not_null_span(not_null<T*>, size_type)", "[ctor]") {
+  int values[4] = {1, 2, 3, 4};
+
+  SECTION("Extent is dynamic") {
+    const not_null_span<int> sut{assume_not_null(&values[1]), 2u};
+
+    REQUIRE(sut.data() == &values[1]);
+    REQUIRE(sut.size() == 2u);
+  }
+  SECTION("Extent is static") {
+    STATIC_REQUIRE_FALSE(std::is_convertible<not_null<int*>, not_null_span<int,4>>::value);
+
+    const not_null_span<int,2> sut{assume_not_null(&values[1]), 2u};
+
+    REQUIRE(sut.data() == &values[1]);
+    REQUIRE(sut.size() == 2u);
+  }
+}
+
+TEST_CASE("not_null_span<T,Extent>::not_null_span(U (&)[N])", "[ctor]") {
+  int values[4] = {1, 2, 3, 4};
+
+  SECTION("Extent is dynamic") {
+    const not_null_span<int> sut = values;
+
+    REQUIRE(sut.data() == &values[0]);
+    REQUIRE(sut.size() == 4u);
+  }
+  SECTION("Extent matches the array") {
+    const not_null_span<const int,4> sut = values;
+
+    REQUIRE(sut.data() == &values[0]);
+  }
+  SECTION("Extent does not match the array") {
+    STATIC_REQUIRE_FALSE(std::is_constructible<not_null_span<int,3>,int(&)[4]>::value);
+  }
+  SECTION("Elements are less qualified") {
+    STATIC_REQUIRE_FALSE(std::is_constructible<not_null_span<int>,const int(&)[4]>::value);
+  }
+  SECTION("Is usable in constant expressions") {
+    constexpr not_null_span<const int,4> sut = s_values;
+
+    STATIC_REQUIRE(sut.size() == 4u);
+    STATIC_REQUIRE(sut[2] == 3);
+  }
+}
+
+TEST_CASE("not_null_span<T,Extent>::not_null_span(std::array<U,N>&)", "[ctor]") {
+  SECTION("Array has elements") {
+    auto values = std::array<int,3>{{1, 2, 3}};
+    const not_null_span<int> sut = values;
+
+    REQUIRE(sut.data() == values.data());
+    REQUIRE(sut.size() == 3u);
+  }
+  SECTION("Array is const") {
+    const auto values = std::array<int,3>{{1, 2, 3}};
+    const not_null_span<const int,3> sut = values;
+
+    REQUIRE(sut.data() == values.data());
+  }
+  SECTION("Array has no elements") {
+    STATIC_REQUIRE_FALSE(std::is_constructible<not_null_span<int>,std::array<int,0>&>::value);
+  }
+}
+
+TEST_CASE("not_null_span<T,Extent>::not_null_span(const not_null_span<U,N>&)", "[ctor]") {
+  int values[4] = {1, 2, 3, 4};
+  const not_null_span<int,4> fixed = values;
+  const not_null_span<int> dynamic = values;
+
+  SECTION("Static extent to dynamic extent is implicit") {
+    const not_null_span<const int> sut = fixed;
+
+    REQUIRE(sut.data() == &values[0]);
+    REQUIRE(sut.size() == 4u);
+  }
+  SECTION("Dynamic extent to static extent is explicit") {
+    STATIC_REQUIRE_FALSE(std::is_convertible<not_null_span<int>,not_null_span<int,4>>::value);
+
+    const not_null_span<int,4> sut{dynamic};
+
+    REQUIRE(sut.data() == &values[0]);
+  }
+  SECTION("Elements are less qualified") {
+    STATIC_REQUIRE_FALSE(std::is_constructible<not_null_span<int>,not_null_span<const int>>::value);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Element Access
+//-----------------------------------------------------------------------------
+
+TEST_CASE("not_null_span<T,Extent>::operator[](size_type)", "[element access]") {
+  int values[4] = {1, 2, 3, 4};
+  const not_null_span<int> sut = values;
+
+  sut[1] = 42;
+
+  REQUIRE(values[1] == 42);
+}
+
+TEST_CASE("not_null_span<T,Extent>::front()", "[element access]") {
+  const not_null_span<const int> sut = s_values;
+
+  REQUIRE(sut.front() == 1);
+}
+
+TEST_CASE("not_null_span<T,Extent>::back()", "[element access]") {
+  const not_null_span<const int> sut = s_values;
+
+  REQUIRE(sut.back() == 4);
+}
+
+//-----------------------------------------------------------------------------
+// Iterators
+//-----------------------------------------------------------------------------
+
+TEST_CASE("not_null_span<T,Extent>::begin()", "[iterators]") {
+  const not_null_span<const int> sut = s_values;
+
+  const auto result = std::vector<int>(sut.begin(), sut.end());
+
+  REQUIRE(result == (std::vector<int>{1, 2, 3, 4}));
+}
+
+TEST_CASE("not_null_span<T,Extent>::rbegin()", "[iterators]") {
+  const not_null_span<const int> sut = s_values;
+
+  const auto result = std::vector<int>(sut.rbegin(), sut.rend());
+
+  REQUIRE(result == (std::vector<int>{4, 3, 2, 1}));
+}
+
+//-----------------------------------------------------------------------------
+// Subviews
+//-----------------------------------------------------------------------------
+
+TEST_CASE("not_null_span<T,Extent>::first<Count>()", "[subviews]") {
+  constexpr not_null_span<const int,4> sut = s_values;
+  constexpr auto result = sut.first<2>();
+
+  STATIC_REQUIRE(decltype(result)::extent == 2u);
+  STATIC_REQUIRE(result.back() == 2);
+  REQUIRE(result.data() == &s_values[0]);
+}
+
+TEST_CASE("not_null_span<T,Extent>::first(size_type)", "[subviews]") {
+  const not_null_span<const int> sut = s_values;
+  const auto result = sut.first(3u);
+
+  REQUIRE(result.data() == &s_values[0]);
+  REQUIRE(result.size() == 3u);
+}
+
+TEST_CASE("not_null_span<T,Extent>::last<Count>()", "[subviews]") {
+  constexpr not_null_span<const int,4> sut = s_values;
+  constexpr auto result = sut.last<2>();
+
+  STATIC_REQUIRE(decltype(result)::extent == 2u);
+  STATIC_REQUIRE(result.front() == 3);
+  REQUIRE(result.data() == &s_values[2]);
+}
+
+TEST_CASE("not_null_span<T,Extent>::last(size_type)", "[subviews]") {
+  const not_null_span<const int> sut = s_values;
+
+  SECTION("Count is less than the size") {
+    const auto result = sut.last(3u);
+
+    REQUIRE(result.data() == &s_values[1]);
+    REQUIRE(result.size() == 3u);
+  }
+  SECTION("Count is 0") {
+    const auto result = sut.last(0u);
+
+    REQUIRE(result.empty());
+    REQUIRE(result.data() == sut.end());
+  }
+}
+
+TEST_CASE("not_null_span<T,Extent>::subspan<Offset,Count>()", "[subviews]") {
+  constexpr not_null_span<const int,4> sut = s_values;
+
+  SECTION("Count is given") {
+    constexpr auto result = sut.subspan<1,2>();
+
+    STATIC_REQUIRE(decltype(result)::extent == 2u);
+    STATIC_REQUIRE(result.front() == 2);
+    STATIC_REQUIRE(result.back() == 3);
+  }
+  SECTION("Count is dynamic_extent") {
+    constexpr auto result = sut.subspan<1>();
+
+    STATIC_REQUIRE(decltype(result)::extent == 3u);
+    STATIC_REQUIRE(result.back() == 4);
+  }
+  SECTION("Span has dynamic extent") {
+    const not_null_span<const int> dynamic = sut;
+    const auto result = dynamic.subspan<1>();
+
+    STATIC_REQUIRE(decltype(result)::extent == dynamic_extent);
+    REQUIRE(result.size() == 3u);
+  }
+}
+
+TEST_CASE("not_null_span<T,Extent>::subspan(size_type, size_type)", "[subviews]") {
+  const not_null_span<const int> sut = s_values;
+
+  SECTION("Count is given") {
+    const auto result = sut.subspan(1u, 2u);
+
+    REQUIRE(result.data() == &s_values[1]);
+    REQUIRE(result.size() == 2u);
+  }
+  SECTION("Count is dynamic_extent") {
+    const auto result = sut.subspan(1u);
+
+    REQUIRE(result.data() == &s_values[1]);
+    REQUIRE(result.size() == 3u);
+  }
+  SECTION("Offset is the size") {
+    const auto result = sut.subspan(4u);
+
+    SECTION("Result is empty") {
+      REQUIRE(result.empty());
+    }
+    SECTION("Result points past the end") {
+      REQUIRE(result.data() == sut.end());
+    }
+  }
+}
+
+//=============================================================================
+// non-member functions : class : not_null_span
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Utilities
+//-----------------------------------------------------------------------------
+
+TEST_CASE("check_not_null_span(T*, std::size_t)", "[utilities]") {
+  SECTION("Data is null") {
+    int* data = nullptr;
+
+#if !defined(NOT_NULL_DISABLE_EXCEPTIONS)
+    REQUIRE_THROWS_AS(check_not_null_span(data, 1u), not_null_contract_violation);
+#endif
+  }
+  SECTION("Data is null and size is 0") {
+    auto values = std::vector<double>{};
+    const auto sut = check_not_null_span(values.data(), values.size());
+
+    SECTION("Result is empty") {
+      REQUIRE(sut.empty());
+    }
+    SECTION("Data is suitably aligned") {
+      const auto address = reinterpret_cast<std::uintptr_t>(sut.data().get());
+
+      REQUIRE(address % alignof(double) == 0u);
+    }
+  }
+  SECTION("Data is not null and size is 0") {
+    int values[1] = {1};
+    const auto sut = check_not_null_span(&values[0] + 1, 0u);
+
+    SECTION("Keeps the data") {
+      REQUIRE(sut.data() == &values[0] + 1);
+    }
+  }
+  SECTION("Data is not null") {
+    auto values = std::vector<int>{1, 2, 3};
+    const auto sut = check_not_null_span(values.data(), values.size());
+
+    REQUIRE(sut.data() == values.data());
+    REQUIRE(sut.size() == values.size());
+  }
+}
+
+TEST_CASE("assume_not_null_span(T*, std::size_t)", "[utilities]") {
+  SECTION("Data is null and size is 0") {
+    auto values = std::vector<double>{};
+    const auto sut = assume_not_null_span(values.data(), values.size());
+
+    SECTION("Result is empty") {
+      REQUIRE(sut.empty());
+    }
+    SECTION("Data is suitably aligned") {
+      const auto address = reinterpret_cast<std::uintptr_t>(sut.data().get());
+
+      REQUIRE(address % alignof(double) == 0u);
+    }
+  }
+  SECTION("Data is not null") {
+    auto values = std::vector<int>{1, 2, 3};
+    const auto sut = assume_not_null_span(values.data(), values.size());
+
+    REQUIRE(sut.data() == values.data());
+    REQUIRE(sut.size() == values.size());
+  }
+}
+
+#if defined(NOT_NULL_HAS_SPAN)
+
+TEST_CASE("not_null_span<T,Extent>::operator std::span<T,Extent>()", "[conversions]") {
+  int values[4] = {1, 2, 3, 4};
+  const not_null_span<int> sut = values;
+
+  SECTION("Extent is dynamic") {
+    const std::span<int> result = sut;
+
+    REQUIRE(result.data() == &values[0]);
+    REQUIRE(result.size() == 4u);
+  }
+  SECTION("Extent is static") {
+    constexpr std::span<const int,4> result = not_null_span<const int,4>{s_values};
+
+    STATIC_REQUIRE(result.size() == 4u);
+    REQUIRE(result.data() == &s_values[0]);
+  }
+}
+
+TEST_CASE("check_not_null_span(std::span<T,Extent>)", "[utilities]") {
+  SECTION("Span is default-constructed") {
+    const auto sut = check_not_null_span(std::span<int>{});
+
+    SECTION("Result is empty") {
+      REQUIRE(sut.empty());
+    }
+  }
+  SECTION("Span is default-constructed with a static extent") {
+    const auto sut = check_not_null_span(std::span<int,0>{});
+
+    STATIC_REQUIRE(decltype(sut)::extent == 0u);
+    REQUIRE(sut.empty());
+  }
+  SECTION("Data is not null") {
+    int values[4] = {1, 2, 3, 4};
+    const auto sut = check_not_null_span(std::span<int,4>{values});
+
+    STATIC_REQUIRE(decltype(sut)::extent == 4u);
+    REQUIRE(sut.data() == &values[0]);
+  }
+}
+
+TEST_CASE("assume_not_null_span(std::span<T,Extent>)", "[utilities]") {
+  SECTION("Span is default-constructed") {
+    const auto sut = assume_not_null_span(std::span<int>{});
+
+    SECTION("Result is empty") {
+      REQUIRE(sut.empty());
+    }
+  }
+  SECTION("Span is default-constructed with a static extent") {
+    const auto sut = assume_not_null_span(std::span<int,0>{});
+
+    STATIC_REQUIRE(decltype(sut)::extent == 0u);
+    REQUIRE(sut.empty());
+  }
+  SECTION("Data is not null") {
+    int values[4] = {1, 2, 3, 4};
+    const auto sut = assume_not_null_span(std::span<int>{values});
+
+    REQUIRE(sut.data() == &values[0]);
+    REQUIRE(sut.size() == 4u);
+  }
+}
+
+#endif // defined(NOT_NULL_HAS_SPAN)
+
+} // inline namespace bitwizeshift
+} // namespace NOT_NULL_NAMESPACE_INTERNAL
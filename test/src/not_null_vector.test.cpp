@@ -0,0 +1,414 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "not_null_vector.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <iterator> // std::make_move_iterator, std::input_iterator_tag
+#include <memory>   // std::unique_ptr
+#include <vector>   // std::vector
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+namespace {
+
+  auto make_unique_ptrs(std::size_t n) -> std::vector<std::unique_ptr<int>>
+  {
+    auto result = std::vector<std::unique_ptr<int>>{};
+    for (auto i = std::size_t{0u}; i < n; ++i) {
+      result.emplace_back(new int{static_cast<int>(i)});
+    }
+    return result;
+  }
+
+  // An adapter that restricts an iterator to a single-pass input iterator
+  template <typename It>
+  class input_iterator
+  {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = typename std::iterator_traits<It>::value_type;
+    using difference_type   = typename std::iterator_traits<It>::difference_type;
+    using pointer           = typename std::iterator_traits<It>::pointer;
+    using reference         = typename std::iterator_traits<It>::reference;
+
+    explicit input_iterator(It it) : m_it{it}{}
+
+    auto operator*() const -> reference { return *m_it; }
+    auto operator++() -> input_iterator& { ++m_it; return *this; }
+    auto operator++(int) -> input_iterator { auto copy = *this; ++m_it; return copy; }
+
+    auto operator==(const input_iterator& other) const -> bool { return m_it == other.m_it; }
+    auto operator!=(const input_iterator& other) const -> bool { return m_it != other.m_it; }
+
+  private:
+    It m_it;
+  };
+
+  template <typename It>
+  auto make_input_iterator(It it) -> input_iterator<It>
+  {
+    return input_iterator<It>{it};
+  }
+
+} // namespace
+
+//=============================================================================
+// class : not_null_vector
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Element Access
+//-----------------------------------------------------------------------------
+
+TEST_CASE("not_null_vector<T>::operator[](size_type)", "[element access]") {
+  auto input = make_unique_ptrs(3u);
+  auto* const expected = input[1].get();
+  auto sut = assume_not_null_vector(std::move(input));
+
+  SECTION("Refers to the element at the index") {
+    REQUIRE(sut[1].get() == expected);
+  }
+  SECTION("Returns a reference to not_null") {
+    STATIC_REQUIRE(std::is_same<decltype(sut[1]),not_null<std::unique_ptr<int>>&>::value);
+  }
+}
+
+TEST_CASE("not_null_vector<T>::get(size_type)", "[element access]") {
+  int a = 0;
+  int b = 1;
+  auto sut = not_null_vector<int*>{};
+  sut.push_back(assume_not_null(&a));
+  sut.push_back(assume_not_null(&b));
+
+  SECTION("Returns the raw pointer of the element") {
+    REQUIRE(sut.get(1) == &b);
+  }
+  SECTION("Returns a not_null raw pointer") {
+    STATIC_REQUIRE(std::is_same<decltype(sut.get(1)),not_null<int*>>::value);
+  }
+}
+
+TEST_CASE("not_null_vector<T>::front() / back()", "[element access]") {
+  auto input = make_unique_ptrs(3u);
+  auto* const first = input.front().get();
+  auto* const last = input.back().get();
+  const auto sut = assume_not_null_vector(std::move(input));
+
+  SECTION("front refers to the first element") {
+    REQUIRE(sut.front().get() == first);
+  }
+  SECTION("back refers to the last element") {
+    REQUIRE(sut.back().get() == last);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Iterators
+//-----------------------------------------------------------------------------
+
+TEST_CASE("not_null_vector<T>::begin() / end()", "[iterators]") {
+  const auto sut = assume_not_null_vector(make_unique_ptrs(5u));
+
+  SECTION("Iterates over each element in order") {
+    auto expected = 0;
+    for (const auto& p : sut) {
+      REQUIRE(*p == expected++);
+    }
+    REQUIRE(expected == 5);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Modifiers
+//-----------------------------------------------------------------------------
+
+TEST_CASE("not_null_vector<T>::push_back(value_type&&)", "[modifiers]") {
+  auto sut = not_null_vector<std::unique_ptr<int>>{};
+  auto p = assume_not_null(std::unique_ptr<int>{new int{42}});
+  auto* const expected = p.get();
+
+  sut.push_back(std::move(p));
+
+  SECTION("Appends the element") {
+    REQUIRE(sut.size() == 1u);
+    REQUIRE(sut.back().get() == expected);
+  }
+}
+
+TEST_CASE("not_null_vector<T>::append_checked(InputIt, InputIt)", "[modifiers]") {
+  auto sut = assume_not_null_vector(make_unique_ptrs(2u));
+
+  SECTION("Range contains null pointers") {
+    auto input = make_unique_ptrs(40u);
+    input[33].reset();
+
+    SECTION("Throws null contract violation") {
+      REQUIRE_THROWS_AS(
+        sut.append_checked(
+          std::make_move_iterator(input.begin()),
+          std::make_move_iterator(input.end())
+        ),
+        not_null_contract_violation
+      );
+    }
+    SECTION("Leaves the container unmodified") {
+      try {
+        sut.append_checked(
+          std::make_move_iterator(input.begin()),
+          std::make_move_iterator(input.end())
+        );
+      } catch (const not_null_contract_violation&) {}
+
+      REQUIRE(sut.size() == 2u);
+    }
+    SECTION("Does not move from the range") {
+      try {
+        sut.append_checked(
+          std::make_move_iterator(input.begin()),
+          std::make_move_iterator(input.end())
+        );
+      } catch (const not_null_contract_violation&) {}
+
+      REQUIRE(input[0] != nullptr);
+      REQUIRE(input[39] != nullptr);
+    }
+  }
+  SECTION("Range is single-pass and contains null pointers") {
+    auto input = make_unique_ptrs(40u);
+    input[33].reset();
+
+    SECTION("Leaves the container unmodified") {
+      REQUIRE_THROWS_AS(
+        sut.append_checked(
+          make_input_iterator(std::make_move_iterator(input.begin())),
+          make_input_iterator(std::make_move_iterator(input.end()))
+        ),
+        not_null_contract_violation
+      );
+
+      REQUIRE(sut.size() == 2u);
+      REQUIRE(sut[0].get() != nullptr);
+    }
+  }
+  SECTION("Range is single-pass and contains no null pointers") {
+    auto input = make_unique_ptrs(40u);
+    auto* const expected = input.back().get();
+
+    sut.append_checked(
+      make_input_iterator(std::make_move_iterator(input.begin())),
+      make_input_iterator(std::make_move_iterator(input.end()))
+    );
+
+    SECTION("Appends all elements") {
+      REQUIRE(sut.size() == 42u);
+      REQUIRE(sut.back().get() == expected);
+    }
+  }
+  SECTION("Range contains no null pointers") {
+    auto input = make_unique_ptrs(40u);
+    auto* const expected = input.back().get();
+
+    sut.append_checked(
+      std::make_move_iterator(input.begin()),
+      std::make_move_iterator(input.end())
+    );
+
+    SECTION("Appends all elements") {
+      REQUIRE(sut.size() == 42u);
+      REQUIRE(sut.back().get() == expected);
+    }
+  }
+  SECTION("Range contains raw pointers") {
+    int value = 42;
+    auto input = std::vector<int*>(100u, &value);
+    auto raw = not_null_vector<int*>{};
+
+    SECTION("Range contains null pointers") {
+      input[50] = nullptr;
+
+      SECTION("Throws null contract violation") {
+        REQUIRE_THROWS_AS(
+          raw.append_checked(input.begin(), input.end()),
+          not_null_contract_violation
+        );
+      }
+    }
+    SECTION("Range contains no null pointers") {
+      raw.append_checked(input.begin(), input.end());
+
+      SECTION("Appends all elements") {
+        REQUIRE(raw.size() == 100u);
+      }
+    }
+  }
+}
+
+TEST_CASE("not_null_vector<T>::append_assumed(InputIt, InputIt)", "[modifiers]") {
+  int value = 42;
+  const auto input = std::vector<int*>(10u, &value);
+  auto sut = not_null_vector<int*>{};
+  sut.push_back(assume_not_null(&value));
+
+  sut.append_assumed(input.begin(), input.end());
+
+  SECTION("Appends all elements") {
+    REQUIRE(sut.size() == 11u);
+    REQUIRE(sut.back() == &value);
+  }
+}
+
+TEST_CASE("not_null_vector<T>::assign_checked(InputIt, InputIt)", "[modifiers]") {
+  int value = 42;
+  auto sut = not_null_vector<int*>{};
+  sut.push_back(assume_not_null(&value));
+
+  SECTION("Range contains null pointers") {
+    const auto input = std::vector<int*>{&value, nullptr};
+
+    SECTION("Throws null contract violation") {
+      REQUIRE_THROWS_AS(
+        sut.assign_checked(input.begin(), input.end()),
+        not_null_contract_violation
+      );
+    }
+    SECTION("Leaves the container unmodified") {
+      try {
+        sut.assign_checked(input.begin(), input.end());
+      } catch (const not_null_contract_violation&) {}
+
+      REQUIRE(sut.size() == 1u);
+      REQUIRE(sut.front() == &value);
+    }
+  }
+  SECTION("Range is single-pass and contains null pointers") {
+    const auto input = std::vector<int*>{&value, nullptr};
+
+    SECTION("Leaves the container unmodified") {
+      REQUIRE_THROWS_AS(
+        sut.assign_checked(
+          make_input_iterator(input.begin()),
+          make_input_iterator(input.end())
+        ),
+        not_null_contract_violation
+      );
+
+      REQUIRE(sut.size() == 1u);
+      REQUIRE(sut.front() == &value);
+    }
+  }
+  SECTION("Range is single-pass and contains no null pointers") {
+    const auto input = std::vector<int*>(3u, &value);
+
+    sut.assign_checked(make_input_iterator(input.begin()), make_input_iterator(input.end()));
+
+    SECTION("Replaces the contents") {
+      REQUIRE(sut.as_nullable() == input);
+    }
+  }
+  SECTION("Range contains no null pointers") {
+    const auto input = std::vector<int*>(3u, &value);
+
+    sut.assign_checked(input.begin(), input.end());
+
+    SECTION("Replaces the contents") {
+      REQUIRE(sut.as_nullable() == input);
+    }
+  }
+}
+
+TEST_CASE("not_null_vector<T>::resize(size_type, const value_type&)", "[modifiers]") {
+  int value = 42;
+  auto sut = not_null_vector<int*>{};
+
+  sut.resize(4u, assume_not_null(&value));
+
+  SECTION("Appends copies of the value") {
+    REQUIRE(sut.size() == 4u);
+    REQUIRE(sut[3] == &value);
+  }
+}
+
+TEST_CASE("not_null_vector<T>::erase(const_iterator)", "[modifiers]") {
+  auto sut = assume_not_null_vector(make_unique_ptrs(3u));
+
+  const auto it = sut.erase(sut.begin() + 1);
+
+  SECTION("Removes the element") {
+    REQUIRE(sut.size() == 2u);
+    REQUIRE(*sut[1] == 2);
+  }
+  SECTION("Returns iterator following the removed element") {
+    REQUIRE(it == sut.begin() + 1);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+TEST_CASE("not_null_vector<T>::as_nullable() &&", "[observers]") {
+  auto input = make_unique_ptrs(3u);
+  auto* const expected = input.data();
+  auto sut = assume_not_null_vector(std::move(input));
+
+  const auto result = std::move(sut).as_nullable();
+
+  SECTION("Steals the underlying storage") {
+    REQUIRE(result.data() == expected);
+  }
+}
+
+//=============================================================================
+// non-member functions : class : not_null_vector
+//=============================================================================
+
+TEST_CASE("check_not_null_vector(std::vector<T>)", "[utilities]") {
+  SECTION("Input contains null pointers") {
+    auto input = make_unique_ptrs(3u);
+    input[1].reset();
+
+    SECTION("Throws null contract violation") {
+      REQUIRE_THROWS_AS(
+        check_not_null_vector(std::move(input)),
+        not_null_contract_violation
+      );
+    }
+  }
+  SECTION("Input contains no null pointers") {
+    auto input = make_unique_ptrs(3u);
+    auto* const expected = input.data();
+
+    const auto sut = check_not_null_vector(std::move(input));
+
+    SECTION("Adopts the storage without moving elements") {
+      REQUIRE(static_cast<const void*>(sut.data()) == static_cast<const void*>(expected));
+    }
+  }
+}
+
+} // inline namespace bitwizeshift
+} // namespace NOT_NULL_NAMESPACE_INTERNAL
@@ -0,0 +1,230 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "offset_not_null.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>     // std::int8_t
+#include <cstring>     // std::memcpy
+#include <new>         // placement-new
+#include <type_traits> // std::is_standard_layout
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+namespace {
+
+  struct node
+  {
+    int value;
+    offset_not_null<node> next;
+  };
+
+} // namespace
+
+//=============================================================================
+// class : offset_not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Layout
+//-----------------------------------------------------------------------------
+
+TEST_CASE("offset_not_null<T,Offset>", "[layout]") {
+  SECTION("Is the same size as Offset") {
+    STATIC_REQUIRE(sizeof(offset_not_null<int>) == sizeof(std::int32_t));
+    STATIC_REQUIRE(sizeof(offset_not_null<int,std::int8_t>) == sizeof(std::int8_t));
+  }
+  SECTION("Is standard layout") {
+    STATIC_REQUIRE(std::is_standard_layout<offset_not_null<int>>::value);
+  }
+  SECTION("Is not default constructible") {
+    STATIC_REQUIRE_FALSE(std::is_default_constructible<offset_not_null<int>>::value);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+TEST_CASE("offset_not_null<T,Offset>::offset_not_null(not_null<T*>)", "[ctor]") {
+  int values[2] = {1, 2};
+  const auto sut = offset_not_null<int>{assume_not_null(&values[1])};
+
+  SECTION("Points to the input") {
+    REQUIRE(sut.get() == &values[1]);
+  }
+}
+
+TEST_CASE("offset_not_null<T,Offset>::offset_not_null(const offset_not_null&)", "[ctor]") {
+  int value = 42;
+  const auto source = offset_not_null<int>{assume_not_null(&value)};
+  const auto sut = source;
+
+  SECTION("Points to the same object as the source") {
+    REQUIRE(sut.get() == &value);
+  }
+  SECTION("Stores a different offset than the source") {
+    REQUIRE(sut.offset() != source.offset());
+  }
+}
+
+TEST_CASE("offset_not_null<T,Offset>::offset_not_null(not_null<T*>) at the limits of Offset", "[ctor]") {
+  // The offset_not_null is placed in the middle of a byte buffer so that
+  // the extremes of a 1-byte offset still land inside the buffer
+  alignas(offset_not_null<unsigned char,std::int8_t>) unsigned char buffer[256] = {};
+  auto* const storage = &buffer[128];
+
+  SECTION("Accepts the largest representable offset") {
+    auto* const sut = ::new (static_cast<void*>(storage))
+      offset_not_null<unsigned char,std::int8_t>{assume_not_null(storage + 127)};
+
+    REQUIRE(sut->offset() == 127);
+    REQUIRE(sut->get() == storage + 127);
+  }
+  SECTION("Accepts the smallest representable offset") {
+    auto* const sut = ::new (static_cast<void*>(storage))
+      offset_not_null<unsigned char,std::int8_t>{assume_not_null(storage - 128)};
+
+    REQUIRE(sut->offset() == -128);
+    REQUIRE(sut->get() == storage - 128);
+  }
+}
+
+TEST_CASE("offset_not_null<T,Offset>::operator=(const offset_not_null&)", "[assignment]") {
+  int a = 1;
+  int b = 2;
+  const auto source = offset_not_null<int>{assume_not_null(&b)};
+  auto sut = offset_not_null<int>{assume_not_null(&a)};
+
+  sut = source;
+
+  SECTION("Points to the same object as the source") {
+    REQUIRE(sut.get() == &b);
+  }
+}
+
+TEST_CASE("offset_not_null<T,Offset>::operator=(not_null<T*>)", "[assignment]") {
+  int a = 1;
+  int b = 2;
+  auto sut = offset_not_null<int>{assume_not_null(&a)};
+
+  sut = assume_not_null(&b);
+
+  SECTION("Points to the new object") {
+    REQUIRE(sut.get() == &b);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+TEST_CASE("offset_not_null<T,Offset>::operator*()", "[observers]") {
+  int value = 42;
+  const auto sut = offset_not_null<int>{assume_not_null(&value)};
+
+  SECTION("Refers to the pointed-to object") {
+    REQUIRE(&(*sut) == &value);
+  }
+}
+
+TEST_CASE("offset_not_null<T,Offset>::get()", "[observers]") {
+  SECTION("Memory is relocated") {
+    alignas(node) unsigned char source[sizeof(node) * 2];
+    alignas(node) unsigned char destination[sizeof(node) * 2];
+
+    auto* const first = reinterpret_cast<node*>(source);
+    auto* const second = first + 1;
+    ::new (static_cast<void*>(second)) node{2, assume_not_null(first)};
+    ::new (static_cast<void*>(first)) node{1, assume_not_null(second)};
+
+    std::memcpy(destination, source, sizeof(source));
+    const auto* const relocated = reinterpret_cast<const node*>(destination);
+
+    SECTION("Points into the relocated memory") {
+      REQUIRE(relocated->next.get() == relocated + 1);
+    }
+    SECTION("Pointer graph is preserved") {
+      REQUIRE(relocated->next->value == 2);
+      REQUIRE(relocated->next->next->value == 1);
+    }
+  }
+}
+
+//=============================================================================
+// non-member functions : class : offset_not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Comparisons
+//-----------------------------------------------------------------------------
+
+TEST_CASE("operator==(const offset_not_null<T>&, const offset_not_null<U>&)", "[comparison]") {
+  int values[2] = {1, 2};
+  const auto lhs = offset_not_null<int>{assume_not_null(&values[0])};
+
+  SECTION("Pointing to the same object compare equal") {
+    const auto rhs = offset_not_null<const int,std::int64_t>{assume_not_null(&values[0])};
+
+    REQUIRE(lhs == rhs);
+  }
+  SECTION("Pointing to different objects compare unequal") {
+    const auto rhs = offset_not_null<int>{assume_not_null(&values[1])};
+
+    REQUIRE(lhs != rhs);
+  }
+}
+
+TEST_CASE("operator<(const offset_not_null<T>&, const offset_not_null<U>&)", "[comparison]") {
+  int values[2] = {1, 2};
+  const auto lhs = offset_not_null<int>{assume_not_null(&values[0])};
+  const auto rhs = offset_not_null<int>{assume_not_null(&values[1])};
+
+  SECTION("Orders by address") {
+    REQUIRE(lhs < rhs);
+    REQUIRE(lhs <= rhs);
+    REQUIRE(rhs > lhs);
+    REQUIRE(rhs >= lhs);
+  }
+}
+
+TEST_CASE("operator==(const offset_not_null<T>&, const not_null<U>&)", "[comparison]") {
+  int a = 1;
+  int b = 2;
+  const auto sut = offset_not_null<int>{assume_not_null(&a)};
+
+  SECTION("Compares equal to the same pointer") {
+    REQUIRE(sut == assume_not_null(&a));
+    REQUIRE(assume_not_null(&a) == sut);
+  }
+  SECTION("Compares unequal to a different pointer") {
+    REQUIRE(sut != assume_not_null(&b));
+    REQUIRE(assume_not_null(&b) != sut);
+  }
+}
+
+} // inline namespace bitwizeshift
+} // namespace NOT_NULL_NAMESPACE_INTERNAL
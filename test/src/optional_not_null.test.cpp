@@ -0,0 +1,413 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "optional_not_null.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <memory>      // std::unique_ptr, std::shared_ptr
+#include <type_traits> // std::is_trivially_copyable, std::is_same
+#include <utility>     // std::move, std::declval
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+//=============================================================================
+// class : optional_not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Layout
+//-----------------------------------------------------------------------------
+
+TEST_CASE("optional_not_null<T>", "[layout]") {
+  SECTION("Is the same size as T") {
+    STATIC_REQUIRE(sizeof(optional_not_null<int*>) == sizeof(int*));
+    STATIC_REQUIRE(sizeof(optional_not_null<std::unique_ptr<int>>) == sizeof(std::unique_ptr<int>));
+  }
+  SECTION("Is trivially copyable if T is") {
+    STATIC_REQUIRE(std::is_trivially_copyable<optional_not_null<int*>>::value);
+  }
+  SECTION("Is not copyable if T is not") {
+    STATIC_REQUIRE_FALSE(std::is_copy_constructible<optional_not_null<std::unique_ptr<int>>>::value);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+TEST_CASE("optional_not_null<T>::optional_not_null()", "[ctor]") {
+  const auto sut = optional_not_null<int*>{};
+
+  SECTION("Is empty") {
+    REQUIRE_FALSE(sut.has_value());
+  }
+}
+
+TEST_CASE("optional_not_null<T>::optional_not_null(std::nullptr_t)", "[ctor]") {
+  const auto sut = optional_not_null<int*>{nullptr};
+
+  SECTION("Is empty") {
+    REQUIRE_FALSE(sut.has_value());
+  }
+}
+
+TEST_CASE("optional_not_null<T>::optional_not_null(const value_type&)", "[ctor]") {
+  int value = 0;
+  const auto input = assume_not_null(&value);
+  const auto sut = optional_not_null<int*>{input};
+
+  SECTION("Contains a value") {
+    REQUIRE(sut.has_value());
+  }
+  SECTION("Contains the input pointer") {
+    REQUIRE(sut.as_nullable() == &value);
+  }
+}
+
+TEST_CASE("optional_not_null<T>::optional_not_null(value_type&&)", "[ctor]") {
+  auto* const p = new int{42};
+  auto input = assume_not_null(std::unique_ptr<int>{p});
+  const auto sut = optional_not_null<std::unique_ptr<int>>{std::move(input)};
+
+  SECTION("Contains the moved pointer") {
+    REQUIRE(sut.as_nullable().get() == p);
+  }
+}
+
+TEST_CASE("optional_not_null<T>::optional_not_null(optional_not_null<U>&&)", "[ctor]") {
+  auto* const p = new int{42};
+  auto input = optional_not_null<std::unique_ptr<int>>{
+    assume_not_null(std::unique_ptr<int>{p})
+  };
+  const auto sut = optional_not_null<std::shared_ptr<int>>{std::move(input)};
+
+  SECTION("Contains the converted pointer") {
+    REQUIRE(sut.as_nullable().get() == p);
+  }
+  SECTION("Leaves the source empty") {
+    REQUIRE_FALSE(input.has_value());
+  }
+}
+
+TEST_CASE("optional_not_null<T>::operator=(std::nullptr_t)", "[assignment]") {
+  int value = 0;
+  auto sut = optional_not_null<int*>{assume_not_null(&value)};
+
+  sut = nullptr;
+
+  SECTION("Empties the optional") {
+    REQUIRE_FALSE(sut.has_value());
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+TEST_CASE("optional_not_null<T>::value()", "[observers]") {
+  SECTION("optional_not_null contains a value") {
+    int value = 0;
+    auto sut = optional_not_null<int*>{assume_not_null(&value)};
+
+    SECTION("Returns a reference to not_null") {
+      STATIC_REQUIRE(std::is_same<decltype(sut.value()),not_null<int*>&>::value);
+    }
+    SECTION("Refers to the contained pointer") {
+      REQUIRE(sut.value().get() == &value);
+    }
+    SECTION("Modifications through the reference are observed") {
+      int other = 1;
+      sut.value() = assume_not_null(&other);
+
+      REQUIRE(sut.as_nullable() == &other);
+    }
+  }
+  SECTION("optional_not_null is empty") {
+    auto sut = optional_not_null<int*>{};
+
+    SECTION("Throws not_null_contract_violation") {
+      REQUIRE_THROWS_AS(sut.value(), not_null_contract_violation);
+    }
+  }
+}
+
+TEST_CASE("optional_not_null<T>::value() &&", "[observers]") {
+  auto* const p = new int{42};
+  auto sut = optional_not_null<std::unique_ptr<int>>{
+    assume_not_null(std::unique_ptr<int>{p})
+  };
+
+  const auto result = std::move(sut).value();
+
+  SECTION("Moves the contained pointer out") {
+    REQUIRE(result.get() == p);
+  }
+}
+
+TEST_CASE("optional_not_null<T>::value_or(U&&)", "[observers]") {
+  int value = 0;
+  int fallback = 1;
+
+  SECTION("optional_not_null contains a value") {
+    const auto sut = optional_not_null<int*>{assume_not_null(&value)};
+
+    SECTION("Returns the contained value") {
+      REQUIRE(sut.value_or(assume_not_null(&fallback)).get() == &value);
+    }
+  }
+  SECTION("optional_not_null is empty") {
+    const auto sut = optional_not_null<int*>{};
+
+    SECTION("Returns the default value") {
+      REQUIRE(sut.value_or(assume_not_null(&fallback)).get() == &fallback);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Monadic Operations
+//-----------------------------------------------------------------------------
+
+TEST_CASE("optional_not_null<T>::and_then(F&&)", "[monadic]") {
+  int value = 0;
+  int next = 1;
+  const auto to_next = [&](not_null<int*>) {
+    return try_not_null(&next);
+  };
+  const auto to_null = [](not_null<int*>) {
+    return try_not_null(static_cast<int*>(nullptr));
+  };
+
+  SECTION("optional_not_null contains a value") {
+    const auto sut = optional_not_null<int*>{assume_not_null(&value)};
+
+    SECTION("Returns the result of the function") {
+      REQUIRE(sut.and_then(to_next).as_nullable() == &next);
+    }
+    SECTION("Returns an empty result if the function does") {
+      REQUIRE_FALSE(sut.and_then(to_null).has_value());
+    }
+  }
+  SECTION("optional_not_null is empty") {
+    const auto sut = optional_not_null<int*>{};
+    auto called = false;
+
+    const auto result = sut.and_then([&](not_null<int*> p) {
+      called = true;
+      return optional_not_null<int*>{p};
+    });
+
+    SECTION("Does not call the function") {
+      REQUIRE_FALSE(called);
+    }
+    SECTION("Returns an empty result") {
+      REQUIRE_FALSE(result.has_value());
+    }
+  }
+  SECTION("optional_not_null is an r-value") {
+    auto* const p = new int{42};
+    auto sut = try_not_null(std::unique_ptr<int>{p});
+
+    const auto result = std::move(sut).and_then([](not_null<std::unique_ptr<int>>&& u) {
+      return optional_not_null<std::unique_ptr<int>>{std::move(u)};
+    });
+
+    SECTION("Moves the contained pointer into the function") {
+      REQUIRE(result.as_nullable().get() == p);
+      REQUIRE(sut.as_nullable() == nullptr);
+    }
+  }
+}
+
+TEST_CASE("optional_not_null<T>::transform(F&&)", "[monadic]") {
+  struct widget
+  {
+    int member;
+  };
+  auto value = widget{42};
+  const auto to_member = [](not_null<widget*> w) {
+    return assume_not_null(&w->member);
+  };
+
+  SECTION("Result is an optional_not_null of the returned pointer") {
+    const auto sut = optional_not_null<widget*>{};
+
+    STATIC_REQUIRE(std::is_same<decltype(sut.transform(to_member)),optional_not_null<int*>>::value);
+  }
+  SECTION("optional_not_null contains a value") {
+    const auto sut = optional_not_null<widget*>{assume_not_null(&value)};
+
+    SECTION("Returns the result of the function") {
+      REQUIRE(sut.transform(to_member).as_nullable() == &value.member);
+    }
+  }
+  SECTION("optional_not_null is empty") {
+    const auto sut = optional_not_null<widget*>{};
+
+    SECTION("Returns an empty result") {
+      REQUIRE_FALSE(sut.transform(to_member).has_value());
+    }
+  }
+  SECTION("optional_not_null is an r-value") {
+    auto* const p = new int{42};
+    auto sut = try_not_null(std::unique_ptr<int>{p});
+
+    const auto result = std::move(sut).transform([](not_null<std::unique_ptr<int>>&& u) {
+      return not_null<std::shared_ptr<int>>{std::move(u)};
+    });
+
+    SECTION("Moves the contained pointer into the function") {
+      REQUIRE(result.as_nullable().get() == p);
+      REQUIRE(sut.as_nullable() == nullptr);
+    }
+  }
+}
+
+TEST_CASE("optional_not_null<T>::or_else(F&&)", "[monadic]") {
+  int value = 0;
+  int fallback = 1;
+  const auto to_fallback = [&]{
+    return try_not_null(&fallback);
+  };
+
+  SECTION("optional_not_null contains a value") {
+    const auto sut = optional_not_null<int*>{assume_not_null(&value)};
+
+    SECTION("Returns the contained value") {
+      REQUIRE(sut.or_else(to_fallback).as_nullable() == &value);
+    }
+  }
+  SECTION("optional_not_null is empty") {
+    const auto sut = optional_not_null<int*>{};
+
+    SECTION("Returns the result of the function") {
+      REQUIRE(sut.or_else(to_fallback).as_nullable() == &fallback);
+    }
+    SECTION("Function may return a not_null") {
+      const auto result = sut.or_else([&]{ return assume_not_null(&fallback); });
+
+      REQUIRE(result.as_nullable() == &fallback);
+    }
+  }
+  SECTION("optional_not_null is an r-value") {
+    auto* const p = new int{42};
+    auto sut = try_not_null(std::unique_ptr<int>{p});
+
+    const auto result = std::move(sut).or_else([]{
+      return optional_not_null<std::unique_ptr<int>>{};
+    });
+
+    SECTION("Moves the contained pointer out") {
+      REQUIRE(result.as_nullable().get() == p);
+    }
+  }
+}
+
+//=============================================================================
+// non-member functions : class : optional_not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Utilities
+//-----------------------------------------------------------------------------
+
+TEST_CASE("try_not_null(T&&)", "[utilities]") {
+  SECTION("Result is the same size as T") {
+    STATIC_REQUIRE(sizeof(try_not_null(std::declval<int*>())) == sizeof(int*));
+    STATIC_REQUIRE(sizeof(try_not_null(std::declval<std::unique_ptr<int>>())) == sizeof(std::unique_ptr<int>));
+  }
+  SECTION("Is noexcept for pointers") {
+    STATIC_REQUIRE(noexcept(try_not_null(std::declval<int*>())));
+    STATIC_REQUIRE(noexcept(try_not_null(std::declval<std::unique_ptr<int>>())));
+  }
+  SECTION("Is usable in constant expressions") {
+    constexpr auto sut = try_not_null(static_cast<const int*>(nullptr));
+
+    STATIC_REQUIRE_FALSE(sut.has_value());
+  }
+  SECTION("Pointer is null") {
+    const auto sut = try_not_null(static_cast<int*>(nullptr));
+
+    SECTION("Result is empty") {
+      REQUIRE_FALSE(sut.has_value());
+    }
+  }
+  SECTION("Pointer is not null") {
+    int value = 0;
+    const auto sut = try_not_null(&value);
+
+    SECTION("Result contains the pointer") {
+      REQUIRE(sut.has_value());
+      REQUIRE(sut.as_nullable() == &value);
+    }
+  }
+  SECTION("Pointer is move-only") {
+    auto* const p = new int{42};
+    auto u = std::unique_ptr<int>{p};
+
+    if (auto sut = try_not_null(std::move(u))) {
+      const auto result = *std::move(sut);
+
+      SECTION("Pointer is moved into the result") {
+        REQUIRE(result.get() == p);
+        REQUIRE(u == nullptr);
+      }
+    } else {
+      FAIL("try_not_null returned an empty result for a non-null pointer");
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Comparisons
+//-----------------------------------------------------------------------------
+
+TEST_CASE("operator==(const optional_not_null<T>&, std::nullptr_t)", "[comparison]") {
+  int value = 0;
+
+  SECTION("Empty compares equal to nullptr") {
+    REQUIRE(optional_not_null<int*>{} == nullptr);
+  }
+  SECTION("Engaged does not compare equal to nullptr") {
+    REQUIRE(optional_not_null<int*>{assume_not_null(&value)} != nullptr);
+  }
+}
+
+TEST_CASE("operator==(const optional_not_null<T>&, const not_null<U>&)", "[comparison]") {
+  int value = 0;
+  int other = 1;
+  const auto sut = optional_not_null<int*>{assume_not_null(&value)};
+
+  SECTION("Compares equal to the same pointer") {
+    REQUIRE(sut == assume_not_null(&value));
+  }
+  SECTION("Compares unequal to a different pointer") {
+    REQUIRE(sut != assume_not_null(&other));
+  }
+}
+
+} // inline namespace bitwizeshift
+} // namespace NOT_NULL_NAMESPACE_INTERNAL
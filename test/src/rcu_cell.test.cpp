@@ -0,0 +1,253 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+#include "rcu_cell.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>  // std::atomic
+#include <memory>  // std::unique_ptr
+#include <thread>  // std::thread
+#include <utility> // std::move
+#include <vector>  // std::vector
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+namespace {
+
+  // Counts the live versions, so that tests can observe reclamation
+  struct version
+  {
+    explicit version(int value, std::atomic<int>& live)
+      : value{value},
+        live{&live}
+    {
+      ++live;
+    }
+
+    version(const version&) = delete;
+
+    ~version()
+    {
+      --(*live);
+    }
+
+    auto operator=(const version&) -> version& = delete;
+
+    int value;
+    std::atomic<int>* live;
+  };
+
+  auto make_version(int value, std::atomic<int>& live)
+    -> not_null<std::unique_ptr<version>>
+  {
+    return check_not_null(std::unique_ptr<version>{new version{value, live}});
+  }
+
+} // namespace
+
+//=============================================================================
+// class : rcu_cell
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+TEST_CASE("rcu_cell<T>::rcu_cell(not_null<std::unique_ptr<T>>)", "[ctor]") {
+  std::atomic<int> live{0};
+  const rcu_cell<version> sut{make_version(1, live)};
+
+  SECTION("Publishes the input") {
+    REQUIRE(sut.read()->value == 1);
+  }
+  SECTION("Has no retired versions") {
+    REQUIRE(sut.retired() == 0u);
+  }
+}
+
+TEST_CASE("rcu_cell<T>::~rcu_cell()", "[ctor]") {
+  std::atomic<int> live{0};
+  {
+    rcu_cell<version> sut{make_version(1, live)};
+    {
+      const auto guard = sut.read();
+      sut.update(make_version(2, live));
+    }
+    REQUIRE(sut.retired() == 1u);
+  }
+
+  SECTION("Destroys the current and retired versions") {
+    REQUIRE(live == 0);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Readers
+//-----------------------------------------------------------------------------
+
+TEST_CASE("rcu_cell<T>::read()", "[readers]") {
+  std::atomic<int> live{0};
+  rcu_cell<version> sut{make_version(1, live)};
+
+  SECTION("Version is replaced during the read") {
+    const auto guard = sut.read();
+    sut.update(make_version(2, live));
+
+    SECTION("Guard still observes the previous version") {
+      REQUIRE(guard->value == 1);
+    }
+    SECTION("Previous version is not destroyed") {
+      REQUIRE(live == 2);
+      REQUIRE(sut.retired() == 1u);
+    }
+    SECTION("New reads observe the new version") {
+      REQUIRE(sut.read()->value == 2);
+    }
+  }
+  SECTION("Reads are nested") {
+    auto outer = sut.read();
+    sut.update(make_version(2, live));
+    {
+      const auto inner = sut.read();
+      REQUIRE(inner->value == 2);
+    }
+    sut.reclaim();
+
+    SECTION("Outer read still protects the previous version") {
+      REQUIRE((*outer).value == 1);
+      REQUIRE(sut.retired() == 1u);
+    }
+  }
+  SECTION("Guard is moved") {
+    auto guard = sut.read();
+    sut.update(make_version(2, live));
+    {
+      const auto moved = std::move(guard);
+      REQUIRE(moved.get()->value == 1);
+    }
+    sut.reclaim();
+
+    SECTION("Read ends with the moved-to guard") {
+      REQUIRE(sut.retired() == 0u);
+      REQUIRE(live == 1);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Writers
+//-----------------------------------------------------------------------------
+
+TEST_CASE("rcu_cell<T>::update(not_null<std::unique_ptr<T>>)", "[writers]") {
+  std::atomic<int> live{0};
+  rcu_cell<version> sut{make_version(1, live)};
+
+  SECTION("No reader is active") {
+    sut.update(make_version(2, live));
+
+    SECTION("Publishes the input") {
+      REQUIRE(sut.read()->value == 2);
+    }
+    SECTION("Destroys the previous version immediately") {
+      REQUIRE(live == 1);
+      REQUIRE(sut.retired() == 0u);
+    }
+  }
+  SECTION("Reader finished after the update") {
+    {
+      const auto guard = sut.read();
+      sut.update(make_version(2, live));
+    }
+    sut.update(make_version(3, live));
+
+    SECTION("Destroys all unobservable versions") {
+      REQUIRE(live == 1);
+      REQUIRE(sut.retired() == 0u);
+    }
+  }
+}
+
+TEST_CASE("rcu_cell<T>::reclaim()", "[writers]") {
+  std::atomic<int> live{0};
+  rcu_cell<version> sut{make_version(1, live)};
+  {
+    const auto guard = sut.read();
+    sut.update(make_version(2, live));
+  }
+
+  sut.reclaim();
+
+  SECTION("Destroys the retired versions") {
+    REQUIRE(live == 1);
+    REQUIRE(sut.retired() == 0u);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Concurrency
+//-----------------------------------------------------------------------------
+
+TEST_CASE("rcu_cell<T>", "[concurrency]") {
+  std::atomic<int> live{0};
+  std::atomic<int> failures{0};
+  std::atomic<bool> done{false};
+  rcu_cell<version> sut{make_version(0, live)};
+
+  // Readers check that versions are never observed after being destroyed,
+  // and that they never go backwards
+  auto readers = std::vector<std::thread>{};
+  for (auto i = 0; i < 4; ++i) {
+    readers.emplace_back([&]{
+      auto last = 0;
+      while (!done.load()) {
+        const auto guard = sut.read();
+        const auto value = guard->value;
+        if (value < last || guard->live != &live) {
+          ++failures;
+        }
+        last = value;
+      }
+    });
+  }
+  for (auto i = 1; i <= 1000; ++i) {
+    sut.update(make_version(i, live));
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  sut.reclaim();
+
+  SECTION("Readers only observe valid versions") {
+    REQUIRE(failures == 0);
+  }
+  SECTION("All previous versions are reclaimed") {
+    REQUIRE(live == 1);
+    REQUIRE(sut.retired() == 0u);
+  }
+}
+
+} // inline namespace bitwizeshift
+} // namespace NOT_NULL_NAMESPACE_INTERNAL
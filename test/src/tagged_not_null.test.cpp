@@ -0,0 +1,258 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2020 Matthew Rodusek All rights reserved.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "tagged_not_null.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>     // std::uintptr_t
+#include <type_traits> // std::is_trivially_copyable
+
+namespace NOT_NULL_NAMESPACE_INTERNAL {
+inline namespace bitwizeshift {
+
+namespace {
+
+  struct alignas(8) node
+  {
+    int value;
+  };
+
+  enum class color : unsigned
+  {
+    red,
+    black,
+  };
+
+  // Refers to its own, still incomplete, type
+  struct tree_node
+  {
+    tagged_not_null<tree_node*,1,color> parent;
+    int value;
+  };
+
+} // namespace
+
+//=============================================================================
+// class : tagged_not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Layout
+//-----------------------------------------------------------------------------
+
+TEST_CASE("tagged_not_null<T*,TagBits>", "[layout]") {
+  SECTION("Is the same size as T*") {
+    STATIC_REQUIRE(sizeof(tagged_not_null<node*,3>) == sizeof(node*));
+  }
+  SECTION("Is trivially copyable") {
+    STATIC_REQUIRE(std::is_trivially_copyable<tagged_not_null<node*,3>>::value);
+  }
+  SECTION("Is not default constructible") {
+    STATIC_REQUIRE_FALSE(std::is_default_constructible<tagged_not_null<node*,3>>::value);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Constructors / Assignment
+//-----------------------------------------------------------------------------
+
+TEST_CASE("tagged_not_null<T*,TagBits>::tagged_not_null(not_null<T*>, Tag)", "[ctor]") {
+  auto n = node{42};
+
+  SECTION("Tag is not specified") {
+    const auto sut = tagged_not_null<node*,3>{assume_not_null(&n)};
+
+    SECTION("Points to the input") {
+      REQUIRE(sut.get() == &n);
+    }
+    SECTION("Tag is zero") {
+      REQUIRE(sut.tag() == 0u);
+    }
+  }
+  SECTION("Tag is specified") {
+    const auto sut = tagged_not_null<node*,3>{assume_not_null(&n), 5u};
+
+    SECTION("Points to the input") {
+      REQUIRE(sut.get() == &n);
+    }
+    SECTION("Contains the tag") {
+      REQUIRE(sut.tag() == 5u);
+    }
+  }
+  SECTION("Tag does not fit in TagBits") {
+    const auto sut = tagged_not_null<node*,2>{assume_not_null(&n), 7u};
+
+    SECTION("Points to the input") {
+      REQUIRE(sut.get() == &n);
+    }
+    SECTION("Discards the excess bits") {
+      REQUIRE(sut.tag() == 3u);
+    }
+  }
+}
+
+TEST_CASE("tagged_not_null<T*,TagBits>::tagged_not_null(not_null<T*>, Tag) (T is the enclosing class)", "[ctor]") {
+  // The root is its own parent, so its type must be named to take its address
+  tree_node root{
+    tagged_not_null<tree_node*,1,color>{assume_not_null(&root), color::black},
+    1
+  };
+  const auto child = tree_node{
+    tagged_not_null<tree_node*,1,color>{assume_not_null(&root), color::red},
+    2
+  };
+
+  SECTION("Points to the input") {
+    REQUIRE(child.parent.get() == &root);
+    REQUIRE(child.parent->parent->value == 1);
+  }
+  SECTION("Contains the tag") {
+    REQUIRE(root.parent.tag() == color::black);
+    REQUIRE(child.parent.tag() == color::red);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Modifiers
+//-----------------------------------------------------------------------------
+
+TEST_CASE("tagged_not_null<T*,TagBits>::set_pointer(not_null<T*>)", "[modifiers]") {
+  auto a = node{1};
+  auto b = node{2};
+  auto sut = tagged_not_null<node*,3>{assume_not_null(&a), 6u};
+
+  sut.set_pointer(assume_not_null(&b));
+
+  SECTION("Changes the pointer") {
+    REQUIRE(sut.get() == &b);
+  }
+  SECTION("Leaves the tag unchanged") {
+    REQUIRE(sut.tag() == 6u);
+  }
+}
+
+TEST_CASE("tagged_not_null<T*,TagBits>::set_tag(Tag)", "[modifiers]") {
+  auto n = node{1};
+  auto sut = tagged_not_null<node*,1,color>{assume_not_null(&n), color::red};
+
+  sut.set_tag(color::black);
+
+  SECTION("Changes the tag") {
+    REQUIRE(sut.tag() == color::black);
+  }
+  SECTION("Leaves the pointer unchanged") {
+    REQUIRE(sut.get() == &n);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Observers
+//-----------------------------------------------------------------------------
+
+TEST_CASE("tagged_not_null<T*,TagBits>::operator->()", "[observers]") {
+  auto n = node{42};
+  const auto sut = tagged_not_null<node*,3>{assume_not_null(&n), 7u};
+
+  SECTION("Accesses the underlying object") {
+    REQUIRE(sut->value == 42);
+  }
+}
+
+TEST_CASE("tagged_not_null<T*,TagBits>::as_not_null()", "[observers]") {
+  auto n = node{42};
+  const auto sut = tagged_not_null<node*,3>{assume_not_null(&n), 7u};
+
+  SECTION("Returns the pointer without the tag") {
+    REQUIRE(sut.as_not_null() == assume_not_null(&n));
+  }
+}
+
+TEST_CASE("tagged_not_null<T*,TagBits>::bits()", "[observers]") {
+  auto n = node{42};
+  const auto sut = tagged_not_null<node*,3>{assume_not_null(&n), 1u};
+
+  SECTION("Combines the pointer and the tag") {
+    REQUIRE(sut.bits() == (reinterpret_cast<std::uintptr_t>(&n) | 1u));
+  }
+}
+
+//=============================================================================
+// non-member functions : class : tagged_not_null
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Comparisons
+//-----------------------------------------------------------------------------
+
+TEST_CASE("operator==(const tagged_not_null<T>&, const tagged_not_null<T>&)", "[comparison]") {
+  auto n = node{42};
+  const auto lhs = tagged_not_null<node*,3>{assume_not_null(&n), 1u};
+
+  SECTION("Same pointer and tag compare equal") {
+    const auto rhs = tagged_not_null<node*,3>{assume_not_null(&n), 1u};
+
+    REQUIRE(lhs == rhs);
+  }
+  SECTION("Same pointer and different tag compare unequal") {
+    const auto rhs = tagged_not_null<node*,3>{assume_not_null(&n), 2u};
+
+    REQUIRE(lhs != rhs);
+  }
+}
+
+TEST_CASE("equal_ignoring_tag(const tagged_not_null<T>&, const tagged_not_null<T>&)", "[comparison]") {
+  auto a = node{1};
+  auto b = node{2};
+  const auto lhs = tagged_not_null<node*,3>{assume_not_null(&a), 1u};
+
+  SECTION("Same pointer and different tag compare equal") {
+    const auto rhs = tagged_not_null<node*,3>{assume_not_null(&a), 2u};
+
+    REQUIRE(equal_ignoring_tag(lhs, rhs));
+  }
+  SECTION("Different pointer compare unequal") {
+    const auto rhs = tagged_not_null<node*,3>{assume_not_null(&b), 1u};
+
+    REQUIRE_FALSE(equal_ignoring_tag(lhs, rhs));
+  }
+}
+
+TEST_CASE("operator==(const tagged_not_null<T>&, const not_null<U>&)", "[comparison]") {
+  auto a = node{1};
+  auto b = node{2};
+  const auto sut = tagged_not_null<node*,3>{assume_not_null(&a), 3u};
+
+  SECTION("Compares equal to the same pointer, ignoring the tag") {
+    REQUIRE(sut == assume_not_null(&a));
+    REQUIRE(assume_not_null(&a) == sut);
+  }
+  SECTION("Compares unequal to a different pointer") {
+    REQUIRE(sut != assume_not_null(&b));
+    REQUIRE(assume_not_null(&b) != sut);
+  }
+}
+
+} // inline namespace bitwizeshift
+} // namespace NOT_NULL_NAMESPACE_INTERNAL